@@ -15,16 +15,44 @@ namespace nix {
 namespace file {
 
 #define ATTRIBUTES_FILE std::string("attributes")
+#define PACKED_ATTRIBUTES_FILE std::string("attributes.bin")
+
+static AttributeFormat detect_format(const bfs::path &dir) {
+    if (bfs::exists(dir / bfs::path(PACKED_ATTRIBUTES_FILE))) {
+        return AttributeFormat::Packed;
+    } else if (bfs::exists(dir / bfs::path(ATTRIBUTES_FILE))) {
+        return AttributeFormat::Yaml;
+    }
+    return AttributeFormat::Auto;
+}
 
-AttributesFS::AttributesFS() { }
+
+AttributesFS::AttributesFS()
+    : fmt(AttributeFormat::Yaml) { }
 
 
 AttributesFS::AttributesFS(const std::string &file_path, FileMode mode)
     : AttributesFS(bfs::path(file_path.c_str()), mode)
 { }
 
-AttributesFS::AttributesFS(const bfs::path &file_path, FileMode mode)
+AttributesFS::AttributesFS(const bfs::path &file_path, FileMode mode, AttributeFormat format)
     : loc(file_path), mode(mode) {
+    // existing attributes always win, new ones follow the request or the parents
+    fmt = detect_format(file_path);
+    if (fmt == AttributeFormat::Auto) {
+        fmt = format;
+    }
+    for (bfs::path p = file_path.parent_path(); fmt == AttributeFormat::Auto && !p.empty(); p = p.parent_path()) {
+        fmt = detect_format(p);
+        if (p == p.root_path()) {
+            break;
+        }
+    }
+    if (fmt == AttributeFormat::Auto) {
+        fmt = AttributeFormat::Yaml;
+    }
+    packed = PackedAttributesFS(file_path / bfs::path(PACKED_ATTRIBUTES_FILE));
+
     if (bfs::exists(file_path)) {
         open_or_create();
     }
@@ -32,7 +60,7 @@ AttributesFS::AttributesFS(const bfs::path &file_path, FileMode mode)
 
 
 void AttributesFS::open_or_create() {
-    bfs::path attr(ATTRIBUTES_FILE);
+    bfs::path attr(fmt == AttributeFormat::Packed ? PACKED_ATTRIBUTES_FILE : ATTRIBUTES_FILE);
     bfs::path temp = location() / attr;
     if (!bfs::exists(temp)) {
         if (mode > FileMode::ReadOnly) {
@@ -43,17 +71,34 @@ void AttributesFS::open_or_create() {
             throw std::logic_error("Trying to create new attributes in ReadOnly mode!");
         }
     }
-    node = y::LoadFile(temp.string());
+    if (fmt == AttributeFormat::Packed) {
+        packed.load();
+    } else {
+        node = y::LoadFile(temp.string());
+    }
+}
+
+
+bool AttributesFS::contains(const std::string &name) const {
+    if (fmt == AttributeFormat::Packed) {
+        return packed.has(name);
+    }
+    return (node.size() > 0) && (node[name]);
 }
 
 
 bool AttributesFS::has(const std::string &name) {
     open_or_create();
-    return (node.size() > 0) && (node[name]);
+    return contains(name);
 }
 
 
 void AttributesFS::flush() {
+    if (fmt == AttributeFormat::Packed) {
+        packed.flush();
+        return;
+    }
+
     std::ofstream ofs;
     bfs::path temp = location() / bfs::path(ATTRIBUTES_FILE);
     ofs.open(temp.string(), std::ofstream::trunc);
@@ -70,8 +115,15 @@ bfs::path AttributesFS::location() const {
     return loc;
 }
 
+AttributeFormat AttributesFS::format() const {
+    return fmt;
+}
+
 nix::ndsize_t AttributesFS::attributeCount() {
     open_or_create();
+    if (fmt == AttributeFormat::Packed) {
+        return packed.size();
+    }
     return node.size();
 }
 
@@ -80,11 +132,216 @@ void AttributesFS::remove(const std::string &name) {
     if (mode == FileMode::ReadOnly) {
         throw std::logic_error("Trying to remove an attributes in ReadOnly mode!");
     }
-    if (node[name]) {
+    if (fmt == AttributeFormat::Packed) {
+        packed.remove(name);
+    } else if (node[name]) {
         node.remove(name);
     }
     flush();
 }
 
+bool AttributesFS::exists(const bfs::path &dir) {
+    return detect_format(dir) != AttributeFormat::Auto;
+}
+
+/* conversion */
+
+typedef PackedAttributesFS::RecordType RecordType;
+
+static RecordType infer_scalar_type(const std::string &text) {
+    if (text == "true" || text == "false") {
+        return RecordType::Bool;
+    }
+    try {
+        std::size_t pos = 0;
+        long long i = std::stoll(text, &pos);
+        if (pos == text.size() && std::to_string(i) == text) {
+            return RecordType::Int64;
+        }
+    } catch (const std::logic_error &) { }
+    try {
+        std::size_t pos = 0;
+        unsigned long long u = std::stoull(text, &pos);
+        if (pos == text.size() && std::to_string(u) == text) {
+            return RecordType::UInt64;
+        }
+    } catch (const std::logic_error &) { }
+    try {
+        std::size_t pos = 0;
+        double d = std::stod(text, &pos);
+        if (pos == text.size() && PackedAttributesFS::formatDouble(d) == text) {
+            return RecordType::Double;
+        }
+    } catch (const std::logic_error &) { }
+    return RecordType::String;
+}
+
+
+static void put_texts(PackedAttributesFS &packed, const std::string &name, RecordType type,
+                      const std::vector<std::string> &texts, bool sequence) {
+    switch (type) {
+        case RecordType::Bool: {
+            std::string payload;
+            for (const auto &t : texts) {
+                payload.push_back(t == "true" ? 1 : 0);
+            }
+            packed.put(name, type, sequence, texts.size(), payload);
+            return;
+        }
+        case RecordType::Int64: {
+            std::vector<int64_t> v;
+            for (const auto &t : texts) {
+                v.push_back(std::stoll(t));
+            }
+            packed.set(name, v);
+            break;
+        }
+        case RecordType::UInt64: {
+            std::vector<uint64_t> v;
+            for (const auto &t : texts) {
+                v.push_back(std::stoull(t));
+            }
+            packed.set(name, v);
+            break;
+        }
+        case RecordType::Double: {
+            std::vector<double> v;
+            for (const auto &t : texts) {
+                v.push_back(std::stod(t));
+            }
+            packed.set(name, v);
+            break;
+        }
+        case RecordType::String:
+            packed.set(name, texts);
+            break;
+    }
+    if (!sequence) {
+        PackedAttributesFS::Record r = packed.records().at(name);
+        packed.put(name, r.type, false, r.count, std::string(r.data, r.size));
+    }
+}
+
+
+static void yaml_to_packed(const bfs::path &dir) {
+    bfs::path yaml_path = dir / bfs::path(ATTRIBUTES_FILE);
+    y::Node node = y::LoadFile(yaml_path.string());
+    PackedAttributesFS packed(dir / bfs::path(PACKED_ATTRIBUTES_FILE));
+
+    for (const auto &kv : node) {
+        const std::string name = kv.first.as<std::string>();
+        const y::Node &value = kv.second;
+        std::vector<std::string> texts;
+        bool sequence = false;
+
+        if (value.IsScalar()) {
+            texts.push_back(value.Scalar());
+        } else if (value.IsSequence()) {
+            sequence = true;
+            for (const auto &elm : value) {
+                if (!elm.IsScalar()) {
+                    throw std::runtime_error("AttributesFS::convert: nested attribute " + name + " not supported!");
+                }
+                texts.push_back(elm.Scalar());
+            }
+        } else {
+            throw std::runtime_error("AttributesFS::convert: attribute " + name + " not supported!");
+        }
+
+        // all elements must share one type, mixed integer/double goes to double
+        RecordType type = texts.empty() ? RecordType::String : infer_scalar_type(texts.front());
+        for (const auto &t : texts) {
+            RecordType other = infer_scalar_type(t);
+            if (other == type) {
+                continue;
+            }
+            bool numeric = other != RecordType::String && other != RecordType::Bool &&
+                           type != RecordType::String && type != RecordType::Bool;
+            type = numeric ? RecordType::Double : RecordType::String;
+        }
+        put_texts(packed, name, type, texts, sequence);
+    }
+
+    packed.flush();
+    bfs::remove(yaml_path);
+}
+
+
+static void packed_to_yaml(const bfs::path &dir) {
+    PackedAttributesFS packed(dir / bfs::path(PACKED_ATTRIBUTES_FILE));
+    packed.load();
+    y::Node node;
+
+    for (const auto &kv : packed.records()) {
+        const std::string &name = kv.first;
+        const PackedAttributesFS::Record &r = kv.second;
+
+        if (!r.sequence) {
+            switch (r.type) {
+                case RecordType::Bool:   node[name] = PackedAttributesFS::numberAt<bool>(r, 0); break;
+                case RecordType::Int64:  node[name] = PackedAttributesFS::numberAt<int64_t>(r, 0); break;
+                case RecordType::UInt64: node[name] = PackedAttributesFS::numberAt<uint64_t>(r, 0); break;
+                case RecordType::Double: node[name] = PackedAttributesFS::numberAt<double>(r, 0); break;
+                case RecordType::String: node[name] = PackedAttributesFS::strings(r).front(); break;
+            }
+            continue;
+        }
+
+        if (r.type == RecordType::String) {
+            node[name] = PackedAttributesFS::strings(r);
+        } else if (r.type == RecordType::Double) {
+            std::vector<double> v;
+            packed.get(name, v);
+            node[name] = v;
+        } else if (r.type == RecordType::UInt64) {
+            std::vector<uint64_t> v;
+            packed.get(name, v);
+            node[name] = v;
+        } else {
+            std::vector<int64_t> v;
+            packed.get(name, v);
+            node[name] = v;
+        }
+    }
+
+    std::ofstream ofs((dir / bfs::path(ATTRIBUTES_FILE)).string(), std::ofstream::trunc);
+    if (!ofs.is_open()) {
+        throw std::runtime_error("Could not write to attributes file!");
+    }
+    ofs << node << std::endl;
+    ofs.close();
+    bfs::remove(packed.location());
+}
+
+
+static void convert_dir(const bfs::path &dir, AttributeFormat format) {
+    AttributeFormat current = detect_format(dir);
+    if (current == AttributeFormat::Auto || current == format) {
+        return;
+    }
+    if (format == AttributeFormat::Packed) {
+        yaml_to_packed(dir);
+    } else {
+        packed_to_yaml(dir);
+    }
+}
+
+
+void AttributesFS::convert(const bfs::path &dir, AttributeFormat format, bool recursive) {
+    if (format == AttributeFormat::Auto) {
+        throw std::invalid_argument("AttributesFS::convert: target format must be given!");
+    }
+    convert_dir(dir, format);
+    if (!recursive) {
+        return;
+    }
+    // links are directory symlinks, they are not followed so each entity is converted once
+    for (bfs::recursive_directory_iterator it(dir), end; it != end; ++it) {
+        if (bfs::is_directory(it->symlink_status())) {
+            convert_dir(it->path(), format);
+        }
+    }
+}
+
 } //namespace file
 } //namespace nix
@@ -18,6 +18,8 @@
 #include <nix/NDSize.hpp>
 #include <nix/base/IFile.hpp>
 
+#include "PackedAttributesFS.hpp"
+
 namespace nix {
 namespace file {
 
@@ -26,10 +28,14 @@ class AttributesFS {
 private:
     boost::filesystem::path loc;
     FileMode mode;
+    AttributeFormat fmt;
     YAML::Node node;
+    PackedAttributesFS packed;
 
     void open_or_create();
 
+    bool contains(const std::string &name) const;
+
     void flush();
 
 public:
@@ -37,12 +43,15 @@ public:
 
     AttributesFS(const std::string &file_path, FileMode mode = FileMode::ReadOnly);
 
-    AttributesFS(const boost::filesystem::path &file_path, FileMode mode = FileMode::ReadOnly);
+    AttributesFS(const boost::filesystem::path &file_path, FileMode mode = FileMode::ReadOnly,
+                 AttributeFormat format = AttributeFormat::Auto);
 
     // AttributesFS(const nix::file::AttributesFS &other);
 
     boost::filesystem::path location() const;
 
+    AttributeFormat format() const;
+
     bool has(const std::string &name);
 
     void remove(const std::string &name);
@@ -52,12 +61,27 @@ public:
     template <typename T> void set(const std::string &name, const T &value);
 
     ndsize_t attributeCount();
+
+    /**
+     * @brief Whether the directory has attributes in any of the formats.
+     */
+    static bool exists(const boost::filesystem::path &dir);
+
+    /**
+     * @brief Rewrite the attributes of dir (and of all directories below it
+     * if recursive is true) in the given format.
+     */
+    static void convert(const boost::filesystem::path &dir, AttributeFormat format, bool recursive = true);
 };
 
 template <typename T> void AttributesFS::get(const std::string &name, T &value) {
     open_or_create();
-    if (has(name)) {
-        value = node[name].as<T>();
+    if (contains(name)) {
+        if (fmt == AttributeFormat::Packed) {
+            packed.get(name, value);
+        } else {
+            value = node[name].as<T>();
+        }
     }
 }
 
@@ -66,6 +90,11 @@ template <typename T> void AttributesFS::set(const std::string &name, const T &v
     if (mode == FileMode::ReadOnly) {
         throw std::logic_error("Trying to set an attributes in ReadOnly mode!");
     }
+    if (fmt == AttributeFormat::Packed) {
+        packed.set(name, value);
+        packed.flush();
+        return;
+    }
     if (node[name]) {
         node.remove(name);
     }
@@ -221,6 +221,32 @@ bool BlockFS::removeEntity(const nix::Identity &ident) {
     return p->removeObjectByNameOrAttribute("entity_id", name);
 }
 
+
+// links to the entities are not tracked by the file system back-end, only
+// the entities themselves are removed and reported; the links dangle and
+// are no longer listed
+std::vector<std::string> BlockFS::removeEntities(const std::vector<nix::Identity> &idents) {
+    std::vector<std::string> removed;
+    for (const auto &ident : idents) {
+        boost::optional<bfs::path> eg = findEntityGroup(ident);
+        if (!eg) {
+            continue;
+        }
+
+        std::string path = (eg->parent_path().filename() / eg->filename()).generic_string();
+        if (removeEntity(ident)) {
+            removed.push_back(path);
+        }
+    }
+    return removed;
+}
+
+
+std::shared_ptr<base::IEntity> BlockFS::copyEntity(const std::shared_ptr<base::IEntity> &source, ObjectType type,
+                                                   const std::string &name) {
+    throw UnsupportedOperation("copying entities", "file system");
+}
+
 //--------------------------------------------------
 // Methods concerning sources
 //--------------------------------------------------
@@ -251,7 +277,8 @@ bool BlockFS::deleteSource(const std::string &name_or_id) {
 
 std::shared_ptr<base::IDataArray> BlockFS::createDataArray(const std::string &name, const std::string &type,
                                                            nix::DataType data_type, const NDSize &shape,
-                                                           const Compression &compression) {
+                                                           const Compression &compression,
+                                                           const DataStorage &storage) {
     if (name.empty()) {
         throw EmptyString("Block::createDataArray empty name provided!");
     }
@@ -260,7 +287,7 @@ std::shared_ptr<base::IDataArray> BlockFS::createDataArray(const std::string &na
     }
     std::string id = util::createId();
     DataArrayFS da(file(), block(), data_array_dir.location(), id, type, name);
-    da.createData(data_type, shape, compression);
+    da.createData(data_type, shape, compression, storage);
     return std::make_shared<DataArrayFS>(da);
 }
 
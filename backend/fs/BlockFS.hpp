@@ -88,6 +88,11 @@ public:
 
     bool removeEntity(const nix::Identity &ident);
 
+    std::vector<std::string> removeEntities(const std::vector<nix::Identity> &idents);
+
+    std::shared_ptr<base::IEntity> copyEntity(const std::shared_ptr<base::IEntity> &source, ObjectType type,
+                                              const std::string &name);
+
     void addEntity(const nix::Identity &ident);
 
     //--------------------------------------------------
@@ -117,7 +122,8 @@ public:
 
     std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
                                                       nix::DataType data_type, const NDSize &shape,
-                                                      const Compression &compression);
+                                                      const Compression &compression,
+                                                      const DataStorage &storage);
 
     //--------------------------------------------------
     // Methods concerning data frames
@@ -240,7 +240,8 @@ bool DataArrayFS::deleteDimensions() {
 DataArrayFS::~DataArrayFS() {
 }
 
-void DataArrayFS::createData(DataType dtype, const NDSize &size, const Compression &compression) {
+void DataArrayFS::createData(DataType dtype, const NDSize &size, const Compression &compression,
+                             const DataStorage &storage) {
     setDtype(dtype);
     dataExtent(size);
     /*
@@ -301,6 +302,68 @@ void DataArrayFS::read(DataType dtype, void *data, const NDSize &count, const ND
     */
 }
 
+MappedData DataArrayFS::mappedData() const {
+    // FIXME: data is not stored by the file system backend yet
+    return MappedData();
+}
+
+NDSize DataArrayFS::dataChunks() const {
+    // FIXME: data is not stored by the file system backend yet
+    return NDSize{};
+}
+
+void DataArrayFS::createStatistics() {
+    // FIXME: data is not stored by the file system backend yet
+}
+
+bool DataArrayFS::hasStatistics() const {
+    // FIXME: data is not stored by the file system backend yet
+    return false;
+}
+
+bool DataArrayFS::deleteStatistics() {
+    // FIXME: data is not stored by the file system backend yet
+    return false;
+}
+
+DataStatistics DataArrayFS::statistics(const NDSize &offset, const NDSize &count) const {
+    // FIXME: data is not stored by the file system backend yet
+    return DataStatistics();
+}
+
+void DataArrayFS::createPyramid(const PyramidOptions &options) {
+    // FIXME: data is not stored by the file system backend yet
+}
+
+bool DataArrayFS::hasPyramid() const {
+    // FIXME: data is not stored by the file system backend yet
+    return false;
+}
+
+bool DataArrayFS::deletePyramid() {
+    // FIXME: data is not stored by the file system backend yet
+    return false;
+}
+
+std::vector<ndsize_t> DataArrayFS::pyramidFactors() const {
+    // FIXME: data is not stored by the file system backend yet
+    return std::vector<ndsize_t>();
+}
+
+void DataArrayFS::readPyramid(ndsize_t factor, ndsize_t offset, ndsize_t count,
+                              std::vector<double> &min, std::vector<double> &max) const {
+    // FIXME: data is not stored by the file system backend yet
+}
+
+void DataArrayFS::refresh() {
+    // FIXME: data is not stored by the file system backend yet
+}
+
+void DataArrayFS::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset,
+                       const NDSize &stride, const NDSize &block) const {
+    // FIXME: see read() above
+}
+
 NDSize DataArrayFS::dataExtent(void) const {
     if (!hasAttr("extent")) {
         return NDSize{};
@@ -149,7 +149,8 @@ public:
     // Methods concerning data access.
     //--------------------------------------------------
 
-    virtual void createData(DataType dtype, const NDSize &size, const Compression &compression);
+    virtual void createData(DataType dtype, const NDSize &size, const Compression &compression,
+                            const DataStorage &storage);
 
 
     bool hasData() const;
@@ -161,6 +162,47 @@ public:
     void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const;
 
 
+    void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset,
+              const NDSize &stride, const NDSize &block) const;
+
+
+    MappedData mappedData() const;
+
+
+    NDSize dataChunks() const;
+
+
+    void createStatistics();
+
+
+    bool hasStatistics() const;
+
+
+    bool deleteStatistics();
+
+
+    DataStatistics statistics(const NDSize &offset, const NDSize &count) const;
+
+
+    void createPyramid(const PyramidOptions &options);
+
+
+    bool hasPyramid() const;
+
+
+    bool deletePyramid();
+
+
+    std::vector<ndsize_t> pyramidFactors() const;
+
+
+    void readPyramid(ndsize_t factor, ndsize_t offset, ndsize_t count,
+                     std::vector<double> &min, std::vector<double> &max) const;
+
+
+    void refresh();
+
+
     NDSize dataExtent(void) const;
 
 
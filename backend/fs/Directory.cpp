@@ -9,11 +9,322 @@
 #include <iostream>
 #include "Directory.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+#define ORDER_FILE std::string(".order")
+
 namespace bfs = boost::filesystem;
 
 namespace nix {
 namespace file {
 
+/*
+ * Sub-directories are indexed in the order they were created in, like the
+ * links of an HDF5 group. Each directory created by this class lists the
+ * names of its children in ORDER_FILE, one per line, in the order they were
+ * added; children that are not listed there, e.g. in files of older
+ * versions, come first, ordered by name. The index of a directory is built
+ * once and shared by all Directory objects of that path. Changes made
+ * through this class update it in place, other changes are detected by the
+ * modification stamp of the directory. Links to removed directories only
+ * dangle, the directory of the link does not change; the links of an index
+ * are checked again whenever something was removed through this class.
+ */
+namespace {
+
+struct Stamp {
+    int64_t  sec;
+    int64_t  nsec;
+    uint64_t ino;
+    uint64_t nlink;
+
+    bool operator==(const Stamp &other) const {
+        return sec == other.sec && nsec == other.nsec && ino == other.ino && nlink == other.nlink;
+    }
+};
+
+
+bool dir_stamp(const bfs::path &dir, Stamp &stamp) {
+#ifndef _WIN32
+    struct stat st;
+    if (::stat(dir.c_str(), &st) != 0) {
+        return false;
+    }
+#ifdef __APPLE__
+    stamp = {st.st_mtimespec.tv_sec, st.st_mtimespec.tv_nsec, st.st_ino, st.st_nlink};
+#else
+    stamp = {st.st_mtim.tv_sec, st.st_mtim.tv_nsec, st.st_ino, st.st_nlink};
+#endif
+#else
+    boost::system::error_code ec;
+    std::time_t t = bfs::last_write_time(dir, ec);
+    if (ec) {
+        return false;
+    }
+    stamp = {static_cast<int64_t>(t), 0, 0, 0};
+#endif
+    return true;
+}
+
+
+struct DirIndex {
+    Stamp                    stamp;
+    std::vector<std::string> names;     // the children in creation order
+    std::vector<std::string> links;     // the children that are links
+    size_t                   recorded;  // the lines in the order file
+    uint64_t                 checked;   // the removals the links were checked against
+};
+
+
+bool is_link(const bfs::path &p) {
+    boost::system::error_code ec;
+    return bfs::is_symlink(bfs::symlink_status(p, ec));
+}
+
+
+// a link whose target was removed no longer counts as a child
+bool links_alive(const bfs::path &dir, const DirIndex &index) {
+    for (const auto &name : index.links) {
+        boost::system::error_code ec;
+        if (!bfs::is_directory(dir / name, ec)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void build_index(const bfs::path &dir, DirIndex &index) {
+    std::unordered_set<std::string> present;
+    index.links.clear();
+    boost::system::error_code ec;
+    for (bfs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        boost::system::error_code ec_type;
+        if (bfs::is_directory(it->path(), ec_type)) {
+            present.insert(it->path().filename().string());
+            if (bfs::is_symlink(it->symlink_status(ec_type))) {
+                index.links.push_back(it->path().filename().string());
+            }
+        }
+    }
+
+    std::vector<std::string> recorded;
+    std::ifstream in((dir / ORDER_FILE).string());
+    for (std::string line; std::getline(in, line); ) {
+        recorded.push_back(line);
+    }
+
+    // a name that was removed and created again counts from its last entry
+    std::vector<std::string> listed;
+    std::unordered_set<std::string> placed;
+    for (auto it = recorded.rbegin(); it != recorded.rend(); ++it) {
+        if (present.count(*it) > 0 && placed.insert(*it).second) {
+            listed.push_back(*it);
+        }
+    }
+
+    index.names.clear();
+    for (const auto &name : present) {
+        if (placed.count(name) == 0) {
+            index.names.push_back(name);
+        }
+    }
+    std::sort(index.names.begin(), index.names.end());
+    index.names.insert(index.names.end(), listed.rbegin(), listed.rend());
+    index.recorded = recorded.size();
+}
+
+
+// start to record the order of the children of a new directory
+void track_order(const bfs::path &dir) {
+    std::ofstream out((dir / ORDER_FILE).string(), std::ios::app);
+}
+
+
+void write_order(const bfs::path &dir, const std::vector<std::string> &names) {
+    std::ofstream out((dir / ORDER_FILE).string(), std::ios::trunc);
+    for (const auto &name : names) {
+        out << name << '\n';
+    }
+}
+
+
+class IndexCache {
+public:
+
+    ndsize_t count(const bfs::path &dir) {
+        std::lock_guard<std::mutex> guard(mutex);
+        const DirIndex *index = lookup(dir);
+        return index ? index->names.size() : 0;
+    }
+
+    bool name(const bfs::path &dir, ndsize_t pos, std::string &name) {
+        std::lock_guard<std::mutex> guard(mutex);
+        const DirIndex *index = lookup(dir);
+        if (!index || pos >= index->names.size()) {
+            return false;
+        }
+        name = index->names[static_cast<size_t>(pos)];
+        return true;
+    }
+
+    void added(const bfs::path &dir, const std::string &name) {
+        const bfs::path order = dir / ORDER_FILE;
+        const bool tracked = bfs::exists(order);
+        if (tracked) {
+            std::ofstream out(order.string(), std::ios::app);
+            out << name << '\n';
+        }
+
+        std::lock_guard<std::mutex> guard(mutex);
+        auto it = entries.find(key(dir));
+        if (it != entries.end() && !tracked) {
+            // ordered by name, rebuilt on the next access
+            lru.erase(it->second.pos);
+            entries.erase(it);
+        } else if (it != entries.end()) {
+            DirIndex &index = it->second.index;
+            index.names.erase(std::remove(index.names.begin(), index.names.end(), name), index.names.end());
+            index.names.push_back(name);
+            index.recorded++;
+            if (is_link(dir / name) &&
+                std::find(index.links.begin(), index.links.end(), name) == index.links.end()) {
+                index.links.push_back(name);
+            }
+            restamp(dir, it);
+        }
+    }
+
+    void removed(const bfs::path &dir, const std::string &name) {
+        std::lock_guard<std::mutex> guard(mutex);
+        forget_below(dir / name);
+        removals++;
+
+        auto it = entries.find(key(dir));
+        if (it != entries.end()) {
+            DirIndex &index = it->second.index;
+            index.names.erase(std::remove(index.names.begin(), index.names.end(), name), index.names.end());
+            index.links.erase(std::remove(index.links.begin(), index.links.end(), name), index.links.end());
+            // drop the entries of removed children once they dominate the order file
+            if (index.recorded > 2 * index.names.size() + 64) {
+                write_order(dir, index.names);
+                index.recorded = index.names.size();
+            }
+            restamp(dir, it);
+        }
+    }
+
+    void forget(const bfs::path &dir) {
+        std::lock_guard<std::mutex> guard(mutex);
+        forget_below(dir);
+        removals++;
+    }
+
+private:
+
+    struct Entry {
+        DirIndex                         index;
+        std::list<std::string>::iterator pos;
+    };
+
+    static const size_t capacity = 1024;
+
+    std::mutex                             mutex;
+    std::list<std::string>                 lru;
+    std::unordered_map<std::string, Entry> entries;
+    uint64_t                               removals = 0;
+
+    static std::string key(const bfs::path &dir) {
+        return bfs::absolute(dir).string();
+    }
+
+    const DirIndex *lookup(const bfs::path &dir) {
+        const std::string k = key(dir);
+        auto it = entries.find(k);
+
+        Stamp stamp;
+        if (!dir_stamp(dir, stamp)) {
+            if (it != entries.end()) {
+                lru.erase(it->second.pos);
+                entries.erase(it);
+            }
+            return nullptr;
+        }
+
+        if (it != entries.end()) {
+            DirIndex &index = it->second.index;
+            lru.splice(lru.begin(), lru, it->second.pos);
+            if (index.stamp == stamp && (index.checked == removals || links_alive(dir, index))) {
+                index.checked = removals;
+                return &index;
+            }
+        } else {
+            if (entries.size() >= capacity) {
+                entries.erase(lru.back());
+                lru.pop_back();
+            }
+            lru.push_front(k);
+            it = entries.emplace(k, Entry{DirIndex(), lru.begin()}).first;
+        }
+
+        build_index(dir, it->second.index);
+        it->second.index.stamp = stamp;
+        it->second.index.checked = removals;
+        return &it->second.index;
+    }
+
+    void restamp(const bfs::path &dir, std::unordered_map<std::string, Entry>::iterator it) {
+        if (!dir_stamp(dir, it->second.index.stamp)) {
+            lru.erase(it->second.pos);
+            entries.erase(it);
+        }
+    }
+
+    // drop the indexes of dir and everything below it
+    void forget_below(const bfs::path &dir) {
+        const std::string k = key(dir);
+        const std::string prefix = (bfs::path(k) / "").string();
+        for (auto it = entries.begin(); it != entries.end(); ) {
+            if (it->first == k || it->first.compare(0, prefix.size(), prefix) == 0) {
+                lru.erase(it->second.pos);
+                it = entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+};
+
+
+IndexCache &index_cache() {
+    static IndexCache cache;
+    return cache;
+}
+
+
+// split a path into the absolute parent directory and the name of the child
+bool split_child(const bfs::path &child, bfs::path &parent, std::string &name) {
+    bfs::path p = bfs::absolute(child);
+    if (p.filename() == ".") {
+        p = p.parent_path();
+    }
+    parent = p.parent_path();
+    name = p.filename().string();
+    return !parent.empty() && !name.empty();
+}
+
+} // anonymous namespace
+
 Directory::Directory(const bfs::path &location, FileMode mode)
     : loc(location), mode(mode) {
     open_or_create();
@@ -24,7 +335,15 @@ Directory::Directory(const std::string &location, FileMode mode): Directory(bfs:
 void Directory::open_or_create() {
     if (!exists(loc)) {
         if (mode > FileMode::ReadOnly) {
+            std::vector<bfs::path> created;
+            for (bfs::path p = loc; !p.empty() && !exists(p); p = p.parent_path()) {
+                created.push_back(p);
+            }
             create_directories(loc);
+            for (auto it = created.rbegin(); it != created.rend(); ++it) {
+                track_order(*it);
+                childAdded(*it);
+            }
         } else {
             throw std::logic_error("Trying to create new directory in ReadOnly mode!");
         }
@@ -43,15 +362,7 @@ FileMode Directory::fileMode() const {
 
 
 ndsize_t Directory::subdirCount() const {
-    ndsize_t count = 0;
-    bfs::directory_iterator end;
-    bfs::directory_iterator di(location().c_str());
-    while (di != end) {
-        if (bfs::is_directory(*di))
-            count ++;
-        ++di;
-    }
-    return count;
+    return index_cache().count(loc);
 }
 
 
@@ -60,16 +371,18 @@ void Directory::removeAll() {
     for (bfs::directory_iterator end_it, it(p); it!=end_it; ++it) {
         bfs::remove_all(it->path());
     }
+    index_cache().forget(p);
+    if (mode > FileMode::ReadOnly) {
+        track_order(p);
+    }
 }
 
 
 boost::filesystem::path Directory::sub_dir_by_index(ndsize_t index) const {
     bfs::path p;
-    std::vector<bfs::path> paths;
-    copy(bfs::directory_iterator(loc), bfs::directory_iterator(), back_inserter(paths));
-    std::sort(paths.begin(), paths.end());
-    if (index < paths.size())
-        p = paths[index];
+    std::string name;
+    if (index_cache().name(loc, index, name))
+        p = loc / name;
     return p;
 }
 
@@ -80,12 +393,11 @@ boost::optional<bfs::path> Directory::findByNameOrAttribute(const std::string &a
         p = location() / bfs::path(value.c_str());
         return p;
     }
-    bfs::path attr_path("attributes");
     bfs::directory_iterator end;
     bfs::directory_iterator di(location().c_str());
     while (di != end) {
         bfs::path temp = *di;
-        if (bfs::is_directory(temp) && exists(temp / attr_path)){
+        if (bfs::is_directory(temp) && AttributesFS::exists(temp)) {
             AttributesFS attr(temp);
             std::string s;
             if (attr.has(attribute)) {
@@ -103,32 +415,28 @@ boost::optional<bfs::path> Directory::findByNameOrAttribute(const std::string &a
 
 
 bool Directory::hasObject(const std::string &name) const {
-    bfs::directory_iterator end;
-    bfs::directory_iterator di(location().c_str());
-    while (di != end) {
-        bfs::path temp = *di;
-        if (bfs::is_directory(temp) && temp.filename().string() == name)
-            return true;
-        ++di;
-    }
-    return false;
+    if (name.empty() || name == "." || name == ".." || name.find_first_of("/\\") != std::string::npos)
+        return false;
+    boost::system::error_code ec;
+    return bfs::is_directory(loc / name, ec);
 }
 
 bool Directory::removeObjectByNameOrAttribute(const std::string &attribute, const std::string &name_or_id) const {
     boost::optional<bfs::path> p = findByNameOrAttribute(attribute, name_or_id);
     if (p && mode > FileMode::ReadOnly) {
-        bfs::path attr_path = "attributes";
-        if (bfs::exists(*p / attr_path)) {
+        if (AttributesFS::exists(*p)) {
             AttributesFS attr(*p, mode);
             if (attr.has("links")) {
                 std::vector<std::string> links;
                 attr.get("links", links);
                 for (auto &l :links) {
                     bfs::remove_all(bfs::path(l));
+                    childRemoved(bfs::path(l));
                 }
             }
         }
         uintmax_t ret = bfs::remove_all(*p);
+        childRemoved(*p);
         return ret > 0;
     }
     return false;
@@ -139,6 +447,7 @@ void Directory::createDirectoryLink(const std::string &target, const std::string
     bfs::path p(target);
     if (boost::filesystem::exists(p)) {
         boost::filesystem::create_directory_symlink(boost::filesystem::path(target), loc / boost::filesystem::path(name));
+        childAdded(loc / name);
     } else {
         throw std::runtime_error("Directory::createLink: target does not exist");
     }
@@ -149,6 +458,8 @@ void Directory::renameSubdir(const std::string &old_name, const std::string &new
     bfs::path o(bfs::path(location()) / bfs::path(old_name)), n(bfs::path(location()) / bfs::path(new_name));
     if (hasObject(old_name) && ! hasObject(new_name)) {
         rename(o, n);
+        childRemoved(o);
+        childAdded(n);
     }
 }
 
@@ -157,5 +468,23 @@ bool Directory::isValid() const {
     return bfs::exists(location());
 }
 
+
+void Directory::childAdded(const bfs::path &child) {
+    bfs::path parent;
+    std::string name;
+    if (split_child(child, parent, name)) {
+        index_cache().added(parent, name);
+    }
+}
+
+
+void Directory::childRemoved(const bfs::path &child) {
+    bfs::path parent;
+    std::string name;
+    if (split_child(child, parent, name)) {
+        index_cache().removed(parent, name);
+    }
+}
+
 } // nix::file
 } // nix
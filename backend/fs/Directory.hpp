@@ -19,6 +19,13 @@
 namespace nix {
 namespace file {
 
+/**
+ * A directory of the file system back-end. Its sub-directories are indexed
+ * in the order they were created in, like the links of an HDF5 group;
+ * before the index was kept they were indexed by name. Sub-directories
+ * that are not recorded in the ".order" file of the directory come first,
+ * ordered by name.
+ */
 class Directory {
 
 private:
@@ -40,6 +47,10 @@ public:
 
     ndsize_t subdirCount() const;
 
+    /**
+     * The sub-directory at the given position in creation order, or an
+     * empty path if there is none.
+     */
     boost::filesystem::path sub_dir_by_index(ndsize_t index) const;
 
     bool hasObject(const std::string &name) const;
@@ -55,6 +66,18 @@ public:
     bool isValid() const;
 
     virtual void removeAll();
+
+    /**
+     * Tell the index of the parent directory that the directory or link
+     * child was created outside of this class.
+     */
+    static void childAdded(const boost::filesystem::path &child);
+
+    /**
+     * Tell the index of the parent directory that the directory or link
+     * child was removed outside of this class.
+     */
+    static void childRemoved(const boost::filesystem::path &child);
 };
 
 }
@@ -14,10 +14,11 @@ namespace bfs = boost::filesystem;
 namespace nix {
 namespace file {
 
-DirectoryWithAttributes::DirectoryWithAttributes(const bfs::path &location, FileMode mode, bool checkHeader)
+DirectoryWithAttributes::DirectoryWithAttributes(const bfs::path &location, FileMode mode, bool checkHeader,
+                                                 AttributeFormat format)
     : Directory(location, mode) {
     if (checkHeader && mode < FileMode::ReadWrite) {
-        if (!bfs::exists(location / bfs::path("attributes"))) {
+        if (!AttributesFS::exists(location)) {
            throw nix::InvalidFile("DirectoryWithAttributes");
         } else {
             attributes = AttributesFS(location, mode);
@@ -33,12 +34,13 @@ DirectoryWithAttributes::DirectoryWithAttributes(const bfs::path &location, File
             }
         }
     } else {
-        attributes = AttributesFS(location, mode);
+        attributes = AttributesFS(location, mode, format);
     }
 }
 
-DirectoryWithAttributes::DirectoryWithAttributes(const std::string &location, FileMode mode, bool checkHeader)
-    : DirectoryWithAttributes(bfs::path(location.c_str()), mode, checkHeader)
+DirectoryWithAttributes::DirectoryWithAttributes(const std::string &location, FileMode mode, bool checkHeader,
+                                                 AttributeFormat format)
+    : DirectoryWithAttributes(bfs::path(location.c_str()), mode, checkHeader, format)
 {
 }
 
@@ -51,8 +53,9 @@ void DirectoryWithAttributes::removeAttr(const std::string &name) {
 }
 
 void DirectoryWithAttributes::removeAll() {
+    AttributeFormat format = attributes.format();
     Directory::removeAll();
-    attributes = AttributesFS(location(), fileMode());
+    attributes = AttributesFS(location(), fileMode(), format);
 }
 
 void DirectoryWithAttributes::createLink(const bfs::path &linker) {
@@ -61,6 +64,7 @@ void DirectoryWithAttributes::createLink(const bfs::path &linker) {
         getAttr("links", links);
     }
     bfs::create_directory_symlink(bfs::path(location()), linker);
+    childAdded(linker);
     links.push_back(linker.string());
     setAttr("links", links);
 }
@@ -80,10 +84,14 @@ void DirectoryWithAttributes::unlink(const bfs::path &linker) {
 }
 
 
+AttributeFormat DirectoryWithAttributes::attributeFormat() const {
+    return attributes.format();
+}
+
+
 bool DirectoryWithAttributes::isValid() const {
-    bfs::path attr_path = "attributes";
     return  bfs::exists(location()) &&
-            bfs::exists(location() / attr_path);
+            AttributesFS::exists(location());
 }
 
 
@@ -26,9 +26,10 @@ private:
 
 public:
     DirectoryWithAttributes (const boost::filesystem::path &location, FileMode mode = FileMode::ReadOnly,
-                             bool checkHeader = false);
+                             bool checkHeader = false, AttributeFormat format = AttributeFormat::Auto);
 
-    DirectoryWithAttributes (const std::string &location, FileMode mode = FileMode::ReadOnly, bool checkHeader = false);
+    DirectoryWithAttributes (const std::string &location, FileMode mode = FileMode::ReadOnly, bool checkHeader = false,
+                             AttributeFormat format = AttributeFormat::Auto);
 
     template <typename T> void setAttr(const std::string &name, const T &value);
 
@@ -40,6 +41,8 @@ public:
 
     void removeAll();
 
+    AttributeFormat attributeFormat() const;
+
     void createLink(const boost::filesystem::path &linker);
 
     /**
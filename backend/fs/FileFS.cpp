@@ -16,8 +16,8 @@ namespace nix {
 namespace file {
 
 
-FileFS::FileFS(const std::string &name, FileMode mode, Compression compression)
-    : DirectoryWithAttributes(name, mode, true) {
+FileFS::FileFS(const std::string &name, FileMode mode, Compression compression, AttributeFormat format)
+    : DirectoryWithAttributes(name, mode, true, format) {
     this->mode = mode;
     this->compr = compression;
     if (mode == FileMode::Overwrite) {
@@ -46,6 +46,16 @@ ndsize_t FileFS::blockCount() const {
     return data_dir.subdirCount();
 }
 
+void FileFS::startSwmrWrite() {
+    throw std::runtime_error("SWMR access is not supported by the file system backend!");
+}
+
+
+std::vector<char> FileFS::toImage() {
+    throw std::runtime_error("File images are not supported by the file system backend!");
+}
+
+
 bool FileFS::hasBlock(const std::string &name_or_id) const  {
     boost::optional<bfs::path> path = data_dir.findByNameOrAttribute("entity_id", name_or_id);
     return (bool)path;
@@ -91,6 +101,12 @@ bool FileFS::deleteBlock(const std::string &name_or_id) {
     return data_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
 }
 
+
+std::shared_ptr<base::IBlock> FileFS::copyBlock(const std::shared_ptr<base::IBlock> &source,
+                                                const std::string &name) {
+    throw UnsupportedOperation("copying blocks", "file system");
+}
+
 //--------------------------------------------------
 // Methods concerning sections
 //--------------------------------------------------
@@ -143,6 +159,12 @@ bool FileFS::deleteSection(const std::string &name_or_id) {
     return metadata_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
 }
 
+
+std::shared_ptr<base::ISection> FileFS::copySection(const std::shared_ptr<base::ISection> &source,
+                                                    const std::string &name) {
+    throw UnsupportedOperation("copying sections", "file system");
+}
+
 //--------------------------------------------------
 // Methods for file attribute access.
 //--------------------------------------------------
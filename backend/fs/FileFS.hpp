@@ -29,12 +29,19 @@ private:
     void create_subfolders(const std::string &loc);
 
 public:
-    FileFS(const std::string &name, const FileMode mode = FileMode::ReadWrite, const Compression compression = Compression::Auto);
+    FileFS(const std::string &name, const FileMode mode = FileMode::ReadWrite, const Compression compression = Compression::Auto,
+           const AttributeFormat format = AttributeFormat::Yaml);
 
 
     bool flush() { return true; };
 
 
+    void startSwmrWrite();
+
+
+    std::vector<char> toImage();
+
+
     ndsize_t blockCount() const;
 
 
@@ -52,6 +59,9 @@ public:
 
     bool deleteBlock(const std::string &name_or_id);
 
+
+    std::shared_ptr<base::IBlock> copyBlock(const std::shared_ptr<base::IBlock> &source, const std::string &name);
+
     //--------------------------------------------------
     // Methods concerning sections
     //--------------------------------------------------
@@ -71,6 +81,10 @@ public:
     std::shared_ptr<base::ISection> createSection(const std::string &name, const std::string &type);
 
 
+    std::shared_ptr<base::ISection> copySection(const std::shared_ptr<base::ISection> &source,
+                                                const std::string &name);
+
+
     bool deleteSection(const std::string &name_or_id);
 
     //--------------------------------------------------
@@ -190,5 +190,16 @@ void GroupFS::addEntity(const nix::Identity &ident) {
     p->createDirectoryLink(target->location(), target->id());
 }
 
+
+void GroupFS::entities(ObjectType type, const std::vector<nix::Identity> &idents) {
+    while (entityCount(type) > 0) {
+        removeEntity({"", getEntity(type, 0)->id(), type});
+    }
+
+    for (const auto &ident : idents) {
+        addEntity({ident.name(), ident.id(), type});
+    }
+}
+
 } // file
 } // nix
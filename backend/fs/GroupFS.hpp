@@ -49,6 +49,8 @@ public:
 
     void addEntity(const nix::Identity &ident);
 
+    void entities(ObjectType type, const std::vector<nix::Identity> &idents);
+
     /**
     * Standard constructor for an existing Group
     */
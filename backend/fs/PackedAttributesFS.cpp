@@ -0,0 +1,314 @@
+// Copyright (c) 2013 - 2015, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "PackedAttributesFS.hpp"
+
+#include <boost/interprocess/file_mapping.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <limits>
+#include <stdexcept>
+
+namespace bfs = boost::filesystem;
+namespace bip = boost::interprocess;
+
+namespace nix {
+namespace file {
+
+#define PACKED_MAGIC   "NIXATTR"
+#define PACKED_VERSION 1u
+
+static const size_t header_size = 16;
+static const size_t record_head_size = 24;
+
+static size_t padded(size_t n) {
+    return (n + 7) & ~static_cast<size_t>(7);
+}
+
+template<typename T>
+static T read_raw(const char *ptr) {
+    T v;
+    std::memcpy(&v, ptr, sizeof(v));
+    return v;
+}
+
+template<typename T>
+static void append_raw(std::string &buf, T v) {
+    buf.append(reinterpret_cast<const char *>(&v), sizeof(v));
+}
+
+
+PackedAttributesFS::PackedAttributesFS() { }
+
+
+PackedAttributesFS::PackedAttributesFS(const bfs::path &file_path)
+    : loc(file_path) { }
+
+
+bfs::path PackedAttributesFS::location() const {
+    return loc;
+}
+
+
+void PackedAttributesFS::load() {
+    entries.clear();
+    region.reset();
+
+    if (!bfs::exists(loc) || bfs::file_size(loc) == 0) {
+        return;
+    }
+
+    bip::file_mapping mapping(loc.string().c_str(), bip::read_only);
+    region = std::make_shared<bip::mapped_region>(mapping, bip::read_only);
+    parse(static_cast<const char *>(region->get_address()), region->get_size());
+}
+
+
+void PackedAttributesFS::parse(const char *base, size_t size) {
+    if (size < header_size || std::memcmp(base, PACKED_MAGIC, sizeof(PACKED_MAGIC)) != 0) {
+        throw std::runtime_error("PackedAttributesFS: not a packed attribute file!");
+    }
+    if (read_raw<uint32_t>(base + 8) != PACKED_VERSION) {
+        throw std::runtime_error("PackedAttributesFS: unsupported version or byte order!");
+    }
+
+    const uint32_t nrecords = read_raw<uint32_t>(base + 12);
+    size_t pos = header_size;
+
+    for (uint32_t i = 0; i < nrecords; i++) {
+        if (pos + record_head_size > size) {
+            throw std::runtime_error("PackedAttributesFS: truncated attribute file!");
+        }
+
+        const uint16_t keylen = read_raw<uint16_t>(base + pos);
+        Record r;
+        r.type = static_cast<RecordType>(read_raw<uint8_t>(base + pos + 2));
+        r.sequence = read_raw<uint8_t>(base + pos + 3) != 0;
+        r.count = read_raw<uint64_t>(base + pos + 8);
+        r.size = static_cast<size_t>(read_raw<uint64_t>(base + pos + 16));
+        pos += record_head_size;
+
+        if (pos + padded(keylen) + r.size > size) {
+            throw std::runtime_error("PackedAttributesFS: truncated attribute file!");
+        }
+
+        std::string key(base + pos, keylen);
+        pos += padded(keylen);
+        r.data = base + pos;
+        pos += padded(r.size);
+
+        entries[key] = r;
+    }
+}
+
+
+void PackedAttributesFS::flush() {
+    std::string buf;
+    buf.append(PACKED_MAGIC, sizeof(PACKED_MAGIC));
+    append_raw<uint32_t>(buf, PACKED_VERSION);
+    append_raw<uint32_t>(buf, static_cast<uint32_t>(entries.size()));
+
+    for (const auto &e : entries) {
+        const Record &r = e.second;
+        append_raw<uint16_t>(buf, static_cast<uint16_t>(e.first.size()));
+        append_raw<uint8_t>(buf, static_cast<uint8_t>(r.type));
+        append_raw<uint8_t>(buf, r.sequence ? 1 : 0);
+        append_raw<uint32_t>(buf, 0);
+        append_raw<uint64_t>(buf, r.count);
+        append_raw<uint64_t>(buf, r.size);
+        buf.append(e.first);
+        buf.resize(padded(buf.size()), '\0');
+        buf.append(r.data, r.size);
+        buf.resize(padded(buf.size()), '\0');
+    }
+
+    // other instances may have the file mapped, so it is never truncated:
+    // the new file is written next to it and renamed over it
+    bfs::path temp = loc;
+    temp += bfs::unique_path(".%%%%-%%%%-%%%%.tmp");
+    std::ofstream ofs(temp.string(), std::ofstream::binary | std::ofstream::trunc);
+    if (!ofs.is_open()) {
+        throw std::runtime_error("Could not write to attributes file!");
+    }
+    ofs.write(buf.data(), buf.size());
+    ofs.close();
+    if (!ofs) {
+        boost::system::error_code ec;
+        bfs::remove(temp, ec);
+        throw std::runtime_error("Could not write to attributes file!");
+    }
+
+    // the records may point into the mapped file, drop them only now
+    entries.clear();
+    region.reset();
+    bfs::rename(temp, loc);
+
+    load();
+}
+
+
+const PackedAttributesFS::Record &PackedAttributesFS::record(const std::string &name) const {
+    auto it = entries.find(name);
+    if (it == entries.end()) {
+        throw std::runtime_error("PackedAttributesFS: no attribute " + name + "!");
+    }
+    return it->second;
+}
+
+
+bool PackedAttributesFS::has(const std::string &name) const {
+    return entries.find(name) != entries.end();
+}
+
+
+void PackedAttributesFS::remove(const std::string &name) {
+    entries.erase(name);
+}
+
+
+size_t PackedAttributesFS::size() const {
+    return entries.size();
+}
+
+
+const std::map<std::string, PackedAttributesFS::Record> &PackedAttributesFS::records() const {
+    return entries;
+}
+
+
+void PackedAttributesFS::put(const std::string &name, RecordType type, bool sequence,
+                             uint64_t count, std::string payload) {
+    if (name.size() > std::numeric_limits<uint16_t>::max()) {
+        throw std::runtime_error("PackedAttributesFS: attribute name too long!");
+    }
+    Record r;
+    r.type = type;
+    r.sequence = sequence;
+    r.count = count;
+    r.owned = std::make_shared<std::string>(std::move(payload));
+    r.size = r.owned->size();
+    r.data = r.owned->data();
+    entries[name] = r;
+}
+
+/* strings */
+
+std::vector<std::string> PackedAttributesFS::strings(const Record &r) {
+    std::vector<std::string> result;
+    result.reserve(r.count);
+
+    if (r.type != RecordType::String) {
+        for (size_t i = 0; i < r.count; i++) {
+            result.push_back(toString(r, i));
+        }
+        return result;
+    }
+
+    size_t pos = 0;
+    for (uint64_t i = 0; i < r.count; i++) {
+        if (pos + sizeof(uint32_t) > r.size) {
+            throw std::runtime_error("PackedAttributesFS: corrupt string record!");
+        }
+        const uint32_t len = read_raw<uint32_t>(r.data + pos);
+        pos += sizeof(uint32_t);
+        if (pos + len > r.size) {
+            throw std::runtime_error("PackedAttributesFS: corrupt string record!");
+        }
+        result.emplace_back(r.data + pos, len);
+        pos += len;
+    }
+    return result;
+}
+
+
+std::string PackedAttributesFS::formatDouble(double value) {
+    // shortest representation that reads back to the same value
+    std::string str;
+    for (int precision = 1; precision <= std::numeric_limits<double>::max_digits10; precision++) {
+        std::ostringstream out;
+        out.precision(precision);
+        out << value;
+        str = out.str();
+        if (std::strtod(str.c_str(), nullptr) == value) {
+            break;
+        }
+    }
+    return str;
+}
+
+
+std::string PackedAttributesFS::toString(const Record &r, size_t index) {
+    switch (r.type) {
+        case RecordType::String:
+            return strings(r).at(index);
+        case RecordType::Bool:
+            return numberAt<bool>(r, index) ? "true" : "false";
+        case RecordType::Int64:
+            return std::to_string(numberAt<int64_t>(r, index));
+        case RecordType::UInt64:
+            return std::to_string(numberAt<uint64_t>(r, index));
+        case RecordType::Double:
+            return formatDouble(numberAt<double>(r, index));
+    }
+    throw std::runtime_error("PackedAttributesFS: unknown record type!");
+}
+
+
+void PackedAttributesFS::get(const std::string &name, std::string &value) const {
+    const Record &r = record(name);
+    if (r.sequence || r.count != 1) {
+        throw std::runtime_error("PackedAttributesFS: attribute " + name + " is not a scalar!");
+    }
+    value = toString(r, 0);
+}
+
+
+void PackedAttributesFS::get(const std::string &name, std::vector<std::string> &value) const {
+    value = strings(record(name));
+}
+
+
+void PackedAttributesFS::set(const std::string &name, const std::string &value) {
+    set(name, std::vector<std::string>{value});
+    entries[name].sequence = false;
+}
+
+
+void PackedAttributesFS::set(const std::string &name, const char *value) {
+    set(name, std::string(value));
+}
+
+
+void PackedAttributesFS::set(const std::string &name, const std::vector<std::string> &value) {
+    std::string payload;
+    for (const auto &str : value) {
+        append_raw<uint32_t>(payload, static_cast<uint32_t>(str.size()));
+        payload.append(str);
+    }
+    put(name, RecordType::String, true, value.size(), std::move(payload));
+}
+
+
+namespace packed {
+
+template<>
+bool fromString<bool>(const std::string &str) {
+    if (str == "true" || str == "1") {
+        return true;
+    } else if (str == "false" || str == "0") {
+        return false;
+    }
+    throw std::runtime_error("PackedAttributesFS: cannot convert '" + str + "' to bool!");
+}
+
+} // namespace packed
+
+} // namespace file
+} // namespace nix
@@ -0,0 +1,300 @@
+// Copyright (c) 2013 - 2015, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_PACKED_ATTRIBUTES_FS_HPP
+#define NIX_PACKED_ATTRIBUTES_FS_HPP
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <nix/Platform.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace nix {
+namespace file {
+
+/**
+ * @brief On-disk format of the attributes of a directory.
+ *
+ * Auto picks whatever format is already present in the directory, or,
+ * for new directories, the format of the closest parent directory.
+ */
+enum class AttributeFormat {
+    Auto,
+    Yaml,
+    Packed
+};
+
+
+/**
+ * @brief Typed key/value records stored in a compact binary file.
+ *
+ * The file starts with a 16 byte header (magic, version, record count),
+ * followed by the records. Each record has a 24 byte head (key length,
+ * type, sequence flag, element count, payload size), then the key and
+ * the payload, both padded to 8 bytes so numbers can be copied straight
+ * out of the memory-mapped file. Numbers are stored in native byte order.
+ */
+class PackedAttributesFS {
+
+public:
+
+    enum class RecordType : uint8_t {
+        String = 0,
+        Bool   = 1,
+        Int64  = 2,
+        UInt64 = 3,
+        Double = 4
+    };
+
+    struct Record {
+        RecordType  type;
+        bool        sequence;
+        uint64_t    count;
+        size_t      size;
+        const char *data;
+        std::shared_ptr<std::string> owned;
+    };
+
+private:
+    boost::filesystem::path loc;
+    std::shared_ptr<boost::interprocess::mapped_region> region;
+    std::map<std::string, Record> entries;
+
+    void parse(const char *base, size_t size);
+
+    const Record &record(const std::string &name) const;
+
+public:
+    PackedAttributesFS();
+
+    explicit PackedAttributesFS(const boost::filesystem::path &file_path);
+
+    boost::filesystem::path location() const;
+
+    /**
+     * @brief (Re-)map the file and rebuild the record index.
+     */
+    void load();
+
+    /**
+     * @brief Write all records back to the file.
+     */
+    void flush();
+
+    bool has(const std::string &name) const;
+
+    void remove(const std::string &name);
+
+    size_t size() const;
+
+    const std::map<std::string, Record> &records() const;
+
+    void put(const std::string &name, RecordType type, bool sequence,
+             uint64_t count, std::string payload);
+
+    // getters
+
+    void get(const std::string &name, std::string &value) const;
+
+    void get(const std::string &name, std::vector<std::string> &value) const;
+
+    template<typename T>
+    void get(const std::string &name, T &value) const;
+
+    template<typename T>
+    void get(const std::string &name, std::vector<T> &value) const;
+
+    // setters
+
+    void set(const std::string &name, const std::string &value);
+
+    void set(const std::string &name, const char *value);
+
+    void set(const std::string &name, const std::vector<std::string> &value);
+
+    template<typename T>
+    void set(const std::string &name, const T &value);
+
+    template<typename T>
+    void set(const std::string &name, const std::vector<T> &value);
+
+    // record level helpers
+
+    static std::vector<std::string> strings(const Record &r);
+
+    static std::string toString(const Record &r, size_t index);
+
+    static std::string formatDouble(double value);
+
+    template<typename T>
+    static T numberAt(const Record &r, size_t index);
+};
+
+/* type mapping */
+
+template<typename T, typename Enable = void>
+struct packed_traits;
+
+template<>
+struct packed_traits<bool> {
+    static const PackedAttributesFS::RecordType type = PackedAttributesFS::RecordType::Bool;
+    typedef uint8_t storage_type;
+};
+
+template<typename T>
+struct packed_traits<T, typename std::enable_if<std::is_integral<T>::value &&
+                                                std::is_signed<T>::value>::type> {
+    static const PackedAttributesFS::RecordType type = PackedAttributesFS::RecordType::Int64;
+    typedef int64_t storage_type;
+};
+
+template<typename T>
+struct packed_traits<T, typename std::enable_if<std::is_integral<T>::value &&
+                                                std::is_unsigned<T>::value &&
+                                                !std::is_same<T, bool>::value>::type> {
+    static const PackedAttributesFS::RecordType type = PackedAttributesFS::RecordType::UInt64;
+    typedef uint64_t storage_type;
+};
+
+template<typename T>
+struct packed_traits<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+    static const PackedAttributesFS::RecordType type = PackedAttributesFS::RecordType::Double;
+    typedef double storage_type;
+};
+
+
+template<typename T>
+T PackedAttributesFS::numberAt(const Record &r, size_t index) {
+    const char *ptr = r.data;
+    switch (r.type) {
+        case RecordType::Bool: {
+            uint8_t v;
+            std::memcpy(&v, ptr + index * sizeof(v), sizeof(v));
+            return static_cast<T>(v != 0);
+        }
+        case RecordType::Int64: {
+            int64_t v;
+            std::memcpy(&v, ptr + index * sizeof(v), sizeof(v));
+            return static_cast<T>(v);
+        }
+        case RecordType::UInt64: {
+            uint64_t v;
+            std::memcpy(&v, ptr + index * sizeof(v), sizeof(v));
+            return static_cast<T>(v);
+        }
+        case RecordType::Double: {
+            double v;
+            std::memcpy(&v, ptr + index * sizeof(v), sizeof(v));
+            return static_cast<T>(v);
+        }
+        default:
+            throw std::runtime_error("PackedAttributesFS: record does not hold a number!");
+    }
+}
+
+namespace packed {
+
+template<typename T>
+T fromString(const std::string &str);
+
+template<>
+bool fromString<bool>(const std::string &str);
+
+template<typename T>
+T fromString(const std::string &str) {
+    typedef typename packed_traits<T>::storage_type storage_type;
+    std::size_t pos = 0;
+    storage_type v;
+    try {
+        if (std::is_floating_point<storage_type>::value) {
+            v = static_cast<storage_type>(std::stod(str, &pos));
+        } else if (std::is_signed<storage_type>::value) {
+            v = static_cast<storage_type>(std::stoll(str, &pos));
+        } else {
+            v = static_cast<storage_type>(std::stoull(str, &pos));
+        }
+    } catch (const std::logic_error &) {
+        pos = 0;
+    }
+    if (pos == 0 || pos != str.size()) {
+        throw std::runtime_error("PackedAttributesFS: cannot convert '" + str + "' to a number!");
+    }
+    return static_cast<T>(v);
+}
+
+} // namespace packed
+
+
+template<typename T>
+void PackedAttributesFS::get(const std::string &name, T &value) const {
+    const Record &r = record(name);
+    if (r.sequence || r.count != 1) {
+        throw std::runtime_error("PackedAttributesFS: attribute " + name + " is not a scalar!");
+    }
+    if (r.type == RecordType::String) {
+        value = packed::fromString<T>(strings(r).front());
+    } else {
+        value = numberAt<T>(r, 0);
+    }
+}
+
+
+template<typename T>
+void PackedAttributesFS::get(const std::string &name, std::vector<T> &value) const {
+    const Record &r = record(name);
+    value.clear();
+    value.reserve(r.count);
+    if (r.type == RecordType::String) {
+        for (const auto &str : strings(r)) {
+            value.push_back(packed::fromString<T>(str));
+        }
+    } else if (r.type == packed_traits<T>::type && sizeof(T) == sizeof(typename packed_traits<T>::storage_type)) {
+        value.resize(r.count);
+        std::memcpy(value.data(), r.data, r.count * sizeof(T));
+    } else {
+        for (size_t i = 0; i < r.count; i++) {
+            value.push_back(numberAt<T>(r, i));
+        }
+    }
+}
+
+
+template<typename T>
+void PackedAttributesFS::set(const std::string &name, const T &value) {
+    typedef packed_traits<T> traits;
+    typename traits::storage_type v = static_cast<typename traits::storage_type>(value);
+    put(name, traits::type, false, 1, std::string(reinterpret_cast<const char *>(&v), sizeof(v)));
+}
+
+
+template<typename T>
+void PackedAttributesFS::set(const std::string &name, const std::vector<T> &value) {
+    typedef packed_traits<T> traits;
+    typedef typename traits::storage_type storage_type;
+    std::string payload(value.size() * sizeof(storage_type), '\0');
+    char *ptr = &payload[0];
+    for (const auto &x : value) {
+        storage_type v = static_cast<storage_type>(x);
+        std::memcpy(ptr, &v, sizeof(v));
+        ptr += sizeof(v);
+    }
+    put(name, traits::type, true, value.size(), std::move(payload));
+}
+
+} // namespace file
+} // namespace nix
+
+#endif //NIX_PACKED_ATTRIBUTES_FS_HPP
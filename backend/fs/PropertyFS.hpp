@@ -103,6 +103,12 @@ public:
     void values(const boost::none_t t);
 
 
+    void readValues(DataType dtype, void *data, ndsize_t count) const;
+
+
+    void writeValues(DataType dtype, const void *data, ndsize_t count);
+
+
     bool isValidEntity() const;
 
 
@@ -140,6 +140,7 @@ void SectionFS::link(const none_t t) {
     p /= "link";
     if (bfs::exists(p)) {
         bfs::remove_all(p);
+        childRemoved(p);
     }
     forceUpdatedAt();
 }
@@ -105,13 +105,14 @@ bool BaseTagHDF5::removeReference(const std::string &name_or_id) {
 
 
 void BaseTagHDF5::references(const std::vector<DataArray> &refs_new) {
-    while (referenceCount() > 0) {
-        removeReference(getReference(0)->id());
-    }
-
-    for (const auto &ref : refs_new) {
-        addReference(ref.id());
-    }
+    auto resolve = [this](const DataArray &ref) {
+        auto target = std::dynamic_pointer_cast<DataArrayHDF5>(block()->getEntity(ref));
+        if (!target)
+            throw std::runtime_error("BaseTagHDF5::references: DataArray not found in block!");
+        return boost::make_optional(target->group());
+    };
+
+    H5Group::replaceLinks<DataArray>(refs_group, refs_new, resolve);
 }
 
 //--------------------------------------------------
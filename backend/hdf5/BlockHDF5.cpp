@@ -16,9 +16,13 @@
 #include "TagHDF5.hpp"
 #include "MultiTagHDF5.hpp"
 #include "GroupHDF5.hpp"
+#include "CopierHDF5.hpp"
 
 #include <boost/range/irange.hpp>
 
+#include <algorithm>
+#include <unordered_set>
+
 using namespace std;
 using namespace nix::base;
 
@@ -249,6 +253,74 @@ bool BlockHDF5::removeEntity(const nix::Identity &ident) {
 }
 
 
+// add the addresses of all sources below the source in g
+static void collect_child_sources(const H5Group &g, std::unordered_set<haddr_t> &addresses) {
+    if (!g.hasGroup("sources")) {
+        return;
+    }
+
+    H5Group children = g.openGroup("sources", false);
+    for (const auto &name : children.objectNames()) {
+        H5Group child = children.openGroup(name, false);
+        if (addresses.insert(child.objectAddress()).second) {
+            collect_child_sources(child, addresses);
+        }
+    }
+}
+
+
+shared_ptr<IEntity> BlockHDF5::copyEntity(const shared_ptr<IEntity> &source, ObjectType type, const string &name) {
+    auto src = dynamic_pointer_cast<EntityHDF5>(source);
+    if (!src) {
+        throw std::runtime_error("BlockHDF5::copyEntity: the entity is not stored in a HDF5 file");
+    }
+
+    boost::optional<H5Group> p = groupForObjectType(type, true);
+    if (!p) {
+        throw std::invalid_argument("BlockHDF5::copyEntity: entities of this type are not part of a block");
+    }
+    CopierHDF5 copier(group(), group());
+    copier.copy(src->group(), *p, name);
+    return getEntity({name, type});
+}
+
+
+std::vector<std::string> BlockHDF5::removeEntities(const std::vector<nix::Identity> &idents) {
+    std::unordered_set<haddr_t> targets;
+    for (const auto &ident : idents) {
+        boost::optional<H5Group> eg = findEntityGroup(ident);
+        if (!eg) {
+            continue;
+        }
+
+        targets.insert(eg->objectAddress());
+        if (ident.type() == ObjectType::Source) {
+            collect_child_sources(*eg, targets);
+        }
+    }
+
+    if (targets.empty()) {
+        return std::vector<std::string>();
+    }
+
+    // all inbound links are inside the block, they are found in one walk
+    H5Group g = group();
+    std::vector<std::string> links = g.linksTo(targets);
+
+    // deepest first, so that the paths of the remaining links stay valid
+    auto depth = [](const std::string &path) { return std::count(path.begin(), path.end(), '/'); };
+    std::stable_sort(links.begin(), links.end(), [&depth](const std::string &a, const std::string &b) {
+        return depth(a) > depth(b);
+    });
+
+    for (const auto &link : links) {
+        g.deleteLink(link);
+    }
+
+    return links;
+}
+
+
 //--------------------------------------------------
 // Methods concerning sources
 //--------------------------------------------------
@@ -308,15 +380,20 @@ shared_ptr<IDataArray> BlockHDF5::createDataArray(const std::string &name,
                                                   const std::string &type,
                                                   nix::DataType data_type,
                                                   const NDSize &shape,
-                                                  const Compression &compression) {
+                                                  const Compression &compression,
+                                                  const DataStorage &storage) {
     string id = util::createId();
     boost::optional<H5Group> g = data_array_group(true);
 
     H5Group group = g->openGroup(name, true);
     auto da = make_shared<DataArrayHDF5>(file(), block(), group, id, type, name);
 
-    // now create the actual H5::DataSet
-    da->createData(data_type, shape, compression == Compression::Auto ? compr : compression);
+    // now create the actual H5::DataSet, contiguous data ignores the compression of the file
+    Compression c = compression == Compression::Auto ? compr : compression;
+    if (storage == DataStorage::Contiguous) {
+        c = Compression::None;
+    }
+    da->createData(data_type, shape, c, storage);
     return da;
 }
 
@@ -0,0 +1,255 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "CopierHDF5.hpp"
+
+#include <nix/util/util.hpp>
+#include "h5x/H5PList.hpp"
+#include "h5x/H5Stats.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+
+static herr_t collect_hard_link(hid_t, const char *name, const H5L_info_t *info, void *op_data) {
+    if (info->type == H5L_TYPE_HARD) {
+        static_cast<std::vector<std::string> *>(op_data)->emplace_back(name);
+    }
+    return 0;
+}
+
+
+static herr_t collect_attr_name(hid_t, const char *name, const H5A_info_t *, void *op_data) {
+    static_cast<std::vector<std::string> *>(op_data)->emplace_back(name);
+    return 0;
+}
+
+
+static H5O_info_t object_info(const H5Object &obj) {
+    H5Lock lock;
+    H5O_info_t info;
+    HErr res = H5Oget_info(obj.h5id(), &info);
+    res.check("CopierHDF5: Could not get object info");
+    return info;
+}
+
+
+// the container in a block or file the entity a link points to lives in,
+// from the name of the link or of the group that holds it
+static std::string container_of(const std::string &link, const std::string &parent) {
+    if (link == "metadata" || link == "link") {
+        return "metadata";
+    } else if (link == "data" || link == "positions" || link == "extents") {
+        return "data_arrays";
+    } else if (link == "data_frame" || parent == "data_frame") {
+        return "data_frames";
+    } else if (parent == "sources" || parent == "data_frames" || parent == "tags" || parent == "multi_tags") {
+        return parent;
+    }
+    // the references of tags, the members of groups and alias dimensions
+    return "data_arrays";
+}
+
+
+CopierHDF5::CopierHDF5(const H5Group &location, const boost::optional<H5Group> &block)
+    : dst_block(block) {
+    H5Lock lock;
+    dst_root = H5Group(H5Gopen2(location.h5id(), "/", H5P_DEFAULT));
+    dst_root.check("CopierHDF5: Could not open the root group of the destination");
+    dst_fileno = object_info(dst_root).fileno;
+}
+
+
+H5Group CopierHDF5::copy(const H5Group &source, const H5Group &parent, const std::string &name, bool block) {
+    H5Group dst = copyTree(source, parent, name, name);
+    dst.setAttr("name", name);
+    if (block) {
+        dst_block = dst;
+    }
+    resolve();
+    return dst;
+}
+
+
+std::vector<std::string> CopierHDF5::hardLinks(const H5Group &group) {
+    H5Lock lock;
+    NIX_STAT(LinkIterate);
+    H5Object gcpl = H5Gget_create_plist(group.h5id());
+    gcpl.check("CopierHDF5: Could not get the creation properties of a group");
+    unsigned flags = 0;
+    HErr res = H5Pget_link_creation_order(gcpl.h5id(), &flags);
+    res.check("CopierHDF5: Could not get the link creation order of a group");
+
+    const H5_index_t index = (flags & H5P_CRT_ORDER_INDEXED) ? H5_INDEX_CRT_ORDER : H5_INDEX_NAME;
+    std::vector<std::string> names;
+    res = H5Literate(group.h5id(), index, H5_ITER_INC, NULL, collect_hard_link, &names);
+    res.check("CopierHDF5: Could not iterate over the links of a group");
+    return names;
+}
+
+
+H5Group CopierHDF5::copyTree(const H5Group &source, H5Group parent, const std::string &name,
+                             const std::string &source_name) {
+    H5Lock lock;
+    // a fresh group, the creation properties of the source also carry its link count
+    H5Group dst = parent.openGroup(name, true);
+    copies.emplace(source.objectAddress(), dst);
+    copyAttributes(source, dst, true);
+
+    // entities named after their id, like features, follow the new id
+    std::string source_id, copy_id;
+    if (source.getAttr("entity_id", source_id) && source_id == name) {
+        dst.getAttr("entity_id", copy_id);
+        parent.renameGroup(name, copy_id);
+    }
+
+    // entities in a plain group named after them are owned, like the data
+    // arrays of a block; all other links to entities are references
+    const bool container = object_info(source).num_attrs == 0;
+
+    for (const std::string &link : hardLinks(source)) {
+        H5O_info_t info;
+        HErr res = H5Oget_info_by_name(source.h5id(), link.c_str(), &info, H5P_DEFAULT);
+        res.check("CopierHDF5: Could not get object info of " + link);
+
+        if (info.type == H5O_TYPE_DATASET) {
+            // the raw chunks are copied as they are stored
+            res = H5Ocopy(source.h5id(), link.c_str(), dst.h5id(), link.c_str(), H5P_DEFAULT,
+                          PList::linkUTF8().h5id());
+            res.check("CopierHDF5: Could not copy data set " + link);
+            DataSet ds = dst.openData(link);
+            if (ds.hasAttr("entity_id")) {
+                ds.setAttr("entity_id", util::createId());
+            }
+        } else if (info.type == H5O_TYPE_GROUP) {
+            H5Group child = source.openGroup(link, false);
+            std::string child_name;
+            const bool entity = child.hasAttr("entity_id");
+            const bool owned = container && (source_name == "features" ||
+                                             (child.getAttr("name", child_name) && child_name == link));
+
+            auto it = copies.find(info.addr);
+            if (entity && !owned) {
+                pending.push_back({dst, link, child, container_of(link, source_name)});
+            } else if (it != copies.end()) {
+                dst.createLink(it->second, link);
+            } else {
+                copyTree(child, dst, link, link);
+            }
+        }
+    }
+
+    return dst;
+}
+
+
+void CopierHDF5::copyAttributes(const LocID &source, const LocID &target, bool new_ids) {
+    H5Lock lock;
+    std::vector<std::string> names;
+    hsize_t idx = 0;
+    HErr res = H5Aiterate2(source.h5id(), H5_INDEX_NAME, H5_ITER_INC, &idx, collect_attr_name, &names);
+    res.check("CopierHDF5: Could not iterate over the attributes of a group");
+
+    PList acpl = PList::create(H5P_ATTRIBUTE_CREATE);
+    acpl.charEncoding(H5T_CSET_UTF8);
+
+    for (const std::string &name : names) {
+        if (new_ids && name == "entity_id") {
+            target.setAttr(name, util::createId());
+            continue;
+        }
+
+        Attribute attr = source.openAttr(name);
+        H5Object type = H5Aget_type(attr.h5id());
+        H5Object space = H5Aget_space(attr.h5id());
+        H5Object mem_type = H5Tget_native_type(type.h5id(), H5T_DIR_DEFAULT);
+        mem_type.check("CopierHDF5: Could not get the type of attribute " + name);
+
+        const hssize_t n = H5Sget_simple_extent_npoints(space.h5id());
+        std::vector<char> buffer(std::max<size_t>(static_cast<size_t>(n), 1) * H5Tget_size(mem_type.h5id()));
+
+        {
+            NIX_STAT(AttrRead);
+            res = H5Aread(attr.h5id(), mem_type.h5id(), buffer.data());
+        }
+        res.check("CopierHDF5: Could not read attribute " + name);
+
+        H5Object copy;
+        {
+            NIX_STAT(AttrCreate);
+            copy = H5Acreate2(target.h5id(), name.c_str(), type.h5id(), space.h5id(), acpl.h5id(), H5P_DEFAULT);
+        }
+        copy.check("CopierHDF5: Could not create attribute " + name);
+        res = H5Awrite(copy.h5id(), mem_type.h5id(), buffer.data());
+
+        if (H5Tdetect_class(mem_type.h5id(), H5T_VLEN) > 0 || H5Tis_variable_str(mem_type.h5id()) > 0) {
+            H5Dvlen_reclaim(mem_type.h5id(), space.h5id(), H5P_DEFAULT, buffer.data());
+        }
+        res.check("CopierHDF5: Could not write attribute " + name);
+    }
+}
+
+
+boost::optional<H5Group> CopierHDF5::resolveTarget(const Pending &link) {
+    auto it = copies.find(link.target.objectAddress());
+    if (it != copies.end()) {
+        return it->second;
+    }
+
+    std::string name;
+    link.target.getAttr("name", name);
+
+    if (link.container == "metadata") {
+        if (object_info(link.target).fileno == dst_fileno) {
+            return link.target;
+        }
+        H5Group metadata = dst_root.openGroup("metadata", true);
+        if (metadata.hasGroup(name)) {
+            return metadata.openGroup(name, false);
+        }
+        return copyTree(link.target, metadata, name, name);
+    }
+
+    if (!dst_block) {
+        return boost::none;
+    }
+    H5Group container = dst_block->openGroup(link.container, true);
+    if (container.hasGroup(name)) {
+        return container.openGroup(name, false);
+    }
+    return copyTree(link.target, container, name, name);
+}
+
+
+void CopierHDF5::resolve() {
+    while (!pending.empty()) {
+        Pending link = pending.front();
+        pending.pop_front();
+
+        boost::optional<H5Group> target = resolveTarget(link);
+        if (!target) {
+            continue;
+        }
+
+        // links named after the id of their target follow the new id
+        std::string name = link.name;
+        std::string source_id;
+        if (link.target.getAttr("entity_id", source_id) && source_id == name) {
+            target->getAttr("entity_id", name);
+        }
+        if (!link.parent.hasObject(name)) {
+            link.parent.createLink(*target, name);
+        }
+    }
+}
+
+} // namespace hdf5
+} // namespace nix
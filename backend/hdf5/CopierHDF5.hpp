@@ -0,0 +1,102 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_COPIER_HDF5_H
+#define NIX_COPIER_HDF5_H
+
+#include "h5x/H5Group.hpp"
+
+#include <boost/optional.hpp>
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+
+/**
+ * Copies entities with everything they own, within a file or from one file
+ * into another.
+ *
+ * Groups are recreated with their attributes while data sets, including
+ * the data of data arrays, are copied with H5Ocopy: the chunks are copied
+ * as they are stored, without decompressing them, and never all at once.
+ * Every copied entity and property gets a new id.
+ *
+ * Links to entities that are not owned by the copied entity, e.g. its
+ * metadata, sources or the references of a tag, are resolved after the
+ * owned tree is copied:
+ *  - entities copied in the same run are linked to their copies;
+ *  - sections are linked as they are within the same file, from another
+ *    file the top level section of the same name is used or the section
+ *    is copied there;
+ *  - entities of a block are looked up by name in the destination block
+ *    and copied into it if they are not there.
+ */
+class CopierHDF5 {
+
+public:
+
+    /**
+     * @param location  A group in the destination file.
+     * @param block     The group of the destination block, none if the copy
+     *                  does not go into a block.
+     */
+    CopierHDF5(const H5Group &location, const boost::optional<H5Group> &block);
+
+    /**
+     * Copy the entity source as parent/name and set its name to name.
+     *
+     * @param block  Whether source is a block: the copy becomes the
+     *               destination block the links are resolved in.
+     *
+     * @return The group of the copy.
+     */
+    H5Group copy(const H5Group &source, const H5Group &parent, const std::string &name, bool block = false);
+
+    /**
+     * The names of the hard links of a group, in the order they were
+     * created if the group tracks it.
+     */
+    static std::vector<std::string> hardLinks(const H5Group &group);
+
+    /**
+     * Copy all attributes of source to target.
+     *
+     * @param new_ids  Whether an entity_id attribute gets a new id.
+     */
+    static void copyAttributes(const LocID &source, const LocID &target, bool new_ids);
+
+private:
+
+    struct Pending {
+        H5Group     parent;     // the group in the copy the link goes into
+        std::string name;       // the name of the link in the source
+        H5Group     target;     // the linked entity in the source
+        std::string container;  // where the target lives, "metadata" for sections
+    };
+
+    H5Group copyTree(const H5Group &source, H5Group parent, const std::string &name,
+                     const std::string &source_name);
+    void resolve();
+    boost::optional<H5Group> resolveTarget(const Pending &link);
+
+    H5Group                                dst_root;
+    boost::optional<H5Group>               dst_block;
+    unsigned long                          dst_fileno;
+    std::unordered_map<haddr_t, H5Group>   copies;
+    std::deque<Pending>                    pending;
+};
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_COPIER_HDF5_H
@@ -11,6 +11,11 @@
 #include "DataArrayHDF5.hpp"
 #include "h5x/H5DataSet.hpp"
 #include "DimensionHDF5.hpp"
+#include "StatisticsHDF5.hpp"
+#include "PyramidHDF5.hpp"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
 using namespace std;
 using namespace nix::base;
@@ -247,6 +252,17 @@ bool DataArrayHDF5::deleteDimensions() {
 }
 
 
+void DataArrayHDF5::outdatePyramid() {
+    // SWMR forbids removing objects from the file
+    PyramidHDF5 pyramid(group());
+    if (file()->fileMode() == FileMode::SwmrWrite) {
+        pyramid.markStale();
+    } else {
+        pyramid.remove();
+    }
+}
+
+
 //--------------------------------------------------
 // Other methods and functions
 //--------------------------------------------------
@@ -255,13 +271,18 @@ bool DataArrayHDF5::deleteDimensions() {
 DataArrayHDF5::~DataArrayHDF5() {
 }
 
-void DataArrayHDF5::createData(DataType dtype, const NDSize &size, const Compression &compression) {
+void DataArrayHDF5::createData(DataType dtype, const NDSize &size, const Compression &compression,
+                               const DataStorage &storage) {
     if (group().hasData("data")) {
         throw ConsistencyError("DataArray's hdf5 data group already exists!");
     }
 
     h5x::DataType fileType = data_type_to_h5_filetype(dtype);
-    group().createData("data", fileType, size, compression);
+    if (storage == DataStorage::Contiguous) {
+        group().createContiguousData("data", fileType, size);
+    } else {
+        group().createData("data", fileType, size, compression);
+    }
 }
 
 bool DataArrayHDF5::hasData() const {
@@ -286,9 +307,25 @@ void DataArrayHDF5::write(DataType dtype, const void *data, const NDSize &count,
     } else {
         ds.write(data, memType, memSpace, fileSpace);
     }
+
+    StatisticsHDF5 stats(group());
+    if (stats.exists()) {
+        stats.update(dtype, data, count, offset);
+    }
+    outdatePyramid();
+
+    // let SWMR readers see the data right away
+    if (file()->fileMode() == FileMode::SwmrWrite) {
+        ds.flush();
+    }
 }
 
 void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    read(dtype, data, count, offset, {}, {});
+}
+
+void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset,
+                         const NDSize &stride, const NDSize &block) const {
     if (!group().hasData("data")) {
         throw ConsistencyError("DataArray with missing h5df DataSet");
     }
@@ -296,10 +333,10 @@ void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const
     DataSet ds = group().openData("data");
     h5x::DataType memType = data_type_to_h5_memtype(dtype);
     DataSpace fileSpace, memSpace;
-    std::tie(memSpace, fileSpace) = ds.offsetCount2DataSpaces(count, offset);
+    std::tie(memSpace, fileSpace) = ds.offsetCount2DataSpaces(count, offset, stride, block);
 
     if (dtype == DataType::String) {
-        StringWriter writer(count, data);
+        StringWriter writer(block ? count * block : count, data);
         ds.read(*writer, memType, memSpace, fileSpace);
         writer.finish();
         ds.vlenReclaim(memType.h5id(), *writer, &memSpace);
@@ -308,6 +345,155 @@ void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const
     }
 }
 
+MappedData DataArrayHDF5::mappedData() const {
+    H5Lock lock;
+    if (!group().hasData("data")) {
+        throw ConsistencyError("DataArray with missing h5df DataSet");
+    }
+
+    DataSet ds = group().openData("data");
+    H5Object dcpl = H5Dget_create_plist(ds.h5id());
+    dcpl.check("DataArrayHDF5::mappedData(): Could not get data set creation plist");
+
+    if (H5Pget_layout(dcpl.h5id()) != H5D_CONTIGUOUS || H5Pget_nfilters(dcpl.h5id()) != 0 ||
+        H5Pget_external_count(dcpl.h5id()) != 0) {
+        throw std::runtime_error("DataArray data is not stored contiguously, cannot map it!");
+    }
+
+    const h5x::DataType fileType = ds.dataType();
+    const DataType dtype = data_type_from_h5(fileType);
+    if (dtype == DataType::String || dtype == DataType::Nothing ||
+        H5Tequal(fileType.h5id(), data_type_to_h5_memtype(dtype).h5id()) <= 0) {
+        throw std::runtime_error("DataArray data is not stored in native representation, cannot map it!");
+    }
+
+    const NDSize extent = ds.size();
+    const size_t nbytes = static_cast<size_t>(extent.nelms()) * data_type_to_size(dtype);
+    const shared_ptr<IFile> f = file();
+
+    if (nbytes == 0) {
+        return MappedData(nullptr, f, nullptr, dtype, extent);
+    }
+
+    const haddr_t offset = H5Dget_offset(ds.h5id());
+    if (offset == HADDR_UNDEF) {
+        throw std::runtime_error("DataArray data has no storage allocated, cannot map it!");
+    }
+
+    H5Object fid = H5Iget_file_id(ds.h5id());
+    fid.check("DataArrayHDF5::mappedData(): Could not get file id");
+    H5Object fapl = H5Fget_access_plist(fid.h5id());
+    fapl.check("DataArrayHDF5::mappedData(): Could not get file access plist");
+    if (H5Pget_driver(fapl.h5id()) == H5FD_CORE) {
+        throw std::runtime_error("DataArray data is kept in memory, cannot map it!");
+    }
+
+    // make sure whatever HDF5 still has buffered for the data is on disk
+    if (f->fileMode() != FileMode::ReadOnly && f->fileMode() != FileMode::SwmrRead) {
+        f->flush();
+    }
+
+    namespace bip = boost::interprocess;
+    shared_ptr<bip::mapped_region> region;
+    try {
+        bip::file_mapping mapping(f->location().c_str(), bip::read_only);
+        region = make_shared<bip::mapped_region>(mapping, bip::read_only,
+                                                 static_cast<bip::offset_t>(offset), nbytes);
+    } catch (const bip::interprocess_exception &e) {
+        throw std::runtime_error(string("Could not map DataArray data: ") + e.what());
+    }
+
+    return MappedData(region, f, region->get_address(), dtype, extent);
+}
+
+NDSize DataArrayHDF5::dataChunks() const {
+    H5Lock lock;
+    if (!group().hasData("data")) {
+        return NDSize{};
+    }
+
+    DataSet ds = group().openData("data");
+    H5Object dcpl = H5Dget_create_plist(ds.h5id());
+    dcpl.check("DataArrayHDF5::dataChunks(): Could not get data set creation plist");
+
+    if (H5Pget_layout(dcpl.h5id()) != H5D_CHUNKED) {
+        return NDSize{};
+    }
+
+    NDSize chunks(ds.size().size(), 0);
+    HErr res = H5Pget_chunk(dcpl.h5id(), static_cast<int>(chunks.size()), chunks.data());
+    res.check("DataArrayHDF5::dataChunks(): Could not get chunk size");
+    return chunks;
+}
+
+void DataArrayHDF5::createStatistics() {
+    if (!group().hasData("data")) {
+        throw ConsistencyError("DataArray with missing h5df DataSet");
+    }
+
+    // the statistics are kept per chunk, contiguous data gets the chunks it would have
+    NDSize block = dataChunks();
+    if (!block) {
+        DataSet ds = group().openData("data");
+        block = DataSet::guessChunking(ds.size(), ds.dataType().size());
+    }
+    StatisticsHDF5(group()).create(block);
+}
+
+bool DataArrayHDF5::hasStatistics() const {
+    return StatisticsHDF5(group()).exists();
+}
+
+bool DataArrayHDF5::deleteStatistics() {
+    if (file()->fileMode() == FileMode::SwmrWrite) {
+        throw UnsupportedOperation("Removing the statistics in FileMode::SwmrWrite", "HDF5");
+    }
+    return StatisticsHDF5(group()).remove();
+}
+
+DataStatistics DataArrayHDF5::statistics(const NDSize &offset, const NDSize &count) const {
+    if (!group().hasData("data")) {
+        throw ConsistencyError("DataArray with missing h5df DataSet");
+    }
+    return StatisticsHDF5(group()).query(offset, count);
+}
+
+void DataArrayHDF5::createPyramid(const PyramidOptions &options) {
+    if (!group().hasData("data")) {
+        throw ConsistencyError("DataArray with missing h5df DataSet");
+    }
+    PyramidHDF5(group()).create(options);
+}
+
+bool DataArrayHDF5::hasPyramid() const {
+    return PyramidHDF5(group()).exists();
+}
+
+bool DataArrayHDF5::deletePyramid() {
+    if (file()->fileMode() == FileMode::SwmrWrite) {
+        throw UnsupportedOperation("Removing the pyramid in FileMode::SwmrWrite", "HDF5");
+    }
+    return PyramidHDF5(group()).remove();
+}
+
+std::vector<ndsize_t> DataArrayHDF5::pyramidFactors() const {
+    return PyramidHDF5(group()).factors();
+}
+
+void DataArrayHDF5::readPyramid(ndsize_t factor, ndsize_t offset, ndsize_t count,
+                                std::vector<double> &min, std::vector<double> &max) const {
+    PyramidHDF5(group()).read(factor, offset, count, min, max);
+}
+
+void DataArrayHDF5::refresh() {
+    if (!group().hasData("data")) {
+        return;
+    }
+
+    DataSet ds = group().openData("data");
+    ds.refresh();
+}
+
 NDSize DataArrayHDF5::dataExtent(void) const {
     if (!group().hasData("data")) {
         return NDSize{};
@@ -323,7 +509,10 @@ void DataArrayHDF5::dataExtent(const NDSize &extent) {
     }
 
     DataSet ds = group().openData("data");
+    const NDSize old_extent = ds.size();
     ds.setExtent(extent);
+    StatisticsHDF5(group()).resize(old_extent, extent);
+    outdatePyramid();
 }
 
 DataType DataArrayHDF5::dataType(void) const {
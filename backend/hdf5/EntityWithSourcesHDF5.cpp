@@ -84,14 +84,13 @@ std::shared_ptr<ISource> EntityWithSourcesHDF5::getSource(const size_t index) co
 }
 
 void EntityWithSourcesHDF5::sources(const std::vector<Source> &sources) {
-    while (sourceCount() > 0) {
-        removeSource(getSource(0)->id());
-    }
-    for (const auto &src : sources) {
-        if (block()->hasEntity(src) ) {
-            addSource(src.id());
-        }
-    }
+    // sources that are not part of the block are skipped
+    auto resolve = [this](const Source &src) {
+        auto target = std::dynamic_pointer_cast<SourceHDF5>(block()->getEntity(src));
+        return target ? boost::make_optional(target->group()) : boost::optional<H5Group>();
+    };
+
+    H5Group::replaceLinks<Source>(sources_refs, sources, resolve);
 }
 
 void EntityWithSourcesHDF5::addSource(const std::string &id) {
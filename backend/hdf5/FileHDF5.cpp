@@ -11,9 +11,12 @@
 #include <nix/util/util.hpp>
 #include "BlockHDF5.hpp"
 #include "SectionHDF5.hpp"
+#include "CopierHDF5.hpp"
+#include "RepackerHDF5.hpp"
 #include "h5x/H5Exception.hpp"
 
 
+#include <algorithm>
 #include <fstream>
 #include <vector>
 #include <ctime>
@@ -36,39 +39,102 @@ static unsigned int map_file_mode(FileMode mode) {
         case FileMode::Overwrite:
             return H5F_ACC_TRUNC;
 
+        case FileMode::SwmrRead:
+            return H5F_ACC_RDONLY | H5F_ACC_SWMR_READ;
+
+        case FileMode::SwmrWrite:
+            return H5F_ACC_RDWR;
+
         default:
             return H5F_ACC_DEFAULT;
     }
 }
 
 
+static const size_t core_increment = 1024 * 1024;
+
 FileHDF5::FileHDF5(const string &name, FileMode mode, Compression compression, OpenFlags flags):
     file_format_version(HDF5_FF_VERSION) {
-    if (!fileExists(name)) {
+    H5Lock lock;
+    if (!fileExists(name) && mode != FileMode::SwmrWrite) {
         mode = FileMode::Overwrite;
     }
+
+    H5Object fapl = H5Pcreate(H5P_FILE_ACCESS);
+    fapl.check("Could not create file access plist");
+    HErr res;
+
+    const bool backing_store = (flags & OpenFlags::BackingStore) == OpenFlags::BackingStore;
+    if (backing_store || (flags & OpenFlags::InMemory) == OpenFlags::InMemory) {
+        res = H5Pset_fapl_core(fapl.h5id(), core_increment, backing_store);
+        res.check("Unable to open file (H5Pset_fapl_core failed.)");
+    }
+
+    //SWMR needs the file and all objects in it to use the 1.10 file format
+    if (mode == FileMode::SwmrRead || mode == FileMode::SwmrWrite) {
+        res = H5Pset_libver_bounds(fapl.h5id(), H5F_LIBVER_LATEST, H5F_LIBVER_LATEST);
+        res.check("Unable to open file (H5Pset_libver_bounds failed.)");
+    }
+
+    bool is_create = !fileExists(name) || mode == FileMode::Overwrite;
+    open(name, mode, compression, flags, fapl, is_create);
+}
+
+
+FileHDF5::FileHDF5(const void *image, size_t size, FileMode mode, Compression compression):
+    file_format_version(HDF5_FF_VERSION) {
+    H5Lock lock;
+    if (mode != FileMode::ReadOnly && mode != FileMode::ReadWrite) {
+        throw std::runtime_error("FileHDF5: File images can only be opened ReadOnly or ReadWrite!");
+    }
+
+    H5Object fapl = H5Pcreate(H5P_FILE_ACCESS);
+    fapl.check("Could not create file access plist");
+    HErr res = H5Pset_fapl_core(fapl.h5id(), core_increment, false);
+    res.check("Unable to open file image (H5Pset_fapl_core failed.)");
+    res = H5Pset_file_image(fapl.h5id(), const_cast<void *>(image), size);
+    res.check("Unable to open file image (H5Pset_file_image failed.)");
+
+    //files in memory are told apart by their name
+    open("nix-image-" + util::createId(), mode, compression, OpenFlags::None, fapl, false);
+}
+
+
+void FileHDF5::open(const string &name, FileMode mode, Compression compression, OpenFlags flags,
+                    const H5Object &fapl, bool is_create) {
     this->mode = mode;
     this->compr = compression;
-    //we want hdf5 to keep track of the order in which links were created so that
-    //the order for indexed based accessors is stable cf. issue #387
-    H5Object fcpl = H5Pcreate(H5P_FILE_CREATE);
-    fcpl.check("Could not create file creation plist");
-    HErr res = H5Pset_link_creation_order(fcpl.h5id(), H5P_CRT_ORDER_TRACKED|H5P_CRT_ORDER_INDEXED);
-    res.check("Unable to create file (H5Pset_link_creation_order failed.)");
-    unsigned int h5mode =  map_file_mode(mode);
-
-    bool is_create = !fileExists(name) || h5mode == H5F_ACC_TRUNC;
 
     if (is_create) {
-        hid = H5Fcreate(name.c_str(), h5mode, fcpl.h5id(), H5P_DEFAULT);
+        //we want hdf5 to keep track of the order in which links were created so that
+        //the order for indexed based accessors is stable cf. issue #387
+        H5Object fcpl = H5Pcreate(H5P_FILE_CREATE);
+        fcpl.check("Could not create file creation plist");
+        HErr res = H5Pset_link_creation_order(fcpl.h5id(), H5P_CRT_ORDER_TRACKED|H5P_CRT_ORDER_INDEXED);
+        res.check("Unable to create file (H5Pset_link_creation_order failed.)");
+
+        hid = H5Fcreate(name.c_str(), H5F_ACC_TRUNC, fcpl.h5id(), fapl.h5id());
     } else {
-        hid = H5Fopen(name.c_str(), h5mode, H5P_DEFAULT);
+        hid = H5Fopen(name.c_str(), map_file_mode(mode), fapl.h5id());
     }
 
+    const bool swmr = mode == FileMode::SwmrRead || mode == FileMode::SwmrWrite;
     if (!H5Iis_valid(hid)) {
+        if (swmr) {
+            throw H5Exception("Could not open file for SWMR access");
+        }
         throw H5Exception("Could not open/create file");
     }
 
+    if (mode == FileMode::SwmrWrite && !is_create) {
+        H5F_info2_t info;
+        HErr res = H5Fget_info2(hid, &info);
+        res.check("Unable to open file (H5Fget_info2 failed.)");
+        if (info.super.version < 3) {
+            throw H5Exception("Could not open file for SWMR access (not created in SwmrWrite mode?)");
+        }
+    }
+
     openRoot();
     if (is_create) {
         createHeader();
@@ -79,16 +145,138 @@ FileHDF5::FileHDF5(const string &name, FileMode mode, Compression compression, O
     metadata = root.openGroup("metadata");
     data = root.openGroup("data");
 
-    setCreatedAt();
-    setUpdatedAt();
+    if (mode != FileMode::SwmrRead) {
+        setCreatedAt();
+        setUpdatedAt();
+    }
+}
+
+
+FileHeader FileHDF5::probe(const string &name) {
+    FileHeader header;
+    header.location = name;
+    header.valid = false;
+    header.created_at = 0;
+    header.updated_at = 0;
+
+    H5Lock lock;
+    hid_t fid;
+    // probing is expected to fail for some files, keep HDF5 quiet about it
+    H5E_BEGIN_TRY {
+        fid = H5Fopen(name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    } H5E_END_TRY;
+
+    if (fid < 0) {
+        header.error = "Could not open file";
+        return header;
+    }
+
+    H5Object file(fid);
+    H5Group root(H5Gopen2(fid, "/", H5P_DEFAULT));
+    if (!root.isValid()) {
+        header.error = "Could not open root group";
+        return header;
+    }
+
+    try {
+        string created, updated;
+        root.getAttr("format", header.format);
+        root.getAttr("version", header.version);
+        root.getAttr("id", header.id);
+        if (root.getAttr("created_at", created)) {
+            header.created_at = util::strToTime(created);
+        }
+        if (root.getAttr("updated_at", updated)) {
+            header.updated_at = util::strToTime(updated);
+        }
+    } catch (const std::exception &e) {
+        header.error = e.what();
+        return header;
+    }
+
+    if (header.format != FILE_FORMAT) {
+        header.error = "File is not a valid NIX file, format mismatch!";
+    } else if (header.version.size() != 3) {
+        header.error = "File is not a valid NIX file, version attribute missing!";
+    } else if (!my_version.canRead(FormatVersion(header.version))) {
+        header.error = "Cannot open file for Read access, format mismatch!";
+    } else {
+        header.valid = true;
+    }
+
+    return header;
+}
+
+
+RepackReport FileHDF5::repack(const string &source, const string &destination, const RepackOptions &options) {
+    RepackerHDF5 repacker(options);
+    return repacker.repack(source, destination);
 }
 
 
 bool FileHDF5::flush() {
+    H5Lock lock;
     HErr err = H5Fflush(hid, H5F_SCOPE_GLOBAL);
     return !err.isError();
 }
 
+
+vector<char> FileHDF5::toImage() {
+    H5Lock lock;
+    HErr err = H5Fflush(hid, H5F_SCOPE_GLOBAL);
+    err.check("FileHDF5::toImage(): Could not flush the file");
+
+    ssize_t size = H5Fget_file_image(hid, nullptr, 0);
+    if (size < 0) {
+        throw H5Exception("FileHDF5::toImage(): Could not get the size of the file image");
+    }
+
+    vector<char> image(static_cast<size_t>(size));
+    size = H5Fget_file_image(hid, image.data(), image.size());
+    if (size < 0) {
+        throw H5Exception("FileHDF5::toImage(): Could not get the file image");
+    }
+    return image;
+}
+
+
+void FileHDF5::startSwmrWrite() {
+    H5Lock lock;
+    if (mode != FileMode::SwmrWrite) {
+        throw std::runtime_error("FileHDF5::startSwmrWrite(): File was not opened in SwmrWrite mode!");
+    }
+
+    // HDF5 closes and reopens all open objects under their id, which only
+    // works if nothing else holds a reference to the ids; our handles share
+    // ids via H5Iinc_ref, so hand back the extra references meanwhile
+    const unsigned types = H5F_OBJ_GROUP|H5F_OBJ_DATASET|H5F_OBJ_DATATYPE|H5F_OBJ_LOCAL;
+    ssize_t count = H5Fget_obj_count(hid, types);
+    if (count < 0) {
+        throw H5Exception("FileHDF5::startSwmrWrite(): Could not get object count");
+    }
+    vector<hid_t> ids(static_cast<size_t>(count));
+    vector<int> refs(ids.size(), 0);
+    if (count > 0) {
+        count = H5Fget_obj_ids(hid, types, ids.size(), ids.data());
+        ids.resize(static_cast<size_t>(std::max<ssize_t>(count, 0)));
+    }
+    for (size_t i = 0; i < ids.size(); i++) {
+        refs[i] = H5Iget_ref(ids[i]);
+        for (int r = 1; r < refs[i]; r++) {
+            H5Idec_ref(ids[i]);
+        }
+    }
+
+    HErr err = H5Fstart_swmr_write(hid);
+
+    for (size_t i = 0; i < ids.size(); i++) {
+        for (int r = 1; r < refs[i]; r++) {
+            H5Iinc_ref(ids[i]);
+        }
+    }
+    err.check("FileHDF5::startSwmrWrite(): Could not start SWMR write access");
+}
+
 //--------------------------------------------------
 // Methods concerning blocks
 //--------------------------------------------------
@@ -135,6 +323,18 @@ bool FileHDF5::deleteBlock(const std::string &name_or_id) {
 }
 
 
+shared_ptr<base::IBlock> FileHDF5::copyBlock(const shared_ptr<base::IBlock> &source, const string &name) {
+    auto src = dynamic_pointer_cast<BlockHDF5>(source);
+    if (!src) {
+        throw std::runtime_error("FileHDF5::copyBlock: the block is not stored in a HDF5 file");
+    }
+
+    CopierHDF5 copier(data, boost::none);
+    H5Group group = copier.copy(src->group(), data, name, true);
+    return make_shared<BlockHDF5>(file(), group);
+}
+
+
 ndsize_t FileHDF5::blockCount() const {
     return data.objectCount();
 }
@@ -194,6 +394,18 @@ bool FileHDF5::deleteSection(const std::string &name_or_id) {
 }
 
 
+shared_ptr<base::ISection> FileHDF5::copySection(const shared_ptr<base::ISection> &source, const string &name) {
+    auto src = dynamic_pointer_cast<SectionHDF5>(source);
+    if (!src) {
+        throw std::runtime_error("FileHDF5::copySection: the section is not stored in a HDF5 file");
+    }
+
+    CopierHDF5 copier(metadata, boost::none);
+    H5Group group = copier.copy(src->group(), metadata, name);
+    return make_shared<SectionHDF5>(file(), group);
+}
+
+
 ndsize_t FileHDF5::sectionCount() const {
     return metadata.objectCount();
 }
@@ -258,6 +470,7 @@ string FileHDF5::format() const {
 
 
 string FileHDF5::location() const {
+    H5Lock lock;
     ssize_t size = H5Fget_name(hid, nullptr, 0);
 
     if (size < 0) {
@@ -288,6 +501,7 @@ void FileHDF5::forceId() {
 
 
 void FileHDF5::close() {
+    H5Lock lock;
     if (!isOpen())
         return;
 
@@ -366,7 +580,7 @@ bool FileHDF5::checkHeader(FileMode mode, bool throw_error) {
             message << "File is not a valid NIX file, could not read version attribute!";
         } else {
             file_format_version = FormatVersion(vv);
-            if (mode == FileMode::ReadWrite) {
+            if (mode == FileMode::ReadWrite || mode == FileMode::SwmrWrite) {
                 check = my_version.canWrite(file_format_version);
                 if (!check) {
                     message << "Cannot open file for ReadWrite access, format mismatch! ";
@@ -411,6 +625,7 @@ void FileHDF5::createHeader() {
 }
 
 void FileHDF5::openRoot() {
+    H5Lock lock;
     root = H5Group(H5Gopen2(hid, "/", H5P_DEFAULT));
     root.check("Could not open root group");
 }
@@ -10,6 +10,7 @@
 #define NIX_FILE_HDF5_H
 
 #include <nix/base/IFile.hpp>
+#include <nix/File.hpp>
 #include <nix/Version.hpp>
 
 #include "h5x/H5Group.hpp"
@@ -42,10 +43,19 @@ public:
      *
      * @param name    The name of the file to open.
      * @param prefix  The prefix used for IDs.
-     * @param mode    File open mode ReadOnly, ReadWrite or Overwrite.
+     * @param mode    File open mode ReadOnly, ReadWrite, Overwrite, SwmrRead or SwmrWrite.
      */
     FileHDF5(const std::string &name, const FileMode mode = FileMode::ReadWrite, const Compression compression = Compression::Auto, OpenFlags flags = OpenFlags::None);
 
+    /**
+     * Constructor that is used to open a file from an image in memory.
+     *
+     * @param image   The image of the file, it is copied.
+     * @param size    The size of the image in bytes.
+     * @param mode    File open mode ReadOnly or ReadWrite.
+     */
+    FileHDF5(const void *image, size_t size, const FileMode mode = FileMode::ReadOnly, const Compression compression = Compression::Auto);
+
     //--------------------------------------------------
     // Methods concerning blocks
     //--------------------------------------------------
@@ -53,6 +63,12 @@ public:
     bool flush();
 
 
+    void startSwmrWrite();
+
+
+    std::vector<char> toImage();
+
+
     ndsize_t blockCount() const;
 
 
@@ -70,6 +86,9 @@ public:
 
     bool deleteBlock(const std::string &name_or_id);
 
+
+    std::shared_ptr<base::IBlock> copyBlock(const std::shared_ptr<base::IBlock> &source, const std::string &name);
+
     //--------------------------------------------------
     // Methods concerning sections
     //--------------------------------------------------
@@ -89,6 +108,10 @@ public:
     std::shared_ptr<base::ISection> createSection(const std::string &name, const std::string &type);
 
 
+    std::shared_ptr<base::ISection> copySection(const std::shared_ptr<base::ISection> &source,
+                                                const std::string &name);
+
+
     bool deleteSection(const std::string &name_or_id);
 
     //--------------------------------------------------
@@ -145,6 +168,18 @@ public:
 
     bool operator!=(const FileHDF5 &other) const;
 
+    /**
+     * Read the attributes of the root of a file without opening it as a
+     * FileHDF5, see File::probe.
+     */
+    static FileHeader probe(const std::string &name);
+
+    /**
+     * Rewrite a file into a new one, see File::repack.
+     */
+    static RepackReport repack(const std::string &source, const std::string &destination,
+                               const RepackOptions &options);
+
 
     virtual ~FileHDF5();
 
@@ -159,6 +194,10 @@ private:
     void openRoot();
 
 
+    void open(const std::string &name, FileMode mode, Compression compression, OpenFlags flags,
+              const H5Object &fapl, bool is_create);
+
+
     bool checkHeader(FileMode mode, bool throw_error);
 
 
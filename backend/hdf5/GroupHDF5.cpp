@@ -199,5 +199,19 @@ void GroupHDF5::addEntity(const nix::Identity &ident) {
     p->createLink(target->group(), target->id());
 }
 
+
+void GroupHDF5::entities(ObjectType type, const std::vector<nix::Identity> &idents) {
+    auto group = [this, type](bool create) { return groupForObjectType(type, create); };
+    auto resolve = [this, type](const nix::Identity &ident) {
+        auto target = std::dynamic_pointer_cast<EntityHDF5>(block()->getEntity({ident.name(), ident.id(), type}));
+        if (!target) {
+            throw std::runtime_error("Entity does not exist in this block!");
+        }
+        return boost::make_optional(target->group());
+    };
+
+    H5Group::replaceLinks<nix::Identity>(group, idents, resolve);
+}
+
 } // hdf5
 } // nix
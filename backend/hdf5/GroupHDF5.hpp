@@ -45,6 +45,9 @@ public:
     bool removeEntity(const nix::Identity &ident);
 
     void addEntity(const nix::Identity &ident);
+
+    void entities(ObjectType type, const std::vector<nix::Identity> &idents);
+
     /**
      * Standard constructor for existing Group
      */
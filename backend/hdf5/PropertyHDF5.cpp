@@ -507,6 +507,69 @@ void PropertyHDF5::values(const nix::none_t t) {
 }
 
 
+void PropertyHDF5::readValues(DataType dtype, void *data, ndsize_t count) const {
+    DataSet dset = dataset();
+    DataType file_dtype = data_type_from_h5(dset.dataType());
+
+    if ((dtype == DataType::String) != (file_dtype == DataType::String)) {
+        throw std::invalid_argument("Inconsistent DataTypes!");
+    }
+
+    if (count > valueCount()) {
+        throw OutOfBounds("Trying to read more values than the property has!");
+    }
+
+    if (count < 1) {
+        return;
+    }
+
+    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+
+    nix::FormatVersion ver(this->entity_file->version());
+    if (ver < nix::FormatVersion({1, 1, 1})) {
+        // old style values are compounds, only read the value member
+        h5x::DataType value_type = memType;
+        memType = h5x::DataType::makeCompound(value_type.size());
+        memType.insert("value", 0, value_type);
+    }
+
+    DataSpace fileSpace, memSpace;
+    std::tie(memSpace, fileSpace) = dset.offsetCount2DataSpaces(NDSize{count}, NDSize{0});
+
+    if (dtype == DataType::String) {
+        StringWriter writer(NDSize{count}, data);
+        dset.read(*writer, memType, memSpace, fileSpace);
+        writer.finish();
+        dset.vlenReclaim(memType, *writer, &memSpace);
+    } else {
+        dset.read(data, memType, memSpace, fileSpace);
+    }
+}
+
+
+void PropertyHDF5::writeValues(DataType dtype, const void *data, ndsize_t count) {
+    if (count < 1) {
+        deleteValues();
+        return;
+    }
+
+    DataSet dset = dataset();
+    if (dtype != data_type_from_h5(dset.dataType())) {
+        throw std::invalid_argument("Inconsistent DataTypes!");
+    }
+    dset.setExtent(NDSize{count});
+
+    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+
+    if (dtype == DataType::String) {
+        StringReader reader(NDSize{count}, data);
+        dset.write(*reader, memType, NDSize{count});
+    } else {
+        dset.write(data, memType, NDSize{count});
+    }
+}
+
+
 
 } // ns nix::hdf5
 } // ns nix
@@ -0,0 +1,237 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "PyramidHDF5.hpp"
+
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace nix {
+namespace hdf5 {
+
+// the number of samples read at once, rounded up to a multiple of the largest factor
+static const ndsize_t BLOCK_SAMPLES = 1 << 20;
+
+
+static ndsize_t bins_of(ndsize_t samples, ndsize_t factor) {
+    return (samples + factor - 1) / factor;
+}
+
+
+static NDSize rows_at(ndsize_t row, ndsize_t column) {
+    NDSize size(2, column);
+    size[0] = row;
+    return size;
+}
+
+
+// NaN is kept only until a bin sees a number
+static void fold(double &min, double &max, double lo, double hi) {
+    if (lo < min || std::isnan(min)) min = lo;
+    if (hi > max || std::isnan(max)) max = hi;
+}
+
+
+PyramidHDF5::PyramidHDF5(const H5Group &group)
+    : group(group) {
+}
+
+
+bool PyramidHDF5::exists() const {
+    if (!group.hasGroup("pyramid")) {
+        return false;
+    }
+    int stale = 0;
+    group.openGroup("pyramid", false).getAttr("stale", stale);
+    return stale == 0;
+}
+
+
+void PyramidHDF5::create(const PyramidOptions &options) {
+    const std::vector<ndsize_t> &factors = options.factors;
+    if (factors.empty()) {
+        throw std::invalid_argument("A pyramid needs at least one level!");
+    }
+    for (size_t i = 0; i < factors.size(); i++) {
+        const ndsize_t previous = i > 0 ? factors[i - 1] : 1;
+        if (factors[i] <= previous || factors[i] % previous != 0) {
+            throw std::invalid_argument("The factors of a pyramid must grow and each be a multiple of the one before!");
+        }
+    }
+
+    DataSet data = group.openData("data");
+    const DataType dtype = data_type_from_h5(data.dataType());
+    if (!data_type_is_numeric(dtype)) {
+        throw std::runtime_error("A pyramid can only be built of numeric data!");
+    }
+    const NDSize extent = data.size();
+    if (extent.size() != 1) {
+        throw InvalidRank("A pyramid can only be built of 1-d data");
+    }
+
+    remove();
+    H5Group pyramid = group.openGroup("pyramid", true);
+    pyramid.setAttr("factors", factors);
+    // created up front, attributes can not be added under SWMR
+    pyramid.setAttr("stale", 0);
+
+    const h5x::DataType file_type = data_type_to_h5_filetype(dtype);
+    std::vector<Level> levels;
+    for (ndsize_t factor : factors) {
+        const NDSize shape = rows_at(bins_of(extent[0], factor), 2);
+        NDSize chunks = DataSet::guessChunking(shape, 2 * data_type_to_size(dtype));
+        chunks[1] = 2;
+        levels.push_back({factor, pyramid.createData(std::to_string(factor), file_type, shape,
+                                                     Compression::None, {}, chunks, true, false)});
+    }
+
+    const ndsize_t largest = factors.back();
+    const ndsize_t block = std::max<ndsize_t>(BLOCK_SAMPLES / largest, 1) * largest;
+    const size_t total = static_cast<size_t>(bins_of(extent[0], block));
+
+    size_t threads = options.threads;
+    if (threads == 0) {
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    threads = std::min(threads, total);
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    // the HDF5 calls are serialized by the wrappers, the min/max runs in parallel
+    auto work = [&] {
+        std::vector<double> raw, bins;
+        try {
+            for (size_t i = next++; i < total && !failed; i = next++) {
+                const ndsize_t offset = i * block;
+                buildBlock(data, levels, offset, std::min(block, extent[0] - offset), raw, bins);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            failed = true;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < threads; i++) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (auto &t : pool) {
+        t.join();
+    }
+
+    if (error) {
+        remove();
+        std::rethrow_exception(error);
+    }
+}
+
+
+void PyramidHDF5::buildBlock(const DataSet &data, std::vector<Level> &levels, ndsize_t offset, ndsize_t count,
+                             std::vector<double> &raw, std::vector<double> &bins) {
+    const h5x::DataType mem_type = data_type_to_h5_memtype(DataType::Double);
+    raw.resize(static_cast<size_t>(count));
+    data.read(raw.data(), mem_type, NDSize({count}), NDSize({offset}));
+
+    // the first level is made of the samples, every other one of the level before
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    ndsize_t step = levels[0].factor;
+    ndsize_t n = bins_of(count, step);
+    bins.assign(static_cast<size_t>(2 * n), nan);
+    for (ndsize_t i = 0; i < count; i++) {
+        const size_t b = static_cast<size_t>(i / step);
+        fold(bins[2 * b], bins[2 * b + 1], raw[i], raw[i]);
+    }
+
+    for (size_t l = 0; l < levels.size(); l++) {
+        if (l > 0) {
+            // bins are folded in place, bin j only reads bins >= j
+            step = levels[l].factor / levels[l - 1].factor;
+            const ndsize_t m = bins_of(n, step);
+            for (ndsize_t j = 0; j < m; j++) {
+                double lo = nan, hi = nan;
+                for (ndsize_t k = j * step; k < std::min(n, (j + 1) * step); k++) {
+                    fold(lo, hi, bins[2 * k], bins[2 * k + 1]);
+                }
+                bins[2 * j] = lo;
+                bins[2 * j + 1] = hi;
+            }
+            n = m;
+        }
+        levels[l].data.write(bins.data(), mem_type, rows_at(n, 2), rows_at(offset / levels[l].factor, 0));
+    }
+}
+
+
+bool PyramidHDF5::remove() {
+    if (!group.hasGroup("pyramid")) {
+        return false;
+    }
+    group.removeGroup("pyramid");
+    return true;
+}
+
+
+void PyramidHDF5::markStale() {
+    if (exists()) {
+        group.openGroup("pyramid", false).setAttr("stale", 1);
+    }
+}
+
+
+std::vector<ndsize_t> PyramidHDF5::factors() const {
+    std::vector<ndsize_t> factors;
+    if (exists()) {
+        group.openGroup("pyramid", false).getAttr("factors", factors);
+    }
+    return factors;
+}
+
+
+void PyramidHDF5::read(ndsize_t factor, ndsize_t offset, ndsize_t count,
+                       std::vector<double> &min, std::vector<double> &max) const {
+    const std::string name = std::to_string(factor);
+    if (!exists() || !group.openGroup("pyramid", false).hasData(name)) {
+        throw std::invalid_argument("The pyramid has no level " + name + "!");
+    }
+
+    DataSet level = group.openGroup("pyramid", false).openData(name);
+    const NDSize extent = level.size();
+    if (offset + count > extent[0]) {
+        throw OutOfBounds("Pyramid level: offset + count is out of bounds", offset + count);
+    }
+
+    std::vector<double> rows(static_cast<size_t>(2 * count));
+    if (count > 0) {
+        level.read(rows.data(), data_type_to_h5_memtype(DataType::Double), rows_at(count, 2), rows_at(offset, 0));
+    }
+    min.resize(static_cast<size_t>(count));
+    max.resize(static_cast<size_t>(count));
+    for (size_t i = 0; i < min.size(); i++) {
+        min[i] = rows[2 * i];
+        max[i] = rows[2 * i + 1];
+    }
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,87 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_PYRAMID_HDF5_H
+#define NIX_PYRAMID_HDF5_H
+
+#include <nix/DataPyramid.hpp>
+#include <nix/NDSize.hpp>
+
+#include "h5x/H5Group.hpp"
+#include "h5x/H5DataSet.hpp"
+
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+
+/**
+ * The min/max decimation pyramid of the 1-d data of a data array.
+ *
+ * The group "pyramid" next to "data" holds one data set per level, named
+ * after its factor, with the min and max of every bin of factor samples in
+ * its rows; the factors of all levels are in the attribute "factors" of the
+ * group. The data is read in blocks of a multiple of the largest factor, so
+ * every block yields whole bins of all levels; the blocks are processed on
+ * a pool of threads. Any change of the data removes the pyramid; under
+ * SWMR, where nothing can be removed, the attribute "stale" of the group
+ * is set instead and the pyramid counts as missing from then on.
+ */
+class PyramidHDF5 {
+
+public:
+
+    /**
+     * @param group  The group of the data array.
+     */
+    explicit PyramidHDF5(const H5Group &group);
+
+    /**
+     * Whether there is a pyramid that is not stale.
+     */
+    bool exists() const;
+
+    void create(const PyramidOptions &options);
+
+    /**
+     * Remove the pyramid, also a stale one.
+     */
+    bool remove();
+
+    /**
+     * Mark the pyramid as outdated by a change of the data, without
+     * removing anything from the file.
+     */
+    void markStale();
+
+    std::vector<ndsize_t> factors() const;
+
+    /**
+     * Read count bins starting at bin offset of the level factor.
+     */
+    void read(ndsize_t factor, ndsize_t offset, ndsize_t count,
+              std::vector<double> &min, std::vector<double> &max) const;
+
+private:
+
+    struct Level {
+        ndsize_t factor;
+        DataSet  data;
+    };
+
+    static void buildBlock(const DataSet &data, std::vector<Level> &levels, ndsize_t offset, ndsize_t count,
+                           std::vector<double> &raw, std::vector<double> &bins);
+
+    H5Group group;
+};
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_PYRAMID_HDF5_H
@@ -0,0 +1,421 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "RepackerHDF5.hpp"
+
+#include "CopierHDF5.hpp"
+#include "FileHDF5.hpp"
+#include "h5x/H5PList.hpp"
+#include "h5x/H5Stats.hpp"
+
+#include <boost/filesystem.hpp>
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace bfs = boost::filesystem;
+
+namespace nix {
+namespace hdf5 {
+
+// the compression level of Compression::DeflateNormal, see H5Group::createData
+static const int deflate_level = 6;
+
+// the bytes of a contiguous data set that are copied at once
+static const size_t contiguous_block = 1 << 20;
+
+
+// the layout of an existing data set, as chunks, compression and storage
+static void data_layout(const DataSet &ds, NDSize &chunks, Compression &compression, DataStorage &storage) {
+    H5Lock lock;
+    H5Object dcpl = H5Dget_create_plist(ds.h5id());
+    dcpl.check("RepackerHDF5: Could not get data set creation plist");
+
+    chunks = NDSize{};
+    compression = Compression::None;
+    if (H5Pget_layout(dcpl.h5id()) != H5D_CHUNKED) {
+        storage = DataStorage::Contiguous;
+        return;
+    }
+    storage = DataStorage::Chunked;
+
+    chunks = NDSize(ds.size().size(), 0);
+    HErr res = H5Pget_chunk(dcpl.h5id(), static_cast<int>(chunks.size()), chunks.data());
+    res.check("RepackerHDF5: Could not get chunk size");
+
+    const int n = H5Pget_nfilters(dcpl.h5id());
+    for (int i = 0; i < n; i++) {
+        unsigned flags = 0;
+        size_t nelmts = 0;
+        if (H5Pget_filter2(dcpl.h5id(), static_cast<unsigned>(i), &flags, &nelmts, NULL, 0, NULL,
+                           NULL) == H5Z_FILTER_DEFLATE) {
+            compression = Compression::DeflateNormal;
+        }
+    }
+}
+
+
+// whether the elements of a type have a fixed size and can be copied as bytes
+static bool fixed_size(const h5x::DataType &type) {
+    H5Lock lock;
+    const H5T_class_t cls = H5Tget_class(type.h5id());
+    return cls != H5T_COMPOUND && cls != H5T_VLEN && cls != H5T_REFERENCE &&
+           H5Tis_variable_str(type.h5id()) <= 0;
+}
+
+
+RepackerHDF5::RepackerHDF5(const RepackOptions &options)
+    : options(options) {
+    report.size_before = 0;
+    report.size_after = 0;
+    report.arrays = 0;
+    report.rewritten = 0;
+    report.seconds = 0;
+}
+
+
+RepackReport RepackerHDF5::repack(const std::string &source, const std::string &destination) {
+    const auto start = std::chrono::steady_clock::now();
+
+    FileHeader header = FileHDF5::probe(source);
+    if (!header.valid) {
+        throw std::runtime_error("RepackerHDF5: Cannot repack " + source + ": " + header.error);
+    }
+    if (bfs::exists(destination) && bfs::equivalent(source, destination)) {
+        throw std::invalid_argument("RepackerHDF5: A file cannot be repacked into itself");
+    }
+
+    try {
+        copy(source, destination);
+    } catch (...) {
+        array_ids.clear();
+        copies.clear();
+        jobs.clear();
+        boost::system::error_code ec;
+        bfs::remove(destination, ec);
+        throw;
+    }
+
+    report.size_before = bfs::file_size(source);
+    report.size_after = bfs::file_size(destination);
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+
+void RepackerHDF5::copy(const std::string &source, const std::string &destination) {
+    H5Object src, dst;
+    {
+        H5Lock lock;
+        src = H5Object(H5Fopen(source.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT));
+        src.check("RepackerHDF5: Could not open " + source);
+
+        H5F_info2_t info;
+        HErr res = H5Fget_info2(src.h5id(), &info);
+        res.check("RepackerHDF5: Could not get file info of " + source);
+
+        // the same creation order tracking as FileHDF5, and the 1.10
+        // format if the source has it, e.g. for SWMR
+        H5Object fcpl = H5Pcreate(H5P_FILE_CREATE);
+        fcpl.check("RepackerHDF5: Could not create file creation plist");
+        res = H5Pset_link_creation_order(fcpl.h5id(), H5P_CRT_ORDER_TRACKED|H5P_CRT_ORDER_INDEXED);
+        res.check("RepackerHDF5: Could not set link creation order");
+        H5Object fapl = H5Pcreate(H5P_FILE_ACCESS);
+        fapl.check("RepackerHDF5: Could not create file access plist");
+        if (info.super.version >= 3) {
+            res = H5Pset_libver_bounds(fapl.h5id(), H5F_LIBVER_LATEST, H5F_LIBVER_LATEST);
+            res.check("RepackerHDF5: Could not set the library version bounds");
+        }
+
+        dst = H5Object(H5Fcreate(destination.c_str(), H5F_ACC_TRUNC, fcpl.h5id(), fapl.h5id()));
+        dst.check("RepackerHDF5: Could not create " + destination);
+    }
+
+    H5Group src_root, dst_root;
+    {
+        H5Lock lock;
+        src_root = H5Group(H5Gopen2(src.h5id(), "/", H5P_DEFAULT));
+        src_root.check("RepackerHDF5: Could not open the root group of " + source);
+        dst_root = H5Group(H5Gopen2(dst.h5id(), "/", H5P_DEFAULT));
+        dst_root.check("RepackerHDF5: Could not open the root group of " + destination);
+    }
+
+    findArrays(src_root);
+    CopierHDF5::copyAttributes(src_root, dst_root, false);
+    copyGroup(src_root, dst_root, "");
+    rewrite();
+
+    // close all objects, the file is only closed with the last of them
+    jobs.clear();
+    copies.clear();
+}
+
+
+void RepackerHDF5::findArrays(const H5Group &root) {
+    if (!root.hasGroup("data")) {
+        return;
+    }
+
+    H5Group data = root.openGroup("data", false);
+    for (const std::string &block : data.objectNames()) {
+        H5Group b = data.openGroup(block, false);
+        if (!b.hasGroup("data_arrays")) {
+            continue;
+        }
+        H5Group arrays = b.openGroup("data_arrays", false);
+        for (const std::string &name : arrays.objectNames()) {
+            H5Group da = arrays.openGroup(name, false);
+            std::string id;
+            da.getAttr("entity_id", id);
+            array_ids.emplace(da.objectAddress(), id);
+        }
+    }
+}
+
+
+void RepackerHDF5::copyGroup(const H5Group &source, const H5Group &target, const std::string &array_id) {
+    H5Lock lock;
+    for (const std::string &link : CopierHDF5::hardLinks(source)) {
+        H5O_info_t info;
+        HErr res = H5Oget_info_by_name(source.h5id(), link.c_str(), &info, H5P_DEFAULT);
+        res.check("RepackerHDF5: Could not get object info of " + link);
+
+        auto it = copies.find(info.addr);
+        if (it != copies.end()) {
+            res = H5Lcreate_hard(it->second.h5id(), ".", target.h5id(), link.c_str(),
+                                 PList::linkUTF8().h5id(), H5P_DEFAULT);
+            res.check("RepackerHDF5: Could not link " + link);
+            continue;
+        }
+
+        if (info.type == H5O_TYPE_GROUP) {
+            H5Group child = source.openGroup(link, false);
+            H5Group copy = target.openGroup(link, true);
+            CopierHDF5::copyAttributes(child, copy, false);
+            if (info.rc > 1) {
+                copies.emplace(info.addr, copy);
+            }
+
+            auto da = array_ids.find(info.addr);
+            copyGroup(child, copy, da != array_ids.end() ? da->second : "");
+        } else if (info.type == H5O_TYPE_DATASET) {
+            copyData(source, target, link, array_id);
+            if (info.rc > 1) {
+                H5Object copy = H5Oopen(target.h5id(), link.c_str(), H5P_DEFAULT);
+                copy.check("RepackerHDF5: Could not open the copy of " + link);
+                copies.emplace(info.addr, copy);
+            }
+        }
+    }
+}
+
+
+void RepackerHDF5::copyData(const H5Group &source, const H5Group &target, const std::string &name,
+                            const std::string &array_id) {
+    H5Lock lock;
+    DataSet src = source.openData(name);
+    h5x::DataType type = src.dataType();
+    const bool array = name == "data" && !array_id.empty();
+
+    NDSize chunks;
+    Compression compression;
+    DataStorage storage;
+    data_layout(src, chunks, compression, storage);
+
+    DataLayout layout = options.layout;
+    if (array) {
+        report.arrays++;
+        auto it = options.arrays.find(array_id);
+        if (it != options.arrays.end()) {
+            layout = it->second;
+        }
+    }
+
+    // asking for chunks or a compression asks for chunked data
+    DataStorage new_storage = layout.storage;
+    if (new_storage == DataStorage::Auto) {
+        new_storage = layout.chunks || layout.compression != Compression::Auto ? DataStorage::Chunked : storage;
+    }
+    Compression new_compression = layout.compression == Compression::Auto ? compression : layout.compression;
+    NDSize new_chunks = layout.chunks ? layout.chunks : chunks;
+    if (new_storage == DataStorage::Contiguous) {
+        if (array && layout.compression == Compression::DeflateNormal) {
+            throw std::invalid_argument("RepackerHDF5: Contiguous data can not be compressed, data array " + array_id);
+        }
+        new_compression = Compression::None;
+        new_chunks = NDSize{};
+    }
+
+    if (!array || !fixed_size(type) ||
+        (new_storage == storage && new_compression == compression && new_chunks == chunks)) {
+        // the raw chunks are copied as they are stored
+        HErr res = H5Ocopy(source.h5id(), name.c_str(), target.h5id(), name.c_str(), H5P_DEFAULT,
+                           PList::linkUTF8().h5id());
+        res.check("RepackerHDF5: Could not copy data set " + name);
+        return;
+    }
+
+    const NDSize extent = src.size();
+    if (new_chunks && (new_chunks.size() != extent.size() || new_chunks.nelms() == 0)) {
+        throw std::invalid_argument("RepackerHDF5: The chunks do not fit the data of data array " + array_id);
+    }
+
+    DataSet dst = new_storage == DataStorage::Contiguous ? target.createContiguousData(name, type, extent)
+                                                         : target.createData(name, type, extent, new_compression, {},
+                                                                             new_chunks);
+    CopierHDF5::copyAttributes(src, dst, false);
+    report.rewritten++;
+
+    if (extent.nelms() == 0) {
+        return;
+    }
+
+    Rewrite job;
+    job.type = type;
+    job.element = H5Tget_size(type.h5id());
+    job.extent = extent;
+    job.target = dst;
+    data_layout(dst, job.block, compression, storage);
+    job.direct = storage != DataStorage::Contiguous;
+    job.deflate = compression == Compression::DeflateNormal;
+
+    if (!job.direct) {
+        // whole rows, about contiguous_block bytes at once
+        const size_t row = (extent.nelms() / extent[0]) * job.element;
+        job.block = extent;
+        job.block[0] = std::max<ndsize_t>(std::min<ndsize_t>(contiguous_block / row, extent[0]), 1);
+    }
+
+    job.blocks = 1;
+    for (size_t i = 0; i < extent.size(); i++) {
+        job.blocks *= (extent[i] + job.block[i] - 1) / job.block[i];
+    }
+
+    // the blocks are read in order, a larger chunk cache keeps source
+    // chunks that span several of them from being decompressed again
+    H5Object dapl = H5Pcreate(H5P_DATASET_ACCESS);
+    dapl.check("RepackerHDF5: Could not create data set access plist");
+    HErr res = H5Pset_chunk_cache(dapl.h5id(), 12421, 64 * 1024 * 1024, 1.0);
+    res.check("RepackerHDF5: Could not set the chunk cache");
+    NIX_STAT(DataSetOpen);
+    job.source = DataSet(H5Dopen2(source.h5id(), name.c_str(), dapl.h5id()));
+    job.source.check("RepackerHDF5: Could not open data set " + name);
+
+    jobs.push_back(job);
+}
+
+
+void RepackerHDF5::rewrite() {
+    std::vector<size_t> first(1, 0);
+    for (const Rewrite &job : jobs) {
+        first.push_back(first.back() + job.blocks);
+    }
+    const size_t total = first.back();
+
+    size_t threads = options.threads;
+    if (threads == 0) {
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    threads = std::min(threads, total);
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto work = [&] {
+        std::vector<char> raw, packed;
+        try {
+            for (size_t i = next++; i < total && !failed; i = next++) {
+                const size_t j = std::upper_bound(first.begin(), first.end(), i) - first.begin() - 1;
+                rewriteBlock(jobs[j], i - first[j], raw, packed);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            failed = true;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < threads; i++) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (auto &t : pool) {
+        t.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+
+void RepackerHDF5::rewriteBlock(Rewrite &job, size_t index, std::vector<char> &raw, std::vector<char> &packed) {
+    const size_t rank = job.extent.size();
+    NDSize offset(rank, 0), count(rank, 0);
+    for (size_t k = rank; k-- > 0;) {
+        const ndsize_t n = (job.extent[k] + job.block[k] - 1) / job.block[k];
+        offset[k] = (index % n) * job.block[k];
+        count[k] = std::min(job.block[k], job.extent[k] - offset[k]);
+        index /= n;
+    }
+
+    const size_t bytes = job.block.nelms() * job.element;
+    raw.resize(bytes);
+    if (job.direct && count != job.block) {
+        // the part of an edge chunk outside of the data
+        std::fill(raw.begin(), raw.end(), 0);
+    }
+
+    {
+        H5Lock lock;
+        DataSpace memSpace = DataSpace::create(job.direct ? job.block : count, false);
+        memSpace.hyperslab(count, NDSize(rank, 0));
+        DataSpace fileSpace = job.source.getSpace();
+        fileSpace.hyperslab(count, offset);
+        job.source.read(raw.data(), job.type, memSpace, fileSpace);
+
+        if (!job.direct) {
+            DataSpace targetSpace = job.target.getSpace();
+            targetSpace.hyperslab(count, offset);
+            job.target.write(raw.data(), job.type, memSpace, targetSpace);
+            return;
+        }
+    }
+
+    const char *data = raw.data();
+    size_t size = bytes;
+    if (job.deflate) {
+        uLongf len = compressBound(static_cast<uLong>(bytes));
+        packed.resize(len);
+        int err = compress2(reinterpret_cast<Bytef *>(packed.data()), &len,
+                            reinterpret_cast<const Bytef *>(raw.data()), static_cast<uLong>(bytes), deflate_level);
+        if (err != Z_OK) {
+            throw H5Exception("RepackerHDF5: Could not compress a chunk");
+        }
+        data = packed.data();
+        size = len;
+    }
+
+    H5Lock lock;
+    NIX_STAT(DataSetWrite);
+    HErr res = H5Dwrite_chunk(job.target.h5id(), H5P_DEFAULT, 0, offset.data(), size, data);
+    res.check("RepackerHDF5: Could not write a chunk");
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,75 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_REPACKER_HDF5_H
+#define NIX_REPACKER_HDF5_H
+
+#include <nix/File.hpp>
+
+#include "h5x/H5Group.hpp"
+#include "h5x/H5DataSet.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+
+/**
+ * Rewrites a NIX file into a new one, see File::repack.
+ *
+ * The groups are walked in the order their links were created and
+ * recreated with all of their attributes, objects with more than one
+ * hard link are created once and linked again. Data sets are copied with
+ * H5Ocopy, except the data of data arrays that get a new layout: those are
+ * read block by block, the blocks of chunked layouts are compressed on a
+ * pool of threads and written with H5Dwrite_chunk.
+ */
+class RepackerHDF5 {
+
+public:
+
+    explicit RepackerHDF5(const RepackOptions &options);
+
+    RepackReport repack(const std::string &source, const std::string &destination);
+
+private:
+
+    struct Rewrite {
+        DataSet        source;
+        DataSet        target;
+        h5x::DataType  type;     // the type in the file, the data is never converted
+        size_t         element;  // the size of an element of type
+        NDSize         extent;
+        NDSize         block;    // the chunks of target, or the rows written at once
+        size_t         blocks;   // the number of blocks
+        bool           direct;   // whether blocks are written as chunks
+        bool           deflate;  // whether the chunks are compressed
+    };
+
+    void copy(const std::string &source, const std::string &destination);
+    void findArrays(const H5Group &root);
+    void copyGroup(const H5Group &source, const H5Group &target, const std::string &array_id);
+    void copyData(const H5Group &source, const H5Group &target, const std::string &name,
+                  const std::string &array_id);
+    void rewrite();
+    void rewriteBlock(Rewrite &job, size_t index, std::vector<char> &raw, std::vector<char> &packed);
+
+    RepackOptions                             options;
+    RepackReport                              report;
+    std::unordered_map<haddr_t, std::string>  array_ids;  // the data arrays of the source by address
+    std::unordered_map<haddr_t, H5Object>     copies;     // copied objects with more than one link
+    std::vector<Rewrite>                      jobs;
+};
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_REPACKER_HDF5_H
@@ -0,0 +1,363 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "StatisticsHDF5.hpp"
+
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace nix {
+namespace hdf5 {
+
+// the number of elements read at once
+static const ndsize_t READ_ELEMENTS = 1 << 20;
+
+// the columns of the statistics of a cell: min, max, sum, count
+static const ndsize_t COLUMNS = 4;
+
+
+static NDSize cells_of(const NDSize &extent, const NDSize &block) {
+    NDSize cells(extent.size(), 0);
+    for (size_t d = 0; d < extent.size(); d++) {
+        cells[d] = (extent[d] + block[d] - 1) / block[d];
+    }
+    return cells;
+}
+
+
+static NDSize with_columns(const NDSize &cells) {
+    NDSize shape(cells.size() + 1, COLUMNS);
+    std::copy(cells.begin(), cells.end(), shape.begin());
+    return shape;
+}
+
+
+static NDSize unravel(ndsize_t index, const NDSize &shape) {
+    NDSize pos(shape.size(), 0);
+    for (size_t d = shape.size(); d-- > 0;) {
+        pos[d] = index % shape[d];
+        index /= shape[d];
+    }
+    return pos;
+}
+
+
+StatisticsHDF5::StatisticsHDF5(const H5Group &group)
+    : group(group) {
+}
+
+
+bool StatisticsHDF5::exists() const {
+    return group.hasData("statistics");
+}
+
+
+NDSize StatisticsHDF5::block(const DataSet &stats) const {
+    std::vector<ndsize_t> block;
+    if (!stats.getAttr("block", block)) {
+        throw ConsistencyError("DataArray statistics without a block size");
+    }
+    NDSize size(block.size(), 0);
+    std::copy(block.begin(), block.end(), size.begin());
+    return size;
+}
+
+
+void StatisticsHDF5::create(const NDSize &block) {
+    DataSet data = group.openData("data");
+    const DataType dtype = data_type_from_h5(data.dataType());
+    if (!data_type_is_numeric(dtype)) {
+        throw std::runtime_error("Statistics can only be kept of numeric data!");
+    }
+
+    const NDSize extent = data.size();
+    if (extent.size() == 0) {
+        throw InvalidRank("Cannot keep statistics of 0-dimensional data");
+    }
+
+    const NDSize cells = cells_of(extent, block);
+    std::vector<Acc> acc(static_cast<size_t>(cells.nelms()));
+    if (!acc.empty()) {
+        readRegion(data, NDSize(extent.size(), 0), extent, block, NDSize(extent.size(), 0), cells, acc);
+    }
+
+    if (exists()) {
+        group.removeData("statistics");
+    }
+
+    const NDSize shape = with_columns(cells);
+    NDSize chunks = DataSet::guessChunking(shape, COLUMNS * sizeof(double));
+    chunks[cells.size()] = COLUMNS;
+    DataSet stats = group.createData("statistics", data_type_to_h5_filetype(DataType::Double), shape,
+                                     Compression::None, {}, chunks, true, false);
+    stats.setAttr("block", std::vector<ndsize_t>(block.begin(), block.end()));
+
+    std::vector<double> rows;
+    rows.reserve(acc.size() * COLUMNS);
+    for (const Acc &cell : acc) {
+        rows.insert(rows.end(), {cell.min, cell.max, cell.sum, static_cast<double>(cell.count)});
+    }
+    if (!rows.empty()) {
+        stats.write(rows.data(), data_type_to_h5_memtype(DataType::Double), shape);
+    }
+}
+
+
+bool StatisticsHDF5::remove() {
+    if (!exists()) {
+        return false;
+    }
+    group.removeData("statistics");
+    return true;
+}
+
+
+void StatisticsHDF5::update(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
+    if (count.nelms() == 0) {
+        return;
+    }
+
+    DataSet ds = group.openData("data");
+    DataSet stats = group.openData("statistics");
+    const NDSize blk = block(stats);
+    const NDSize extent = ds.size();
+    const size_t rank = extent.size();
+
+    NDSize cell0(rank, 0), cells(rank, 0);
+    for (size_t d = 0; d < rank; d++) {
+        cell0[d] = offset[d] / blk[d];
+        cells[d] = (offset[d] + count[d] + blk[d] - 1) / blk[d] - cell0[d];
+    }
+
+    // the written values are only used as they are if that is how they are stored
+    const bool direct = dtype == data_type_from_h5(ds.dataType()) && data_type_is_numeric(dtype);
+    std::vector<Acc> acc(static_cast<size_t>(cells.nelms()));
+    if (direct) {
+        accumulate(dtype, data, count, offset, blk, cell0, cells, acc);
+    }
+
+    for (size_t i = 0; i < acc.size(); i++) {
+        const NDSize cell = cell0 + unravel(i, cells);
+        NDSize lo(rank, 0), hi(rank, 0);
+        bool covered = direct;
+        for (size_t d = 0; d < rank; d++) {
+            lo[d] = cell[d] * blk[d];
+            hi[d] = std::min(lo[d] + blk[d], extent[d]);
+            covered = covered && lo[d] >= offset[d] && hi[d] <= offset[d] + count[d];
+        }
+        if (!covered) {
+            acc[i] = Acc();
+            readRegion(ds, lo, hi - lo, blk, cell0, cells, acc);
+        }
+    }
+
+    std::vector<double> rows;
+    rows.reserve(acc.size() * COLUMNS);
+    for (const Acc &cell : acc) {
+        rows.insert(rows.end(), {cell.min, cell.max, cell.sum, static_cast<double>(cell.count)});
+    }
+    NDSize stats_offset = with_columns(cell0);
+    stats_offset[rank] = 0;
+    stats.write(rows.data(), data_type_to_h5_memtype(DataType::Double), with_columns(cells), stats_offset);
+}
+
+
+void StatisticsHDF5::resize(const NDSize &old_extent, const NDSize &new_extent) {
+    if (!exists()) {
+        return;
+    }
+    if (old_extent.size() != new_extent.size()) {
+        remove();
+        return;
+    }
+
+    DataSet stats = group.openData("statistics");
+    const NDSize blk = block(stats);
+    const NDSize cells = cells_of(new_extent, blk);
+    stats.setExtent(with_columns(cells));
+
+    // every cell from the first one whose part of the data changed is unknown
+    for (size_t d = 0; d < cells.size(); d++) {
+        if (old_extent[d] == new_extent[d]) {
+            continue;
+        }
+        const ndsize_t first = std::min(old_extent[d], new_extent[d]) / blk[d];
+        if (first >= cells[d]) {
+            continue;
+        }
+        NDSize offset(cells.size() + 1, 0);
+        NDSize count = with_columns(cells);
+        offset[d] = first;
+        count[d] = cells[d] - first;
+        if (count.nelms() == 0) {
+            continue;
+        }
+        std::vector<double> unknown(static_cast<size_t>(count.nelms()), 0.0);
+        stats.write(unknown.data(), data_type_to_h5_memtype(DataType::Double), count, offset);
+    }
+}
+
+
+DataStatistics StatisticsHDF5::query(const NDSize &offset, const NDSize &count) const {
+    DataSet ds = group.openData("data");
+    const size_t rank = offset.size();
+    Acc total;
+
+    if (count.nelms() > 0 && exists()) {
+        DataSet stats = group.openData("statistics");
+        const NDSize blk = block(stats);
+        const NDSize extent = ds.size();
+
+        NDSize cell0(rank, 0), cells(rank, 0);
+        for (size_t d = 0; d < rank; d++) {
+            cell0[d] = offset[d] / blk[d];
+            cells[d] = (offset[d] + count[d] + blk[d] - 1) / blk[d] - cell0[d];
+        }
+
+        std::vector<double> rows(static_cast<size_t>(cells.nelms() * COLUMNS));
+        NDSize stats_offset = with_columns(cell0);
+        stats_offset[rank] = 0;
+        stats.read(rows.data(), data_type_to_h5_memtype(DataType::Double), with_columns(cells), stats_offset);
+
+        std::vector<Acc> acc(static_cast<size_t>(cells.nelms()));
+        for (size_t i = 0; i < acc.size(); i++) {
+            const double *row = &rows[i * COLUMNS];
+            const NDSize cell = cell0 + unravel(i, cells);
+            NDSize lo(rank, 0), hi(rank, 0);
+            bool inside = row[3] > 0;
+            for (size_t d = 0; d < rank; d++) {
+                lo[d] = std::max(cell[d] * blk[d], offset[d]);
+                hi[d] = std::min({(cell[d] + 1) * blk[d], extent[d], offset[d] + count[d]});
+                inside = inside && cell[d] * blk[d] >= offset[d] &&
+                         std::min((cell[d] + 1) * blk[d], extent[d]) <= offset[d] + count[d];
+            }
+            if (inside) {
+                acc[i].min = row[0];
+                acc[i].max = row[1];
+                acc[i].sum = row[2];
+                acc[i].count = static_cast<ndsize_t>(row[3]);
+            } else {
+                readRegion(ds, lo, hi - lo, blk, cell0, cells, acc);
+            }
+            total.merge(acc[i]);
+        }
+    } else if (count.nelms() > 0) {
+        // without an index the region is one cell
+        std::vector<Acc> acc(1);
+        readRegion(ds, offset, count, offset + count, NDSize(rank, 0), NDSize(rank, 1), acc);
+        total = acc[0];
+    }
+
+    DataStatistics result;
+    result.count = total.count;
+    result.sum = total.sum;
+    if (total.min <= total.max) {
+        result.min = total.min;
+        result.max = total.max;
+    }
+    return result;
+}
+
+
+void StatisticsHDF5::readRegion(const DataSet &data, const NDSize &offset, const NDSize &count,
+                                const NDSize &block, const NDSize &cell0, const NDSize &cells,
+                                std::vector<Acc> &acc) {
+    if (count.nelms() == 0) {
+        return;
+    }
+
+    // read slabs of whole rows along the first dimension
+    const ndsize_t row = count.nelms() / count[0];
+    const ndsize_t step = std::max<ndsize_t>(1, READ_ELEMENTS / row);
+    std::vector<double> buffer(static_cast<size_t>(std::min(step, count[0]) * row));
+    const h5x::DataType mem_type = data_type_to_h5_memtype(DataType::Double);
+
+    for (ndsize_t start = 0; start < count[0]; start += step) {
+        NDSize slab_offset = offset;
+        NDSize slab_count = count;
+        slab_offset[0] = offset[0] + start;
+        slab_count[0] = std::min(step, count[0] - start);
+        data.read(buffer.data(), mem_type, slab_count, slab_offset);
+        accumulate(buffer.data(), slab_count, slab_offset, block, cell0, cells, acc);
+    }
+}
+
+
+template<typename T>
+void StatisticsHDF5::accumulate(const T *data, const NDSize &shape, const NDSize &origin,
+                                const NDSize &block, const NDSize &cell0, const NDSize &cells,
+                                std::vector<Acc> &acc) {
+    const size_t rank = shape.size();
+    const size_t last = rank - 1;
+    const ndsize_t length = shape[last];
+    const ndsize_t rows = shape.nelms() / length;
+
+    // the rows of data are split at the cell boundaries of the last dimension
+    NDSize pos(rank, 0);
+    for (ndsize_t r = 0; r < rows; r++) {
+        ndsize_t base = 0;
+        for (size_t d = 0; d < last; d++) {
+            base = base * cells[d] + (origin[d] + pos[d]) / block[d] - cell0[d];
+        }
+        base *= cells[last];
+
+        const T *values = data + r * length;
+        ndsize_t j = 0;
+        while (j < length) {
+            const ndsize_t cell = (origin[last] + j) / block[last];
+            const ndsize_t end = std::min(length, (cell + 1) * block[last] - origin[last]);
+            Acc &target = acc[static_cast<size_t>(base + cell - cell0[last])];
+            for (; j < end; j++) {
+                target.add(static_cast<double>(values[j]));
+            }
+        }
+
+        for (size_t d = last; d-- > 0;) {
+            if (++pos[d] < shape[d]) {
+                break;
+            }
+            pos[d] = 0;
+        }
+    }
+}
+
+
+void StatisticsHDF5::accumulate(DataType dtype, const void *data, const NDSize &shape, const NDSize &origin,
+                                const NDSize &block, const NDSize &cell0, const NDSize &cells,
+                                std::vector<Acc> &acc) {
+    switch (dtype) {
+    case DataType::Int8:
+        return accumulate(static_cast<const int8_t *>(data), shape, origin, block, cell0, cells, acc);
+    case DataType::Int16:
+        return accumulate(static_cast<const int16_t *>(data), shape, origin, block, cell0, cells, acc);
+    case DataType::Int32:
+        return accumulate(static_cast<const int32_t *>(data), shape, origin, block, cell0, cells, acc);
+    case DataType::Int64:
+        return accumulate(static_cast<const int64_t *>(data), shape, origin, block, cell0, cells, acc);
+    case DataType::UInt8:
+        return accumulate(static_cast<const uint8_t *>(data), shape, origin, block, cell0, cells, acc);
+    case DataType::UInt16:
+        return accumulate(static_cast<const uint16_t *>(data), shape, origin, block, cell0, cells, acc);
+    case DataType::UInt32:
+        return accumulate(static_cast<const uint32_t *>(data), shape, origin, block, cell0, cells, acc);
+    case DataType::UInt64:
+        return accumulate(static_cast<const uint64_t *>(data), shape, origin, block, cell0, cells, acc);
+    case DataType::Float:
+        return accumulate(static_cast<const float *>(data), shape, origin, block, cell0, cells, acc);
+    case DataType::Double:
+        return accumulate(static_cast<const double *>(data), shape, origin, block, cell0, cells, acc);
+    default:
+        throw std::runtime_error("Statistics can only be kept of numeric data!");
+    }
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,113 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_STATISTICS_HDF5_H
+#define NIX_STATISTICS_HDF5_H
+
+#include <nix/DataStatistics.hpp>
+#include <nix/DataType.hpp>
+#include <nix/NDSize.hpp>
+
+#include "h5x/H5Group.hpp"
+#include "h5x/H5DataSet.hpp"
+
+#include <limits>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+
+/**
+ * The index of per chunk statistics of the data of a data array.
+ *
+ * The data is divided into cells of the size of its chunks, the data set
+ * "statistics" next to "data" holds min, max, sum and count of every cell
+ * and the size of the cells in its attribute "block". A count of zero marks
+ * a cell whose statistics are not known, e.g. after the extent of the data
+ * changed; those cells are read from the data when they are queried and
+ * computed again when they are written.
+ */
+class StatisticsHDF5 {
+
+public:
+
+    /**
+     * @param group  The group of the data array.
+     */
+    explicit StatisticsHDF5(const H5Group &group);
+
+    bool exists() const;
+
+    /**
+     * Compute the statistics of all cells of the size block.
+     */
+    void create(const NDSize &block);
+
+    bool remove();
+
+    /**
+     * Update the cells touched by a write of count elements at offset. Cells
+     * the write covers are computed from data, all others are read back.
+     */
+    void update(DataType dtype, const void *data, const NDSize &count, const NDSize &offset);
+
+    /**
+     * Follow a change of the extent of the data: the cells that changed are
+     * marked as unknown.
+     */
+    void resize(const NDSize &old_extent, const NDSize &new_extent);
+
+    DataStatistics query(const NDSize &offset, const NDSize &count) const;
+
+private:
+
+    struct Acc {
+        double   min   = std::numeric_limits<double>::infinity();
+        double   max   = -std::numeric_limits<double>::infinity();
+        double   sum   = 0;
+        ndsize_t count = 0;
+
+        void add(double value) {
+            // NaN compares false and is left out of min and max
+            if (value < min) min = value;
+            if (value > max) max = value;
+            sum += value;
+            count++;
+        }
+
+        void merge(const Acc &other) {
+            if (other.min < min) min = other.min;
+            if (other.max > max) max = other.max;
+            sum += other.sum;
+            count += other.count;
+        }
+    };
+
+    NDSize block(const DataSet &stats) const;
+
+    static void readRegion(const DataSet &data, const NDSize &offset, const NDSize &count,
+                           const NDSize &block, const NDSize &cell0, const NDSize &cells,
+                           std::vector<Acc> &acc);
+
+    template<typename T>
+    static void accumulate(const T *data, const NDSize &shape, const NDSize &origin,
+                           const NDSize &block, const NDSize &cell0, const NDSize &cells,
+                           std::vector<Acc> &acc);
+
+    static void accumulate(DataType dtype, const void *data, const NDSize &shape, const NDSize &origin,
+                           const NDSize &block, const NDSize &cell0, const NDSize &cells,
+                           std::vector<Acc> &acc);
+
+    H5Group group;
+};
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_STATISTICS_HDF5_H
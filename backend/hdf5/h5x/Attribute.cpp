@@ -10,6 +10,7 @@
 
 #include "Attribute.hpp"
 #include "H5DataType.hpp"
+#include "H5Stats.hpp"
 
 namespace nix {
 namespace hdf5 {
@@ -26,22 +27,30 @@ Attribute::Attribute(const Attribute &other) : H5Object(other) {
 
 
 void Attribute::read(h5x::DataType mem_type, const NDSize &size, void *data) {
+    H5Lock lock;
+    NIX_STAT(AttrRead);
+    NIX_STAT_TRANSFER(hid, mem_type.h5id(), H5S_ALL, H5S_ALL);
     HErr status = H5Aread(hid, mem_type.h5id(), data);
     status.check("Attribute::read(): Could not read data");
 }
 
 void Attribute::read(h5x::DataType mem_type, const NDSize &size, std::string *data) {
+    H5Lock lock;
     StringWriter writer(size, data);
     read(mem_type, size, *writer);
     writer.finish();
 
     DataSpace space = getSpace();
 
+    NIX_STAT(VlenReclaim);
     HErr status = H5Dvlen_reclaim(mem_type.h5id(), space.h5id(), H5P_DEFAULT, *writer);
     status.check("Attribute::read(): Could not reclaim variable length data");
 }
 
 void Attribute::write(h5x::DataType mem_type, const NDSize &size, const void *data) {
+    H5Lock lock;
+    NIX_STAT(AttrWrite);
+    NIX_STAT_TRANSFER(hid, mem_type.h5id(), H5S_ALL, H5S_ALL);
     HErr status = H5Awrite(hid, mem_type.h5id(), data);
     status.check("Attribute::write(): Could not write data");
 }
@@ -52,18 +61,21 @@ void Attribute::write(h5x::DataType mem_type, const NDSize &size, const std::str
 }
 
 PList Attribute::createPList() const {
+    H5Lock lock;
     PList pl = H5Aget_create_plist(hid);
     pl.check("Attribute::createPList(): Could not get creation property list");
     return pl;
 }
 
 h5x::DataType Attribute::dataType() const {
+    H5Lock lock;
     h5x::DataType dtype = H5Aget_type(hid);
     dtype.check("Attribute::dataType(): Could not get type");
     return dtype;
 }
 
 DataSpace Attribute::getSpace() const {
+    H5Lock lock;
 
     DataSpace space = H5Aget_space(hid);
     space.check("Attribute::getSpace(): Could not get data space");
@@ -32,6 +32,8 @@ public:
     static DataSpace create(const NDSize &dims, bool maxdims_unlimited);
 
     void hyperslab(const NDSize &count, const NDSize &start, H5S_seloper_t op = H5S_SELECT_SET);
+    void hyperslab(const NDSize &count, const NDSize &start, const NDSize &stride, const NDSize &block,
+                   H5S_seloper_t op = H5S_SELECT_SET);
 
     DataSpace &operator=(const DataSpace &other) {
         H5Object::operator=(other);
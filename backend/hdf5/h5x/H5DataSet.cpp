@@ -8,6 +8,7 @@
 
 #include "H5DataSet.hpp"
 #include "H5Exception.hpp"
+#include "H5Stats.hpp"
 
 #include <iostream>
 #include <cmath>
@@ -27,12 +28,18 @@ DataSet::DataSet(const DataSet &other)
 
 void DataSet::read(void *data, const h5x::DataType &memType, const DataSpace &memSpace, const DataSpace &fileSpace) const
 {
+    H5Lock lock;
+    NIX_STAT(DataSetRead);
+    NIX_STAT_TRANSFER(hid, memType.h5id(), memSpace.h5id(), fileSpace.h5id());
     HErr res = H5Dread(hid, memType.h5id(), memSpace.h5id(), fileSpace.h5id(), H5P_DEFAULT, data);
     res.check("DataSet::read() IO error");
 }
 
 void DataSet::write(const void *data, const h5x::DataType &memType, const DataSpace &memSpace, const DataSpace &fileSpace)
 {
+    H5Lock lock;
+    NIX_STAT(DataSetWrite);
+    NIX_STAT_TRANSFER(hid, memType.h5id(), memSpace.h5id(), fileSpace.h5id());
     HErr res = H5Dwrite(hid, memType.h5id(), memSpace.h5id(), fileSpace.h5id(), H5P_DEFAULT, data);
     res.check("DataSet::write() IOError");
 }
@@ -154,12 +161,14 @@ std::tuple<ndsize_t, ndsize_t> DataSet::getChunkBounds()
 
 void DataSet::setExtent(const NDSize &dims)
 {
+    H5Lock lock;
     DataSpace space = getSpace();
 
     if (space.extent().size() != dims.size()) {
         throw InvalidRank("Cannot change the dimensionality via setExtent()");
     }
 
+    NIX_STAT(DataSetExtent);
     HErr res = H5Dset_extent(hid, dims.data());
     res.check("DataSet::setExtent(): Could not set the extent of the DataSet.");
 
@@ -171,8 +180,26 @@ NDSize DataSet::size() const
     return getSpace().extent();
 }
 
+
+void DataSet::flush()
+{
+    H5Lock lock;
+    HErr res = H5Dflush(hid);
+    res.check("DataSet::flush(): Could not flush the DataSet.");
+}
+
+
+void DataSet::refresh()
+{
+    H5Lock lock;
+    HErr res = H5Drefresh(hid);
+    res.check("DataSet::refresh(): Could not refresh the DataSet.");
+}
+
 void DataSet::vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace) const
 {
+    H5Lock lock;
+    NIX_STAT(VlenReclaim);
     HErr res;
     if (dspace != nullptr) {
         res = H5Dvlen_reclaim(mem_type.h5id(), dspace->h5id(), H5P_DEFAULT, data);
@@ -187,12 +214,16 @@ void DataSet::vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace)
 
 h5x::DataType DataSet::dataType(void) const
 {
+    H5Lock lock;
+    NIX_STAT(DataSetInfo);
     h5x::DataType ftype = H5Dget_type(hid);
     ftype.check("DataSet::dataType(): H5Dget_type failed");
     return ftype;
 }
 
 DataSpace DataSet::getSpace() const {
+    H5Lock lock;
+    NIX_STAT(DataSetInfo);
     DataSpace space = H5Dget_space(hid);
     space.check("DataSet::getSpace(): Could not obtain dataspace");
     return space;
@@ -214,5 +245,28 @@ std::tuple<DataSpace, DataSpace> DataSet::offsetCount2DataSpaces(const NDSize &c
     return std::tuple<DataSpace, DataSpace>(memSpace, fileSpace);
 }
 
+
+std::tuple<DataSpace, DataSpace> DataSet::offsetCount2DataSpaces(const NDSize &count,
+                                                                 const NDSize &offset,
+                                                                 const NDSize &stride,
+                                                                 const NDSize &block) const
+{
+    if (!stride && !block) {
+        return offsetCount2DataSpaces(count, offset);
+    }
+
+    const size_t rank = count.size();
+    if ((offset && offset.size() != rank) || (stride && stride.size() != rank) ||
+        (block && block.size() != rank)) {
+        throw InvalidRank("Rank of count, offset, stride and block must match");
+    }
+
+    DataSpace fileSpace = getSpace();
+    DataSpace memSpace = DataSpace::create(block ? count * block : count, false);
+    fileSpace.hyperslab(count, offset ? offset : NDSize(rank, 0), stride, block);
+
+    return std::tuple<DataSpace, DataSpace>(memSpace, fileSpace);
+}
+
 } // namespace hdf5
 } // namespace nix
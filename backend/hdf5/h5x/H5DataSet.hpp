@@ -56,6 +56,16 @@ public:
     void setExtent(const NDSize &dims);
     NDSize size() const;
 
+    /**
+     * @brief Write everything buffered for the DataSet to the file.
+     */
+    void flush();
+
+    /**
+     * @brief Drop the cached metadata, e.g. the extent, and reload it.
+     */
+    void refresh();
+
     void vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace = nullptr) const;
 
     h5x::DataType dataType(void) const;
@@ -64,6 +74,16 @@ public:
 
     std::tuple<DataSpace, DataSpace> offsetCount2DataSpaces(const NDSize &count, const NDSize &offset={}) const;
 
+    /**
+     * @brief Memory and file data spaces for a strided selection.
+     *
+     * Selects count blocks of block elements each, starting at offset and
+     * stride elements apart. An empty stride or block means 1 along all
+     * dimensions. The memory space has the shape count * block.
+     */
+    std::tuple<DataSpace, DataSpace> offsetCount2DataSpaces(const NDSize &count, const NDSize &offset,
+                                                            const NDSize &stride, const NDSize &block) const;
+
     DataSet &operator=(const DataSet &other) {
         LocID::operator=(other);
         return *this;
@@ -17,24 +17,28 @@ namespace hdf5 {
 namespace h5x {
 
 bool DataType::equal(const DataType &other) const {
+    H5Lock lock;
     HTri res = H5Tequal(hid, other.hid);
     res.check("DataType::equal(): H5Tequal failed");
     return res.result();
 }
 
 DataType DataType::copy(hid_t source) {
+    H5Lock lock;
     DataType hi_copy = H5Tcopy(source);
     hi_copy.check("Could not copy type");
     return hi_copy;
 }
 
 DataType DataType::make(H5T_class_t klass, size_t size) {
+    H5Lock lock;
     DataType dt = H5Tcreate(klass, size);
     dt.check("Could not create datatype");
     return dt;
 }
 
 DataType DataType::makeStrType(size_t size, H5T_cset_t cset) {
+    H5Lock lock;
     DataType str_type = H5Tcopy(H5T_C_S1);
     str_type.check("Could not create string type");
     str_type.size(size);
@@ -43,50 +47,60 @@ DataType DataType::makeStrType(size_t size, H5T_cset_t cset) {
 }
 
 DataType DataType::makeCompound(size_t size) {
+    H5Lock lock;
     DataType res = H5Tcreate(H5T_COMPOUND, size);
     res.check("Could not create compound type");
     return res;
 }
 
 DataType DataType::makeEnum(const DataType &base) {
+    H5Lock lock;
     DataType res = H5Tenum_create(base.h5id());
     res.check("Could not create enum type");
     return res;
 }
 
 H5T_class_t DataType::class_t() const {
+    H5Lock lock;
     return H5Tget_class(hid);
 }
 
 void DataType::size(size_t t) {
+    H5Lock lock;
     HErr res = H5Tset_size(hid, t);
     res.check("DataType::size: Could not set size");
 }
 
 size_t DataType::size() const {
+    H5Lock lock;
     return H5Tget_size(hid); //FIXME: throw on 0?
 }
 
 void DataType::sign(H5T_sign_t sign) {
+    H5Lock lock;
     HErr res = H5Tset_sign(hid, sign);
     res.check("DataType::sign(): H5Tset_sign failed");
 }
 
 H5T_sign_t DataType::sign() const {
+    H5Lock lock;
     H5T_sign_t res = H5Tget_sign(hid);
     return res;
 }
 
 void DataType::cset(H5T_cset_t cset) {
+    H5Lock lock;
     HErr res = H5Tset_cset(hid, cset);
     res.check("DataType::cset(): H5Tset_cset failed");
 }
 H5T_cset_t DataType::cset() const {
+    H5Lock lock;
     H5T_cset_t res = H5Tget_cset(hid);
     return res;
 }
 
 bool DataType::isVariableString() const {
+    H5Lock lock;
     HTri res = H5Tis_variable_str(hid);
     res.check("DataType::isVariableString(): H5Tis_variable_str failed");
     return res.result();
@@ -97,6 +111,7 @@ bool DataType::isCompound() const {
 }
 
 unsigned int DataType::member_count() const {
+    H5Lock lock;
     int res = H5Tget_nmembers(hid);
     if (res < 0) {
         throw H5Exception("DataType::member_count(): H5Tget_nmembers faild");
@@ -105,10 +120,12 @@ unsigned int DataType::member_count() const {
 }
 
 H5T_class_t DataType::member_class(unsigned int index) const {
+    H5Lock lock;
     return H5Tget_member_class(hid, index);
 }
 
 std::string DataType::member_name(unsigned int index) const {
+    H5Lock lock;
     char *data = H5Tget_member_name(hid, index);
     std::string res(data);
     std::free(data);
@@ -127,10 +144,12 @@ std::vector<std::string> DataType::member_names() const {
 }
 
 size_t DataType::member_offset(unsigned int index) const {
+    H5Lock lock;
     return H5Tget_member_offset(hid, index);
 }
 
 unsigned int DataType::member_index(const std::string &name) const {
+    H5Lock lock;
     int res = H5Tget_member_index(hid, name.c_str());
     if (res < 0) {
         throw H5Exception("DataType::member_index(): H5Tget_member_index failed");
@@ -140,6 +159,7 @@ unsigned int DataType::member_index(const std::string &name) const {
 }
 
 DataType DataType::member_type(unsigned int index) const {
+    H5Lock lock;
     h5x::DataType res = H5Tget_member_type(hid, index);
     res.check("DataType::member_type(): H5Tget_member_type failed");
     return res;
@@ -151,16 +171,19 @@ DataType DataType::member_type(const std::string &name) const {
 }
 
 void DataType::insert(const std::string &name, size_t offset, const DataType &dtype) {
+    H5Lock lock;
     HErr res = H5Tinsert(hid, name.c_str(), offset, dtype.hid);
     res.check("DataType::insert(): H5Tinsert failed.");
 }
 
 void DataType::insert(const std::string &name, void *value) {
+    H5Lock lock;
     HErr res = H5Tenum_insert(hid, name.c_str(), value);
     res.check("DataType::insert(): H5Tenum_insert failed.");
 }
 
 void DataType::enum_valueof(const std::string &name, void *value) {
+    H5Lock lock;
     HErr res = H5Tenum_valueof(hid, name.c_str(), value);
     res.check("DataType::enum_valueof(): H5Tenum_valueof failed");
 }
@@ -202,6 +225,7 @@ h5x::DataType make_file_booltype() {
 }
 
 h5x::DataType make_mem_booltype() {
+    H5Lock lock;
     h5x::DataType booltype = h5x::DataType::make(H5T_ENUM, sizeof(bool));
     booltype.insert("FALSE", false);
     booltype.insert("TRUE", true);
@@ -223,6 +247,7 @@ static herr_t bitfield2bool(hid_t src_id,
                             void *buf_i,
                             void *bkg_i,
                             hid_t dxpl) {
+    H5Lock lock;
 
     // document for what this function should to at:
     // https://support.hdfgroup.org/HDF5/doc/H5.user/Datatypes.html#Datatypes-DataConversion
@@ -25,6 +25,9 @@
 
 #include <hdf5.h>
 
+// all calls into HDF5 are made while holding the H5Lock
+#include "H5Lock.hpp"
+
 #include <stdexcept>
 #include <string>
 
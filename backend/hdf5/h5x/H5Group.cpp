@@ -10,6 +10,8 @@
 #include <nix/util/util.hpp>
 #include "H5Exception.hpp"
 #include "H5PList.hpp"
+#include "H5Stats.hpp"
+#include <unordered_map>
 
 namespace nix {
 namespace hdf5 {
@@ -19,6 +21,7 @@ optGroup::optGroup(const H5Group &parent, const std::string &g_name)
 {}
 
 boost::optional<H5Group> optGroup::operator() (bool create) const {
+    H5Lock lock;
     if (parent.hasGroup(g_name)) {
         g = boost::optional<H5Group>(parent.openGroup(g_name));
     } else if (create) {
@@ -38,16 +41,20 @@ H5Group::H5Group(const H5Group &other) : LocID(other) {}
 
 
 bool H5Group::hasObject(const std::string &name) const {
+    H5Lock lock;
     // empty string should return false, not exception (which H5Lexists would)
     if (name.empty()) {
         return false;
     }
 
+    NIX_STAT(LinkExists);
     HTri res = H5Lexists(hid, name.c_str(), H5P_DEFAULT);
     return res.check("H5Group::hasObject(): H5Lexists failed");
 }
 
 bool H5Group::objectOfType(const std::string &name, H5O_type_t type) const {
+    H5Lock lock;
+    NIX_STAT(ObjectOpen);
     H5O_info_t info;
 
     hid_t obj = H5Oopen(hid, name.c_str(), H5P_DEFAULT);
@@ -66,6 +73,7 @@ bool H5Group::objectOfType(const std::string &name, H5O_type_t type) const {
 }
 
 ndsize_t H5Group::objectCount() const {
+    H5Lock lock;
     hsize_t n_objs;
     HErr res = H5Gget_num_objs(hid, &n_objs);
     res.check("Could not get object count");
@@ -124,12 +132,14 @@ boost::optional<DataSet> H5Group::findDataByAttribute(const std::string &attribu
 
 
 std::string H5Group::objectName(ndsize_t index) const {
+    H5Lock lock;
     // check if index valid
     if(index > objectCount()) {
         throw OutOfBounds("No object at given index",
 			              static_cast<size_t>(index));
     }
 
+    NIX_STAT(LinkName);
     std::string str_name;
     // check whether name is found by index
     H5_index_t index_type = H5_INDEX_CRT_ORDER;
@@ -174,12 +184,116 @@ std::string H5Group::objectName(ndsize_t index) const {
 }
 
 
+static herr_t collect_link_name(hid_t, const char *name, const H5L_info_t *, void *op_data) {
+    static_cast<std::vector<std::string> *>(op_data)->emplace_back(name);
+    return 0;
+}
+
+
+std::vector<std::string> H5Group::objectNames() const {
+    H5Lock lock;
+    NIX_STAT(LinkIterate);
+    std::vector<std::string> names;
+    HErr res = H5Literate(hid, H5_INDEX_NAME, H5_ITER_NATIVE, NULL, collect_link_name, &names);
+    res.check("objectNames: Could not iterate over the links of the group");
+    return names;
+}
+
+
+void H5Group::replaceLinks(const std::function<boost::optional<H5Group>(bool)> &group,
+                           const std::vector<std::string> &names,
+                           const std::function<boost::optional<H5Group>(size_t)> &resolve) {
+    boost::optional<H5Group> g = group(false);
+
+    // the existing links in creation order, which is the order of the index
+    std::vector<std::string> existing;
+    if (g) {
+        H5Lock lock;
+        NIX_STAT(LinkIterate);
+        HErr res = H5Literate(g->hid, H5_INDEX_CRT_ORDER, H5_ITER_INC, NULL, collect_link_name, &existing);
+        res.check("replaceLinks: Could not iterate over the links of the group");
+    }
+    std::unordered_map<std::string, size_t> position;
+    for (size_t i = 0; i < existing.size(); i++) {
+        position.emplace(existing[i], i);
+    }
+
+    // links are kept as long as the names follow them in order, new links
+    // can only go to the end
+    std::unordered_set<std::string> seen, kept;
+    std::vector<std::pair<std::string, H5Group>> added;
+    size_t last = 0;
+    for (size_t i = 0; i < names.size(); i++) {
+        const std::string &name = names[i];
+        if (!seen.insert(name).second) {
+            continue;
+        }
+
+        auto pos = position.find(name);
+        if (added.empty() && pos != position.end() && (kept.empty() || pos->second > last)) {
+            kept.insert(name);
+            last = pos->second;
+            continue;
+        }
+
+        boost::optional<H5Group> target;
+        if (pos != position.end()) {
+            target = g->openGroup(name, false);
+        } else {
+            target = resolve(i);
+        }
+        if (target) {
+            added.emplace_back(name, *target);
+        }
+    }
+
+    for (const auto &name : existing) {
+        if (kept.count(name) == 0) {
+            g->removeGroup(name);
+        }
+    }
+
+    if (!added.empty()) {
+        g = group(true);
+        for (const auto &link : added) {
+            g->createLink(link.second, link.first);
+        }
+    }
+}
+
+
+struct LinkSearch {
+    const std::unordered_set<haddr_t> &targets;
+    std::vector<std::string>          paths;
+};
+
+
+static herr_t collect_link_to(hid_t, const char *name, const H5L_info_t *info, void *op_data) {
+    LinkSearch *search = static_cast<LinkSearch *>(op_data);
+    if (info->type == H5L_TYPE_HARD && search->targets.count(info->u.address) > 0) {
+        search->paths.emplace_back(name);
+    }
+    return 0;
+}
+
+
+std::vector<std::string> H5Group::linksTo(const std::unordered_set<haddr_t> &targets) const {
+    H5Lock lock;
+    NIX_STAT(LinkIterate);
+    LinkSearch search{targets, {}};
+    HErr res = H5Lvisit(hid, H5_INDEX_NAME, H5_ITER_NATIVE, collect_link_to, &search);
+    res.check("linksTo: Could not visit the links below the group");
+    return search.paths;
+}
+
+
 bool H5Group::hasData(const std::string &name) const {
     return hasObject(name) && objectOfType(name, H5O_TYPE_DATASET);
 }
 
 
 void H5Group::removeData(const std::string &name) {
+    H5Lock lock;
     if (hasData(name)) {
         HErr res = H5Gunlink(hid, name.c_str());
         res.check("H5Group::removeData(): Could not unlink DataSet");
@@ -196,6 +310,7 @@ DataSet H5Group::createData(const std::string &name,
                             bool max_size_unlimited,
                             bool guess_chunks) const
 {
+    H5Lock lock;
     DataSpace space;
 
     if (size) {
@@ -233,6 +348,7 @@ DataSet H5Group::createData(const std::string &name,
             throw std::invalid_argument("Invalid compression flag!");
         }
     }
+    NIX_STAT(DataSetCreate);
     ds = H5Dcreate(hid,
                    name.c_str(),
                    fileType.h5id(),
@@ -246,7 +362,39 @@ DataSet H5Group::createData(const std::string &name,
 }
 
 
+DataSet H5Group::createContiguousData(const std::string &name,
+                                      const h5x::DataType &fileType,
+                                      const NDSize &size) const
+{
+    H5Lock lock;
+    // fixed size, no chunks: the data ends up in one block in the file
+    DataSpace space = DataSpace::create(size, false);
+
+    H5Object dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    dcpl.check("Could not create data creation plist");
+    HErr res = H5Pset_layout(dcpl.h5id(), H5D_CONTIGUOUS);
+    res.check("Could not set contiguous layout!");
+    // allocate right away so the data has an address in the file
+    res = H5Pset_alloc_time(dcpl.h5id(), H5D_ALLOC_TIME_EARLY);
+    res.check("Could not set allocation time!");
+
+    NIX_STAT(DataSetCreate);
+    DataSet ds = H5Dcreate(hid,
+                           name.c_str(),
+                           fileType.h5id(),
+                           space.h5id(),
+                           PList::linkUTF8().h5id(),
+                           dcpl.h5id(),
+                           H5P_DEFAULT);
+    ds.check("H5Group::createContiguousData: Could not create DataSet with name " + name);
+
+    return ds;
+}
+
+
 DataSet H5Group::openData(const std::string &name) const {
+    H5Lock lock;
+    NIX_STAT(DataSetOpen);
     DataSet ds = H5Dopen(hid, name.c_str(), H5P_DEFAULT);
     ds.check("H5Group::openData(): Could not open DataSet");
     return ds;
@@ -259,14 +407,17 @@ bool H5Group::hasGroup(const std::string &name) const {
 
 
 H5Group H5Group::openGroup(const std::string &name, bool create) const {
+    H5Lock lock;
     check_h5_arg_name(name);
 
     H5Group g;
 
     if (hasGroup(name)) {
+        NIX_STAT(GroupOpen);
         g = H5Group(H5Gopen(hid, name.c_str(), H5P_DEFAULT));
         g.check("H5Group::openGroup(): Could not open group: " + name);
     } else if (create) {
+        NIX_STAT(GroupCreate);
         H5Object gcpl = H5Pcreate(H5P_GROUP_CREATE);
         gcpl.check("Unable to create group with name '" + name + "'! (H5Pcreate)");
 
@@ -293,12 +444,14 @@ optGroup H5Group::openOptGroup(const std::string &name) {
 
 
 void H5Group::removeGroup(const std::string &name) {
+    H5Lock lock;
     if (hasGroup(name))
         H5Gunlink(hid, name.c_str());
 }
 
 
 void H5Group::renameGroup(const std::string &old_name, const std::string &new_name) {
+    H5Lock lock;
     check_h5_arg_name(new_name);
 
     if (hasGroup(old_name)) {
@@ -308,6 +461,7 @@ void H5Group::renameGroup(const std::string &old_name, const std::string &new_na
 
 
 H5Group H5Group::createLink(const H5Group &target, const std::string &link_name) {
+    H5Lock lock;
     check_h5_arg_name(link_name);
 
     HErr res = H5Lcreate_hard(target.hid, ".", hid, link_name.c_str(),
@@ -18,7 +18,9 @@
 
 #include <boost/optional.hpp>
 
+#include <functional>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace nix {
@@ -45,6 +47,43 @@ public:
     ndsize_t objectCount() const;
     std::string objectName(ndsize_t index) const;
 
+    /**
+     * @brief The names of all links in this group, in one pass.
+     *
+     * The order is the one of the name index.
+     */
+    std::vector<std::string> objectNames() const;
+
+    /**
+     * @brief Replace the links in a group by links with the given names.
+     *
+     * Afterwards the creation order of the links is the order of names.
+     * The links that already are in that order, from the first name on,
+     * are kept; all other links are removed and the names from the first
+     * one out of order on are linked again. Adding or removing names at
+     * either end thus only touches those. The existing links are listed
+     * once and resolve is only called for names that are not linked yet;
+     * it returns the group to link to or an unset optional to skip the
+     * name. All names are resolved before any link is changed.
+     *
+     * @param group     Opens the group with the links, creates it if the
+     *                  argument is true.
+     * @param names     The names of the links, duplicates are ignored.
+     * @param resolve   Looks up the target of the name at the given index.
+     */
+    static void replaceLinks(const std::function<boost::optional<H5Group>(bool)> &group,
+                             const std::vector<std::string> &names,
+                             const std::function<boost::optional<H5Group>(size_t)> &resolve);
+
+    /**
+     * @brief Replace the links in a group by links to the given entities,
+     *        named by their ids, see above.
+     */
+    template<typename T>
+    static void replaceLinks(const std::function<boost::optional<H5Group>(bool)> &group,
+                             const std::vector<T> &entities,
+                             const std::function<boost::optional<H5Group>(const T &)> &resolve);
+
     bool hasData(const std::string &name) const;
 
     DataSet createData(const std::string &name, const h5x::DataType &fileType,
@@ -52,6 +91,13 @@ public:
                        const NDSize &maxsize = {}, NDSize chunks = {},
                        bool maxSizeUnlimited = true, bool guessChunks = true) const;
 
+    /**
+     * @brief Create a data set of a fixed size, stored uncompressed in one
+     *        block that is allocated right away.
+     */
+    DataSet createContiguousData(const std::string &name, const h5x::DataType &fileType,
+                                 const NDSize &size) const;
+
     DataSet openData(const std::string &name) const;
     void removeData(const std::string &name);
 
@@ -150,6 +196,19 @@ public:
      */
     H5Group createLink(const H5Group &target, const std::string &link_name);
 
+    /**
+     * @brief Find all hard links below this group that point to one of the
+     *        given objects, in a single walk of the hierarchy.
+     *
+     * Every group below this one is visited once, even if it can be
+     * reached by several links.
+     *
+     * @param targets   The addresses of the objects, see {@link LocID::objectAddress}.
+     *
+     * @return The paths of the links, relative to this group.
+     */
+    std::vector<std::string> linksTo(const std::unordered_set<haddr_t> &targets) const;
+
     /**
      * @brief Removes all links to the object defined by the given name.
      *
@@ -176,6 +235,20 @@ private:
 
 //template functions
 
+template<typename T>
+void H5Group::replaceLinks(const std::function<boost::optional<H5Group>(bool)> &group,
+                           const std::vector<T> &entities,
+                           const std::function<boost::optional<H5Group>(const T &)> &resolve) {
+    std::vector<std::string> ids;
+    ids.reserve(entities.size());
+    for (const auto &entity : entities) {
+        ids.push_back(entity.id());
+    }
+
+    replaceLinks(group, ids, [&entities, &resolve](size_t index) { return resolve(entities[index]); });
+}
+
+
 template<typename T>
 void H5Group::setData(const std::string &name, const T &value, const Compression &compression)
 {
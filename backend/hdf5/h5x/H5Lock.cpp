@@ -0,0 +1,20 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "H5Lock.hpp"
+
+namespace nix {
+namespace hdf5 {
+
+std::recursive_mutex &H5Lock::mutex() {
+    static std::recursive_mutex lock;
+    return lock;
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,47 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_H5_LOCK_H
+#define NIX_H5_LOCK_H
+
+#include <nix/Platform.hpp>
+
+#include <mutex>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * Scoped lock that serializes the calls into the HDF5 library.
+ *
+ * Every wrapper that calls HDF5 functions holds it for the duration of
+ * those calls, which makes it safe to read from several threads through
+ * the same File. The lock is recursive, so wrappers may call each other.
+ * Work done outside of the wrappers, e.g. applying polynomials or unit
+ * conversion in the frontend, runs without it.
+ */
+class NIXAPI H5Lock {
+public:
+    H5Lock() {
+        mutex().lock();
+    }
+
+    H5Lock(const H5Lock &other) = delete;
+    H5Lock &operator=(const H5Lock &other) = delete;
+
+    ~H5Lock() {
+        mutex().unlock();
+    }
+
+    static std::recursive_mutex &mutex();
+};
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_H5_LOCK_H
@@ -20,17 +20,20 @@ PList::PList(hid_t hid) : H5Object(hid) { }
 PList::PList(const PList &other) : H5Object(other) { }
 
 PList PList::create(hid_t cls_id) {
+    H5Lock lock;
     PList pl = H5Pcreate(cls_id);
     pl.check("H5Pcreate: could not create property list");
     return pl;
 }
 
 void PList::charEncoding(H5T_cset_t encoding) {
+    H5Lock lock;
     HErr res = H5Pset_char_encoding(hid, encoding);
     res.check("Could not set character encoding on Property List");
 }
 
 H5T_cset_t PList::charEncoding() const {
+    H5Lock lock;
     H5T_cset_t encoding;
     HErr res = H5Pget_char_encoding(hid, &encoding);
     res.check("Could not get character encoding on Property List");
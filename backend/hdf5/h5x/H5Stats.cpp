@@ -0,0 +1,46 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "H5Stats.hpp"
+
+namespace nix {
+namespace hdf5 {
+
+StatCounters *statCounters() {
+    static StatCounters counters[static_cast<size_t>(StatOp::Count)] = {};
+    return counters;
+}
+
+static uint64_t selection_bytes(hid_t space, hid_t type) {
+    const hssize_t n = H5Sget_select_npoints(space);
+    return n > 0 ? static_cast<uint64_t>(n) * H5Tget_size(type) : 0;
+}
+
+void transferBytes(hid_t obj, hid_t mem_type, hid_t mem_space, hid_t file_space,
+                   uint64_t &mem_bytes, uint64_t &file_bytes) {
+    H5Lock lock;
+    const bool is_attr = H5Iget_type(obj) == H5I_ATTR;
+    const hid_t space = is_attr ? H5Aget_space(obj) : H5Dget_space(obj);
+    const hid_t type = is_attr ? H5Aget_type(obj) : H5Dget_type(obj);
+
+    if (space >= 0 && type >= 0) {
+        file_bytes = selection_bytes(file_space == H5S_ALL ? space : file_space, type);
+        mem_bytes = selection_bytes(mem_space == H5S_ALL ? (file_space == H5S_ALL ? space : file_space)
+                                                         : mem_space, mem_type);
+    }
+
+    if (space >= 0) {
+        H5Sclose(space);
+    }
+    if (type >= 0) {
+        H5Tclose(type);
+    }
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,95 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_H5_STATS_H
+#define NIX_H5_STATS_H
+
+#include <nix/Stats.hpp>
+
+#include "H5Exception.hpp"
+
+#include <atomic>
+#include <chrono>
+
+namespace nix {
+namespace hdf5 {
+
+struct StatCounters {
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> nanos;
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> file_bytes;
+};
+
+/*
+ * The counters of all operations; they only change if the library is built
+ * with NIX_STATS.
+ */
+StatCounters *statCounters();
+
+/*
+ * The bytes moved by a read or write of the dataset or attribute obj, in
+ * memory and in the file; H5S_ALL selects the whole data space.
+ */
+void transferBytes(hid_t obj, hid_t mem_type, hid_t mem_space, hid_t file_space,
+                   uint64_t &mem_bytes, uint64_t &file_bytes);
+
+#ifdef NIX_STATS
+
+/*
+ * Counts one call of op and the time until it goes out of scope.
+ */
+class StatScope {
+public:
+    explicit StatScope(StatOp op)
+        : counters(statCounters()[static_cast<size_t>(op)]), start(std::chrono::steady_clock::now()),
+          obj(-1), mem_type(-1), mem_space(-1), file_space(-1) { }
+
+    // the bytes are determined on the way out, outside of the timed part
+    void transfer(hid_t obj, hid_t mem_type, hid_t mem_space, hid_t file_space) {
+        this->obj = obj;
+        this->mem_type = mem_type;
+        this->mem_space = mem_space;
+        this->file_space = file_space;
+    }
+
+    ~StatScope() {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        counters.calls.fetch_add(1, std::memory_order_relaxed);
+        counters.nanos.fetch_add(static_cast<uint64_t>(ns), std::memory_order_relaxed);
+
+        if (obj >= 0) {
+            uint64_t mem = 0, file = 0;
+            transferBytes(obj, mem_type, mem_space, file_space, mem, file);
+            counters.bytes.fetch_add(mem, std::memory_order_relaxed);
+            counters.file_bytes.fetch_add(file, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    StatCounters                          &counters;
+    std::chrono::steady_clock::time_point start;
+    hid_t                                 obj, mem_type, mem_space, file_space;
+};
+
+#define NIX_STAT(op) nix::hdf5::StatScope nix_stat_scope_(nix::StatOp::op)
+#define NIX_STAT_TRANSFER(obj, mem_type, mem_space, file_space) \
+    nix_stat_scope_.transfer((obj), (mem_type), (mem_space), (file_space))
+
+#else
+
+#define NIX_STAT(op) do { } while (0)
+#define NIX_STAT_TRANSFER(obj, mem_type, mem_space, file_space) do { } while (0)
+
+#endif
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_H5_STATS_H
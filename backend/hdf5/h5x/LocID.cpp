@@ -10,6 +10,7 @@
 
 #include "LocID.hpp"
 #include "H5PList.hpp"
+#include "H5Stats.hpp"
 
 namespace nix {
 
@@ -25,23 +26,29 @@ LocID::LocID(const LocID &other) : H5Object(other) {}
 
 
 void LocID::linkInfo(const std::string &name, H5L_info_t &info) const {
+    H5Lock lock;
     HErr res = H5Lget_info(hid, name.c_str(), &info, H5P_DEFAULT);
     res.check("LocID::linkInfo(): H5Lget_info() failed");
 }
 
 bool LocID::hasAttr(const std::string &name) const {
+    H5Lock lock;
+    NIX_STAT(AttrExists);
     HTri res = H5Aexists(hid, name.c_str());
     return res.check("LocID.hasAttr() failed");
 }
 
 
 void LocID::removeAttr(const std::string &name) const {
+    H5Lock lock;
     HErr res = H5Adelete(hid, name.c_str());
     res.check("LocID::removeAttr(): could not delete attribute");
 }
 
 
 Attribute LocID::openAttr(const std::string &name) const {
+    H5Lock lock;
+    NIX_STAT(AttrOpen);
     Attribute attr = H5Aopen(hid, name.c_str(), H5P_DEFAULT);
     attr.check("LocID::openAttr: Could not open attribute " + name);
     return attr;
@@ -49,6 +56,8 @@ Attribute LocID::openAttr(const std::string &name) const {
 
 
 Attribute LocID::createAttr(const std::string &name, h5x::DataType fileType, const DataSpace &fileSpace) const {
+    H5Lock lock;
+    NIX_STAT(AttrCreate);
     PList acpl = PList::create(H5P_ATTRIBUTE_CREATE);
     acpl.charEncoding(H5T_CSET_UTF8);
 
@@ -64,17 +73,28 @@ Attribute LocID::createAttr(const std::string &name, h5x::DataType fileType, con
 
 
 void LocID::deleteLink(std::string name, hid_t plist) {
+    H5Lock lock;
     HErr res = H5Ldelete(hid, name.c_str(), plist);
     res.check("LocIDL::deleteLink: Could not delete link: " + name);
 }
 
 
 unsigned int LocID::referenceCount() const {
+    H5Lock lock;
     H5O_info_t oInfo;
     HErr res = H5Oget_info(hid, &oInfo);
     res.check("LocID:referenceCount: Coud not get object info");
     return oInfo.rc;
 }
+
+
+haddr_t LocID::objectAddress() const {
+    H5Lock lock;
+    H5O_info_t oInfo;
+    HErr res = H5Oget_info(hid, &oInfo);
+    res.check("LocID:objectAddress: Could not get object info");
+    return oInfo.addr;
+}
 } // nix::hdf5
 
 } // nix::
@@ -44,6 +44,8 @@ public:
 
     unsigned int referenceCount() const;
 
+    haddr_t objectAddress() const;
+
     LocID &operator=(const LocID &other) {
         H5Object::operator= (other);
         return *this;
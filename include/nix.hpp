@@ -13,6 +13,10 @@
 #include <nix/NDSize.hpp>
 #include <nix/Block.hpp>
 #include <nix/DataArray.hpp>
+#include <nix/MappedData.hpp>
+#include <nix/DataStatistics.hpp>
+#include <nix/DataPyramid.hpp>
+#include <nix/DataCursor.hpp>
 #include <nix/DataFrame.hpp>
 #include <nix/MultiTag.hpp>
 #include <nix/Dimensions.hpp>
@@ -24,3 +28,6 @@
 #include <nix/Source.hpp>
 #include <nix/Value.hpp>
 #include <nix/Compression.hpp>
+#include <nix/DataStorage.hpp>
+#include <nix/Stats.hpp>
+#include <nix/Catalog.hpp>
@@ -352,6 +352,9 @@ public:
     * @param data_type    A nix::DataType indicating the format to store values.
     * @param shape        A NDSize holding the extent of the array to create.
     * @param compression  En-/disable dataset compression, default nix::Compression::Auto.
+    * @param storage      Store the data in chunks or in one fixed-size block, see
+    *                     nix::DataStorage. Contiguous data is never compressed,
+    *                     whatever the compression of the file.
     *
     * @return The newly created data array.
     */
@@ -359,7 +362,8 @@ public:
                               const std::string &type,
                               nix::DataType      data_type,
                               const NDSize      &shape,
-                              const Compression &compression=Compression::Auto);
+                              const Compression &compression=Compression::Auto,
+                              const DataStorage &storage=DataStorage::Auto);
 
     /**
     * @brief Create a new data array associated with this block.
@@ -369,6 +373,8 @@ public:
     * @param data      Data to create array with.
     * @param data_type A optional nix::DataType indicating the format to store values.
     * @param compression  En-/disable dataset compression, default nix::Compression::Auto.
+    * @param storage      Store the data in chunks or in one fixed-size block, see
+    *                     nix::DataStorage.
     *
     * Create a data array with shape and type inferred from data. After
     * successful creation, the contents of data will be written to the
@@ -382,7 +388,8 @@ public:
                               const std::string &type,
                               const T &data,
                               DataType data_type=DataType::Nothing,
-                              const Compression &compression=Compression::Auto) {
+                              const Compression &compression=Compression::Auto,
+                              const DataStorage &storage=DataStorage::Auto) {
          const Hydra<const T> hydra(data);
 
          if (data_type == DataType::Nothing) {
@@ -390,7 +397,7 @@ public:
          }
 
          const NDSize shape = hydra.shape();
-         DataArray da = createDataArray(name, type, data_type, shape, compression);
+         DataArray da = createDataArray(name, type, data_type, shape, compression, storage);
 
          const NDSize offset(shape.size(), 0);
          da.setData(data, offset);
@@ -923,6 +930,81 @@ public:
         return backend()->removeEntity(group);
     }
 
+    /**
+     * @brief Deletes several entities of the block at once.
+     *
+     * All links to the entities within the block, e.g. the references of
+     * tags and multi tags, features and the members of groups, are found
+     * in a single pass over the block and removed together. This is much
+     * faster than deleting heavily referenced entities one by one. Root
+     * sources are deleted with all their child sources; entities that are
+     * not part of the block are ignored. The deletion can't be undone.
+     * The file system back-end does not keep track of links, it deletes
+     * the entities one by one and only returns their own paths.
+     *
+     * @param entities  The entities to delete, e.g. {data_array, tag}.
+     *
+     * @return The paths of the links that were removed, relative to the block.
+     */
+    std::vector<std::string> deleteEntities(const std::vector<nix::Identity> &entities) {
+        return backend()->removeEntities(entities);
+    }
+
+    //--------------------------------------------------
+    // Methods for copying entities
+    //--------------------------------------------------
+
+    /**
+     * @brief Copy a data array into this block.
+     *
+     * The data array may be part of this or another block, also of another
+     * file. The copy and everything it owns, e.g. its dimensions, get new
+     * ids. The data is copied chunk by chunk as it is stored, without
+     * decompressing it or loading the whole array into memory.
+     *
+     * Links to other entities are kept consistent: sources, and the data
+     * arrays a tag references, are looked up by name in this block and
+     * copied into it if they are missing. Metadata sections of the same file
+     * stay linked; sections of another file are linked to the top level
+     * section of the same name in this file, or copied there if there is
+     * none, see {@link File::copyBlock}.
+     *
+     * @param source  The data array to copy.
+     * @param name    The name of the copy, the name of the source if empty.
+     *
+     * @return The copy of the data array.
+     *
+     * @throws nix::UnsupportedOperation If the block uses the file system
+     *         back-end, which can not copy entities; this holds for all
+     *         copy methods of the block.
+     */
+    DataArray copyDataArray(const DataArray &source, const std::string &name = "");
+
+    /**
+     * @brief Copy a data frame into this block, see {@link copyDataArray}.
+     */
+    DataFrame copyDataFrame(const DataFrame &source, const std::string &name = "");
+
+    /**
+     * @brief Copy a tag with its features into this block, see {@link copyDataArray}.
+     */
+    Tag copyTag(const Tag &source, const std::string &name = "");
+
+    /**
+     * @brief Copy a multi tag with its features into this block, see {@link copyDataArray}.
+     */
+    MultiTag copyMultiTag(const MultiTag &source, const std::string &name = "");
+
+    /**
+     * @brief Copy a source with its child sources into this block, see {@link copyDataArray}.
+     */
+    Source copySource(const Source &source, const std::string &name = "");
+
+    /**
+     * @brief Copy a group into this block, see {@link copyDataArray}.
+     */
+    Group copyGroup(const Group &source, const std::string &name = "");
+
     //------------------------------------------------------
     // Operators and other functions
     //------------------------------------------------------
@@ -0,0 +1,228 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_CATALOG_H
+#define NIX_CATALOG_H
+
+#include <nix/DataType.hpp>
+#include <nix/NDSize.hpp>
+#include <nix/ObjectType.hpp>
+#include <nix/Platform.hpp>
+#include <nix/Variant.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace nix {
+
+class File;
+
+/**
+ * @brief The summary of one entity in a {@link Catalog}.
+ */
+struct NIXAPI CatalogEntry {
+    std::string file;      //!< the location of the file the entity is in
+    std::string block;     //!< the id of the block of the entity, empty for blocks
+    ObjectType  kind;      //!< Block, DataArray, DataFrame, Tag, MultiTag, Group or Source
+    std::string id;        //!< the id of the entity
+    std::string name;      //!< the name of the entity
+    std::string type;      //!< the type of the entity
+    DataType    dtype;     //!< the data type of a DataArray, DataType::Nothing otherwise
+    NDSize      extent;    //!< the extent of a DataArray, the rows of a DataFrame
+    std::string metadata;  //!< the id of the linked section, empty if there is none
+};
+
+
+/**
+ * @brief A searchable summary of the entities of many NIX files.
+ *
+ * The catalog keeps the blocks, data arrays, data frames, tags, multi
+ * tags, groups and sources of a set of files together with the properties
+ * of the sections they link as metadata. It can be saved to a single
+ * index file and loaded again, so that a whole archive can be searched
+ * without opening any of the original files:
+ *
+ * ~~~
+ * Catalog catalog = Catalog::build(paths);
+ * catalog.save("archive.nixcat");
+ *
+ * Catalog index = Catalog::load("archive.nixcat");
+ * for (const CatalogEntry &e : index.find("subject", "X", ObjectType::DataArray)) {
+ *     std::cout << e.file << ": " << e.name << std::endl;
+ * }
+ * ~~~
+ *
+ * Property values are kept as text: strings as they are, booleans as
+ * "true" or "false" and numbers in their shortest exact decimal form.
+ */
+class NIXAPI Catalog {
+
+public:
+
+    /**
+     * @brief Create an empty catalog.
+     */
+    Catalog() { }
+
+    /**
+     * @brief Build the catalog of a list of files.
+     *
+     * The files are opened read-only with {@link File::open} on a pool of
+     * threads and all their entities are walked. Files that cannot be
+     * opened are recorded with the reason in {@link errors} and do not
+     * contribute entries.
+     *
+     * @param files     The paths of the files.
+     * @param threads   The number of threads, 0 to use one per core.
+     *
+     * @return The catalog, with the files in the given order.
+     */
+    static Catalog build(const std::vector<std::string> &files, size_t threads = 0);
+
+    /**
+     * @brief Bring the catalog up to date with a list of files.
+     *
+     * Files whose size and modification time did not change since they
+     * were scanned are kept as they are, new or changed files are scanned
+     * again and files that are not in the list are dropped.
+     *
+     * @param files     The paths of the files.
+     * @param threads   The number of threads, 0 to use one per core.
+     *
+     * @return The number of files that were scanned.
+     */
+    size_t update(const std::vector<std::string> &files, size_t threads = 0);
+
+    /**
+     * @brief Add the entities of an open file.
+     *
+     * An entry of a file with the same location is replaced.
+     */
+    void add(const File &file);
+
+    /**
+     * @brief Load a catalog from an index file written by {@link save}.
+     */
+    static Catalog load(const std::string &path);
+
+    /**
+     * @brief Write the catalog to an index file.
+     *
+     * The catalog is written to a temporary file next to it first, which
+     * then replaces the index file, so an index file is always complete.
+     */
+    void save(const std::string &path) const;
+
+    /**
+     * @brief The locations of the files in the catalog.
+     */
+    std::vector<std::string> files() const;
+
+    /**
+     * @brief The files that could not be scanned and why.
+     */
+    std::map<std::string, std::string> errors() const;
+
+    /**
+     * @brief The number of entities in the catalog.
+     */
+    size_t size() const {
+        return records.size();
+    }
+
+    /**
+     * @brief All entities in the catalog.
+     */
+    std::vector<CatalogEntry> entries() const;
+
+    /**
+     * @brief The entities whose metadata has a property with a given value.
+     *
+     * The properties of the linked section and of all its subsections are
+     * searched.
+     *
+     * @param property  The name of the property.
+     * @param value     The value one of the values of the property must equal.
+     * @param kind      Only return entities of this kind, ObjectType::Unknown
+     *                  returns all kinds.
+     */
+    std::vector<CatalogEntry> find(const std::string &property, const std::string &value,
+                                   ObjectType kind = ObjectType::Unknown) const;
+
+    /**
+     * @brief Same as {@link find}, for a value of any type.
+     */
+    std::vector<CatalogEntry> find(const std::string &property, const Variant &value,
+                                   ObjectType kind = ObjectType::Unknown) const;
+
+    /**
+     * @brief The entities for which a filter returns true.
+     */
+    std::vector<CatalogEntry> find(const std::function<bool(const CatalogEntry &)> &filter) const;
+
+    /**
+     * @brief The properties of the metadata of an entity, including those of
+     *        all subsections of the linked section.
+     *
+     * @return The values of each property by name.
+     */
+    std::multimap<std::string, std::vector<std::string>> metadata(const CatalogEntry &entry) const;
+
+    /**
+     * @brief The text a property value is kept as in the catalog.
+     */
+    static std::string valueString(const Variant &value);
+
+private:
+
+    struct FileRecord {
+        std::string location;
+        uint64_t    size;
+        int64_t     mtime;
+        std::string error;
+    };
+
+    struct SectionRecord {
+        uint32_t    file;
+        std::string id;
+        std::vector<std::pair<std::string, std::vector<std::string>>> properties;
+    };
+
+    struct Record {
+        uint32_t    file;
+        uint32_t    section;
+        ObjectType  kind;
+        std::string block;
+        std::string id;
+        std::string name;
+        std::string type;
+        DataType    dtype;
+        NDSize      extent;
+    };
+
+    static const uint32_t no_section = 0xffffffff;
+
+    void merge(Catalog &&other);
+    // drop the files that are not kept with their sections and records, in one pass
+    void keepFiles(const std::vector<bool> &keep);
+    CatalogEntry entry(const Record &record) const;
+
+    static Catalog scan(const std::string &location);
+    static std::vector<Catalog> scan(const std::vector<std::string> &locations, size_t threads);
+
+    std::vector<FileRecord>    file_records;
+    std::vector<SectionRecord> sections;
+    std::vector<Record>        records;
+};
+
+} // namespace nix
+
+#endif // NIX_CATALOG_H
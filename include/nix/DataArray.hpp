@@ -535,6 +535,15 @@ public:
         backend()->read(dtype, data, count, offset);
     }
 
+    void getDataDirect(DataType dtype,
+                       void *data,
+                       const NDSize &count,
+                       const NDSize &offset,
+                       const NDSize &stride,
+                       const NDSize &block) const {
+        backend()->read(dtype, data, count, offset, stride, block);
+    }
+
     void setDataDirect(DataType dtype,
                        const void *data,
                        const NDSize &count,
@@ -543,6 +552,213 @@ public:
         backend()->write(dtype, data, count, offset);
     }
 
+    /**
+     * @brief Map the data of the DataArray read-only into memory.
+     *
+     * Instead of copying the data into a buffer, the byte range holding
+     * the data is mapped straight from the file. Pages are only read when
+     * they are accessed and are shared with other processes mapping the
+     * same file. This requires the data to be stored in one uncompressed
+     * block, i.e. the DataArray must have been created with
+     * {@link nix::DataStorage::Contiguous}.
+     *
+     * ~~~
+     * DataArray da = block.createDataArray("raw", "nix.sampled", DataType::Int16, {64, 1000000},
+     *                                      Compression::None, DataStorage::Contiguous);
+     * ...
+     * MappedData view = da.mappedData();
+     * const int16_t *samples = view.data<int16_t>();
+     * ~~~
+     *
+     * The view stays valid as long as the file is open.
+     *
+     * @return A read-only view on the data.
+     */
+    MappedData mappedData() const {
+        return backend()->mappedData();
+    }
+
+    /**
+     * @brief Get the size of the chunks the data is stored in.
+     *
+     * Reads that are aligned to chunk boundaries avoid decompressing or
+     * reading chunks more than once.
+     *
+     * @return The chunk size, empty if the data is not stored in chunks.
+     */
+    NDSize dataChunks() const {
+        return backend()->dataChunks();
+    }
+
+    /**
+     * @brief Build an index of the min, max, sum and count of the values
+     *        in every chunk of the data.
+     *
+     * The index is stored next to the data and kept up to date by
+     * {@link setData}, {@link appendData} and {@link dataExtent}. It lets
+     * {@link statistics} answer for large regions reading only the chunks
+     * at the edges of the region. Only numeric data has statistics.
+     */
+    void createStatistics() {
+        backend()->createStatistics();
+    }
+
+    /**
+     * @brief Whether the data has an index of per chunk statistics.
+     *
+     * @return True if {@link createStatistics} was called.
+     */
+    bool hasStatistics() const {
+        return backend()->hasStatistics();
+    }
+
+    /**
+     * @brief Remove the index of per chunk statistics.
+     *
+     * @return True if there was an index.
+     *
+     * @throws nix::UnsupportedOperation In FileMode::SwmrWrite, nothing can
+     *         be removed from the file.
+     */
+    bool deleteStatistics() {
+        return backend()->deleteStatistics();
+    }
+
+    /**
+     * @brief Get the min, max, sum and count of the stored values in a
+     *        region of the data.
+     *
+     * Without an index of per chunk statistics the whole region is read.
+     * The polynomial and expansion origin are not applied.
+     *
+     * ~~~
+     * da.createStatistics();
+     * ...
+     * DataStatistics stats = da.statistics({0, 30000}, {64, 300000});
+     * double range = stats.max - stats.min;
+     * ~~~
+     *
+     * @param offset    The start of the region.
+     * @param count     The size of the region.
+     *
+     * @return The statistics of the region.
+     */
+    DataStatistics statistics(const NDSize &offset, const NDSize &count) const;
+
+    /**
+     * @brief Get the min, max, sum and count of all stored values.
+     *
+     * @return The statistics of the data.
+     */
+    DataStatistics statistics() const {
+        const NDSize extent = dataExtent();
+        return statistics(NDSize(extent.size(), 0), extent);
+    }
+
+    /**
+     * @brief Build a min/max decimation pyramid of the 1-d data.
+     *
+     * Every level holds the smallest and largest value of bins of factor
+     * samples, so that long signals can be plotted without reading all of
+     * them, see {@link envelope}. The data is read in blocks, which are
+     * processed on several threads. Any change of the data removes the
+     * pyramid, build it again once the data is complete. In
+     * FileMode::SwmrWrite, where nothing can be removed from the file, the
+     * pyramid is marked stale instead; it then counts as missing and
+     * {@link deletePyramid} removes it once the file is opened without SWMR.
+     *
+     * ~~~
+     * PyramidOptions opts;
+     * opts.factors = {16, 256, 4096};
+     * da.createPyramid(opts);
+     * ~~~
+     *
+     * @param options   The factors of the levels, each a multiple of the one
+     *                  before, and the number of threads.
+     */
+    void createPyramid(const PyramidOptions &options = PyramidOptions()) {
+        backend()->createPyramid(options);
+    }
+
+    /**
+     * @brief Whether the data has a min/max decimation pyramid.
+     *
+     * @return True if {@link createPyramid} was called since the data
+     *         was last changed.
+     */
+    bool hasPyramid() const {
+        return backend()->hasPyramid();
+    }
+
+    /**
+     * @brief Remove the min/max decimation pyramid.
+     *
+     * @return True if there was a pyramid.
+     *
+     * @throws nix::UnsupportedOperation In FileMode::SwmrWrite, nothing can
+     *         be removed from the file.
+     */
+    bool deletePyramid() {
+        return backend()->deletePyramid();
+    }
+
+    /**
+     * @brief Get the factors of the levels of the pyramid.
+     *
+     * @return The samples per bin of every level, empty if there is no
+     *         pyramid.
+     */
+    std::vector<ndsize_t> pyramidFactors() const {
+        return backend()->pyramidFactors();
+    }
+
+    /**
+     * @brief Get the min/max envelope of a range of 1-d data for a plot of
+     *        the given width.
+     *
+     * The coarsest level of the pyramid that still has at least pixels
+     * bins in the range is read; if there is none, the samples themselves
+     * are returned with a factor of 1. The bins cover the range and may
+     * start before it. The values are stored values, the polynomial and
+     * expansion origin are not applied.
+     *
+     * @param pixels    The number of bins the caller needs at least.
+     * @param offset    The index of the first sample of the range.
+     * @param count     The number of samples in the range.
+     *
+     * @return The envelope of the range.
+     */
+    DataEnvelope envelopeByIndex(size_t pixels, ndsize_t offset, ndsize_t count) const;
+
+    /**
+     * @brief Get the min/max envelope of the data between two positions of
+     *        its {@link SampledDimension}.
+     *
+     * ~~~
+     * // 10 seconds of a 30 kHz signal on 800 pixels
+     * DataEnvelope env = da.envelope(800, 120.0, 130.0);
+     * double t0 = env.offset * dim.samplingInterval();
+     * ~~~
+     *
+     * @param pixels    The number of bins the caller needs at least.
+     * @param start     The start of the range, including it.
+     * @param end       The end of the range, including it.
+     *
+     * @return The envelope of the range, empty if it holds no samples.
+     */
+    DataEnvelope envelope(size_t pixels, double start, double end) const;
+
+    /**
+     * @brief Reload the extent of the data from the file.
+     *
+     * A file opened in FileMode::SwmrRead keeps the extent of the data
+     * it has seen; call this to pick up data that the writer appended
+     * since.
+     */
+    void refresh() {
+        backend()->refresh();
+    }
+
 
     /**
      * @brief Get the extent of the data of the DataArray entity.
@@ -571,6 +787,20 @@ public:
         return backend()->dataType();
     }
 
+    /**
+     * @brief Append data to the DataArray along the given axis.
+     *
+     * The extent of the data must match the one of the DataArray along
+     * all other axes. In FileMode::SwmrWrite the appended data is flushed
+     * to the file right away, so that readers see it after a
+     * {@link refresh}. Readers may see the new extent shortly before the
+     * data, the elements then read as the fill value (zero).
+     *
+     * @param dtype     The type of the data.
+     * @param data      Pointer to the data.
+     * @param count     The extent of the data.
+     * @param axis      The axis to append the data to.
+     */
     void appendData(DataType dtype, const void *data, const NDSize &count, size_t axis);
 
     //--------------------------------------------------
@@ -606,6 +836,13 @@ protected:
                 const NDSize &count,
                 const NDSize &offset) const;
 
+    void ioRead(DataType dtype,
+                void *data,
+                const NDSize &count,
+                const NDSize &offset,
+                const NDSize &stride,
+                const NDSize &block) const;
+
     void ioWrite(DataType dtype,
                  const void *data,
                  const NDSize &count,
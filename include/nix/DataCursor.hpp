@@ -0,0 +1,218 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DATA_CURSOR_H
+#define NIX_DATA_CURSOR_H
+
+#include <nix/DataArray.hpp>
+#include <nix/DataView.hpp>
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Reads the data of a DataArray or a DataView block by block.
+ *
+ * The data is split along one axis into blocks of a number of slices
+ * each; every block covers the whole extent of the data along all other
+ * axes. The blocks are read into two buffers that are allocated once
+ * and reused, so arrays much larger than the memory can be streamed
+ * through with a fixed memory footprint:
+ *
+ * ~~~
+ * DataCursor<float> cursor(data_array);
+ * while (cursor.next()) {
+ *     process(cursor.data(), cursor.shape(), cursor.offset());
+ * }
+ * ~~~
+ *
+ * With prefetching enabled, the block following the current one is read
+ * on a background thread while the current one is processed, see
+ * {@link File} on reading from several threads. The file should not be
+ * modified while the cursor is in use. The data returned by {@link data}
+ * is valid until the next call to {@link next}.
+ */
+template<typename T>
+class DataCursor {
+public:
+
+    /**
+     * @brief Cursor over a DataArray.
+     *
+     * @param array     The DataArray to read.
+     * @param axis      The axis along which the data is split into blocks.
+     * @param slices    Number of slices of each block along axis, 0 picks a
+     *                  size of about 8 MiB that is a multiple of the chunks
+     *                  the data is stored in.
+     * @param prefetch  Read the next block on a background thread.
+     */
+    DataCursor(const DataArray &array, size_t axis = 0, ndsize_t slices = 0, bool prefetch = false)
+        : DataCursor(std::make_shared<DataArray>(array), array.dataChunks(), axis, slices, prefetch) { }
+
+    /**
+     * @brief Cursor over a DataView, see {@link DataCursor(const DataArray&, size_t, ndsize_t, bool)}.
+     */
+    DataCursor(const DataView &view, size_t axis = 0, ndsize_t slices = 0, bool prefetch = false)
+        : DataCursor(std::make_shared<DataView>(view), NDSize{}, axis, slices, prefetch) { }
+
+    DataCursor(const DataCursor &other) = delete;
+    DataCursor &operator=(const DataCursor &other) = delete;
+
+    ~DataCursor() {
+        if (pending.valid()) {
+            pending.wait();
+        }
+    }
+
+    /**
+     * @brief Advance to the next block.
+     *
+     * @return False if there are no more blocks.
+     */
+    bool next() {
+        if (position >= extent[axis]) {
+            return false;
+        }
+
+        const int idx = current ^ 1;
+        if (pending.valid()) {
+            pending.get();
+        } else {
+            fill(idx, position);
+        }
+
+        current = idx;
+        start = position;
+        position += shapes[current][axis];
+
+        if (prefetch && position < extent[axis]) {
+            const int nidx = current ^ 1;
+            const ndsize_t nstart = position;
+            pending = std::async(std::launch::async, [this, nidx, nstart] { fill(nidx, nstart); });
+        }
+        return true;
+    }
+
+    /**
+     * @brief Start over at the first block.
+     */
+    void rewind() {
+        if (pending.valid()) {
+            pending.wait();
+            pending = std::future<void>();
+        }
+        position = 0;
+        start = 0;
+    }
+
+    /**
+     * @brief The elements of the current block in row-major order.
+     */
+    const T *data() const {
+        return buffers[current].data();
+    }
+
+    /**
+     * @brief The number of elements of the current block.
+     */
+    size_t size() const {
+        return static_cast<size_t>(shapes[current].nelms());
+    }
+
+    /**
+     * @brief The shape of the current block.
+     */
+    NDSize shape() const {
+        return shapes[current];
+    }
+
+    /**
+     * @brief The position of the first element of the current block.
+     */
+    NDSize offset() const {
+        NDSize off(extent.size(), 0);
+        off[axis] = start;
+        return off;
+    }
+
+    /**
+     * @brief The number of slices of a full block.
+     */
+    ndsize_t blockSlices() const {
+        return slices;
+    }
+
+private:
+
+    DataCursor(const std::shared_ptr<DataSet> &source, const NDSize &chunks, size_t axis,
+               ndsize_t slices, bool prefetch)
+        : source(source), extent(source->dataExtent()), axis(axis), slices(slices), prefetch(prefetch),
+          current(0), position(0), start(0) {
+
+        if (axis >= extent.size()) {
+            throw OutOfBounds("DataCursor: axis exceeds the dimensionality of the data", axis);
+        }
+
+        ndsize_t slice_elms = 1;
+        for (size_t i = 0; i < extent.size(); i++) {
+            if (i != axis) {
+                slice_elms *= extent[i];
+            }
+        }
+
+        if (this->slices == 0) {
+            const ndsize_t slice_bytes = std::max<ndsize_t>(slice_elms * sizeof(T), 1);
+            this->slices = std::max<ndsize_t>(default_bytes / slice_bytes, 1);
+            if (chunks.size() == extent.size() && chunks[axis] > 0) {
+                const ndsize_t c = chunks[axis];
+                this->slices = std::max(c, this->slices / c * c);
+            }
+        }
+        this->slices = std::max<ndsize_t>(std::min(this->slices, extent[axis]), 1);
+
+        const size_t capacity = static_cast<size_t>(this->slices * slice_elms);
+        buffers[0].reserve(capacity);
+        buffers[1].reserve(capacity);
+        shapes[0] = shapes[1] = NDSize(extent.size(), 0);
+    }
+
+    void fill(int idx, ndsize_t first) {
+        NDSize count(extent);
+        count[axis] = std::min(slices, extent[axis] - first);
+        NDSize off(extent.size(), 0);
+        off[axis] = first;
+
+        buffers[idx].resize(static_cast<size_t>(count.nelms()));
+        source->getData(to_data_type<T>::value, buffers[idx].data(), count, off);
+        shapes[idx] = count;
+    }
+
+    static const ndsize_t default_bytes = 8 * 1024 * 1024;
+
+    std::shared_ptr<DataSet> source;
+    NDSize                   extent;
+    size_t                   axis;
+    ndsize_t                 slices;
+    bool                     prefetch;
+
+    std::vector<T>           buffers[2];
+    NDSize                   shapes[2];
+    int                      current;
+    ndsize_t                 position;
+    ndsize_t                 start;
+    std::future<void>        pending;
+};
+
+} // namespace nix
+
+#endif // NIX_DATA_CURSOR_H
@@ -0,0 +1,50 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DATA_PYRAMID_H
+#define NIX_DATA_PYRAMID_H
+
+#include <nix/Platform.hpp>
+#include <nix/types.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief The options of {@link DataArray::createPyramid}.
+ */
+struct NIXAPI PyramidOptions {
+    std::vector<ndsize_t> factors;  //!< the samples per bin of every level, each a multiple of the one before
+    size_t                threads;  //!< the threads that build the levels, 0 for one per core
+
+    PyramidOptions() : factors({16, 256, 4096}), threads(0) { }
+};
+
+
+/**
+ * @brief The min/max envelope of a range of 1-d data, see
+ *        {@link DataArray::envelope}.
+ *
+ * Bin i holds the smallest and largest value of the samples
+ * [offset + i * factor, offset + (i + 1) * factor), the last bin may hold
+ * fewer samples. With a factor of 1 min and max are the samples themselves.
+ */
+struct NIXAPI DataEnvelope {
+    ndsize_t            factor;  //!< the samples per bin
+    ndsize_t            offset;  //!< the index of the first sample of the first bin
+    std::vector<double> min;     //!< the smallest value of every bin, NaN if there is none
+    std::vector<double> max;     //!< the largest value of every bin, NaN if there is none
+
+    DataEnvelope() : factor(1), offset(0) { }
+};
+
+} // namespace nix
+
+#endif // NIX_DATA_PYRAMID_H
@@ -13,10 +13,15 @@
 #define NIX_DATA_IO_H
 
 #include <nix/Dimensions.hpp>
+#include <nix/Exception.hpp>
 #include <nix/Hydra.hpp>
 
 #include <nix/Platform.hpp>
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 namespace nix {
 
 class NIXAPI DataSet {
@@ -31,6 +36,28 @@ public:
 
     template<typename T> void setData(const T &value, const NDSize &offset);
 
+    /**
+     * @brief Read a strided selection of the data.
+     *
+     * Reads count blocks of block elements each along every dimension,
+     * starting at offset, with the starts of two blocks stride elements
+     * apart. An empty stride or block means 1 along all dimensions, so
+     * reading every 30th sample of a 1-d signal is
+     * `getData(value, {n}, {0}, {30})`. value is resized to count * block.
+     */
+    template<typename T> void getData(T &value, const NDSize &count, const NDSize &offset,
+                                      const NDSize &stride, const NDSize &block = {}) const;
+
+    /**
+     * @brief Minimum and maximum of each of bins equally sized bins of 1-d data.
+     *
+     * Covers count elements starting at offset, count = 0 means up to the end
+     * of the data. The data is read in pieces of bounded size, which makes
+     * this suitable to prepare plots of long signals with few pixels.
+     */
+    template<typename T> void getDataMinMax(std::vector<T> &min, std::vector<T> &max, ndsize_t bins,
+                                            ndsize_t offset = 0, ndsize_t count = 0) const;
+
 
     void getData(DataType dtype,
                          void *data,
@@ -39,6 +66,15 @@ public:
         ioRead(dtype, data, count, offset);
     }
 
+    void getData(DataType dtype,
+                 void *data,
+                 const NDSize &count,
+                 const NDSize &offset,
+                 const NDSize &stride,
+                 const NDSize &block = {}) const {
+        ioRead(dtype, data, count, offset, stride, block);
+    }
+
     void setData(DataType dtype,
                          const void *data,
                          const NDSize &count,
@@ -60,6 +96,13 @@ protected:
                         const NDSize &count,
                         const NDSize &offset) const = 0;
 
+    virtual void ioRead(DataType dtype,
+                        void *data,
+                        const NDSize &count,
+                        const NDSize &offset,
+                        const NDSize &stride,
+                        const NDSize &block) const = 0;
+
     virtual void ioWrite(DataType dtype,
                          const void *data,
                          const NDSize &count,
@@ -116,6 +159,87 @@ void DataSet::getData(T &value, const NDSize &offset) const
     getData(dtype, hydra.data(), count, offset);
 }
 
+template<typename T>
+void DataSet::getData(T &value, const NDSize &count, const NDSize &offset,
+                      const NDSize &stride, const NDSize &block) const
+{
+    Hydra<T> hydra(value);
+    DataType dtype = hydra.element_data_type();
+
+    hydra.resize(block ? count * block : count);
+    getData(dtype, hydra.data(), count, offset, stride, block);
+}
+
+template<typename T>
+void DataSet::getDataMinMax(std::vector<T> &min, std::vector<T> &max, ndsize_t bins,
+                            ndsize_t offset, ndsize_t count) const
+{
+    static_assert(std::is_arithmetic<T>::value, "getDataMinMax needs an arithmetic type");
+
+    const NDSize extent = dataExtent();
+    if (extent.size() != 1) {
+        throw InvalidRank("getDataMinMax is only supported for 1-d data");
+    }
+    if (offset > extent[0]) {
+        throw OutOfBounds("getDataMinMax: offset is out of bounds", offset);
+    }
+    if (count == 0) {
+        count = extent[0] - offset;
+    } else if (offset + count > extent[0]) {
+        throw OutOfBounds("getDataMinMax: offset + count is out of bounds", offset + count);
+    }
+
+    bins = std::min(bins, count);
+    min.resize(bins);
+    max.resize(bins);
+    if (bins == 0) {
+        return;
+    }
+
+    // bin i covers [bin_start(i), bin_start(i + 1)), none of them is empty
+    auto bin_start = [offset, count, bins](ndsize_t i) {
+        return offset + (i * count) / bins;
+    };
+
+    const ndsize_t batch = 1 << 16;
+    const ndsize_t end = offset + count;
+    const DataType dtype = to_data_type<T>::value;
+    std::vector<T> buffer;
+
+    ndsize_t bin = 0;
+    ndsize_t bin_end = bin_start(1);
+    bool fresh = true;
+
+    for (ndsize_t pos = offset; pos < end; ) {
+        const ndsize_t n = std::min(batch, end - pos);
+        buffer.resize(n);
+        getData(dtype, buffer.data(), NDSize({n}), NDSize({pos}));
+
+        for (ndsize_t i = 0; i < n; ) {
+            const ndsize_t stop = std::min(n, bin_end - pos);
+            auto mm = std::minmax_element(buffer.begin() + i, buffer.begin() + stop);
+
+            if (fresh) {
+                min[bin] = *mm.first;
+                max[bin] = *mm.second;
+                fresh = false;
+            } else {
+                min[bin] = std::min(min[bin], *mm.first);
+                max[bin] = std::max(max[bin], *mm.second);
+            }
+
+            i = stop;
+            if (pos + i == bin_end) {
+                bin++;
+                bin_end = bin_start(bin + 1);
+                fresh = true;
+            }
+        }
+
+        pos += n;
+    }
+}
+
 
 template<typename T>
 void DataSet::setData(const T &value, const NDSize &offset)
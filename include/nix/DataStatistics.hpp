@@ -0,0 +1,45 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DATA_STATISTICS_H
+#define NIX_DATA_STATISTICS_H
+
+#include <nix/Platform.hpp>
+#include <nix/types.hpp>
+
+#include <limits>
+
+namespace nix {
+
+/**
+ * @brief Summary statistics of a region of the data of a DataArray, see
+ *        {@link DataArray::statistics}.
+ *
+ * NaN values count and make the sum NaN but are skipped by min and max.
+ */
+struct NIXAPI DataStatistics {
+    double   min;    //!< the smallest value, NaN if there is none
+    double   max;    //!< the largest value, NaN if there is none
+    double   sum;    //!< the sum of all values
+    ndsize_t count;  //!< the number of values
+
+    DataStatistics()
+        : min(std::numeric_limits<double>::quiet_NaN()), max(std::numeric_limits<double>::quiet_NaN()),
+          sum(0), count(0) { }
+
+    /**
+     * @brief The mean of the values, NaN if there are none.
+     */
+    double mean() const {
+        return count ? sum / static_cast<double>(count) : std::numeric_limits<double>::quiet_NaN();
+    }
+};
+
+} // namespace nix
+
+#endif // NIX_DATA_STATISTICS_H
@@ -0,0 +1,31 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+#ifndef NIX_DATA_STORAGE_H
+#define NIX_DATA_STORAGE_H
+
+namespace nix {
+
+/**
+ * @brief How the data of a DataArray is laid out in the file.
+ *
+ * Chunked data can grow and be compressed. Contiguous data is stored
+ * uncompressed in one fixed-size block, which allows it to be memory-mapped
+ * (see DataArray::mappedData), but it can not be resized anymore.
+ *
+ * Auto stores new data in chunks and keeps the storage of existing data
+ * when a file is repacked.
+ */
+enum class DataStorage {
+    Auto = 0,
+    Chunked,
+    Contiguous
+};
+
+}
+
+#endif // NIX_DATA_STORAGE_H
@@ -13,6 +13,8 @@
 
 #include <nix/DataArray.hpp>
 
+#include <memory>
+
 namespace nix {
 
 class NIXAPI DataView : public DataSet {
@@ -20,13 +22,14 @@ public:
     DataView(DataArray da, NDSize count, NDSize offset)
             : array(std::move(da)), offset(std::move(offset)), count(std::move(count)) {
 
-        if (this->offset.size() != array.dataExtent().size()) {
+        const NDSize extent = array.dataExtent();
+        if (this->offset.size() != extent.size()) {
             throw IncompatibleDimensions("DataView offset dimensionality does not match dimensionality of data", "nix::DataView");
         }
-        if (this->count.size() != array.dataExtent().size()) {
+        if (this->count.size() != extent.size()) {
             throw IncompatibleDimensions("DataView count dimensionality does not match dimensionality of data", "nix::DataView");
         }
-        if (this->offset + this->count > array.dataExtent()) {
+        if (this->offset + this->count > extent) {
             throw OutOfBounds("Trying to create DataView which is out of bounds");
         }
     }
@@ -36,12 +39,56 @@ public:
     virtual NDSize dataExtent() const;
     virtual DataType dataType() const;
 
+    /**
+     * @brief Counters of the read-ahead buffer.
+     */
+    struct ReadAheadStats {
+        size_t hits;        //!< reads served from the buffer
+        size_t misses;      //!< reads that went to the DataArray
+        size_t bytes_read;  //!< bytes fetched into the buffer
+    };
+
+    /**
+     * @brief Enable or disable the read-ahead buffer of the view.
+     *
+     * With read-ahead enabled, a read that is not covered by the buffer
+     * fetches a block of whole rows (along the first dimension) of the
+     * view, aligned to the chunks of the DataArray and at most max_bytes
+     * large. Following reads that fall into the block are then served
+     * from memory. This pays off when the view is read in many small
+     * windows, e.g. by a sliding window.
+     *
+     * The buffer is shared by copies of the view. Writing through the
+     * view drops it; writes to the DataArray that bypass the view are
+     * not noticed.
+     *
+     * @param max_bytes     The maximal size of the buffer, 0 disables it.
+     */
+    void readAhead(size_t max_bytes);
+
+    /**
+     * @brief The maximal size of the read-ahead buffer, 0 if disabled.
+     */
+    size_t readAhead() const;
+
+    /**
+     * @brief Get the hit and miss counters of the read-ahead buffer.
+     */
+    ReadAheadStats readAheadStats() const;
+
 protected:
     void ioRead(DataType dtype,
                 void *data,
                 const NDSize &count,
                 const NDSize &offset) const;
 
+    void ioRead(DataType dtype,
+                void *data,
+                const NDSize &count,
+                const NDSize &offset,
+                const NDSize &stride,
+                const NDSize &block) const;
+
     void ioWrite(DataType dtype,
                  const void *data,
                  const NDSize &count,
@@ -50,11 +97,17 @@ protected:
 private:
     NDSize transform_coordinates(const NDSize &c, const NDSize &o) const;
 
+    bool readCached(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const;
+
 private:
+    struct ReadAheadBuffer;
+
     DataArray array;
     NDSize    offset;
     NDSize    count;
 
+    std::shared_ptr<ReadAheadBuffer> cache;
+
 };
 
 } // nix::
@@ -365,6 +365,30 @@ public:
     DEPRECATED std::vector<std::pair<ndsize_t, ndsize_t>> indexOf(const std::vector<double> &start_positions,
                                                                   const std::vector<double> &end_positions) const;
 
+    /**
+     * @brief Maps many start and end positions to index ranges at once.
+     *
+     * Same as {@link SampledDimension::indexOf(const std::vector<double>&, const std::vector<double>&, const RangeMatch)}
+     * but the results are written into caller provided arrays of at least
+     * count elements, and the sampling interval and offset are read only
+     * once. For ranges that can not be mapped, valid is set to false and
+     * both indices to 0.
+     *
+     * @param start_positions    Array of start positions.
+     * @param end_positions      Array of end positions.
+     * @param count              Number of positions.
+     * @param start_indices      Output, the start indices.
+     * @param end_indices        Output, the end indices.
+     * @param valid              Output, whether the respective range is valid.
+     * @param match              RangeMatch enum to control whether the range should be
+     *                           including the end position or exclusive.
+     *
+     * @return The number of valid ranges.
+     */
+    size_t indexOf(const double *start_positions, const double *end_positions, size_t count,
+                   ndsize_t *start_indices, ndsize_t *end_indices, bool *valid,
+                   const RangeMatch match) const;
+
 
 
     /**
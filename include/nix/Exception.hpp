@@ -127,6 +127,14 @@ public:
     ConsistencyError(const std::string &what) : runtime_error("ConsistencyError: " + what){ }
 };
 
+
+class UnsupportedOperation: public std::runtime_error {
+public:
+    UnsupportedOperation(const std::string &what, const std::string &backend):
+            std::runtime_error("UnsupportedOperation: " + what + " is not supported by the " + backend + " back-end") { }
+};
+
+
     class MissingAttr: public std::runtime_error {
 public:
     MissingAttr(const std::string &name):
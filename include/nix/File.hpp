@@ -18,9 +18,82 @@
 
 #include <nix/valid/validate.hpp>
 
+#include <map>
+
 namespace nix {
 
 
+/**
+ * @brief The header of a file as read by {@link File::probe}.
+ */
+struct NIXAPI FileHeader {
+    std::string      location;    //!< the path of the file
+    bool             valid;       //!< whether the file is a NIX file this version can read
+    std::string      error;       //!< why the file is not valid
+    std::string      format;      //!< the format attribute, "nix" for NIX files
+    std::vector<int> version;     //!< the version of the file format
+    std::string      id;          //!< the id of the file
+    time_t           created_at;  //!< the time the file was created
+    time_t           updated_at;  //!< the time the file was last changed
+};
+
+
+/**
+ * @brief How the data of a DataArray is stored, see {@link File::repack}.
+ */
+struct NIXAPI DataLayout {
+    NDSize      chunks;       //!< the chunk size, empty to keep it or to guess it for a new compression
+    Compression compression;  //!< the compression, Compression::Auto to keep it
+    DataStorage storage;      //!< the storage, DataStorage::Auto to keep it, chunked if chunks or a compression are given
+
+    DataLayout() : compression(Compression::Auto), storage(DataStorage::Auto) { }
+
+    DataLayout(const NDSize &chunks, Compression compression, DataStorage storage = DataStorage::Auto)
+        : chunks(chunks), compression(compression), storage(storage) { }
+
+    explicit DataLayout(DataStorage storage) : compression(Compression::Auto), storage(storage) { }
+};
+
+
+/**
+ * @brief The options of {@link File::repack}.
+ */
+struct NIXAPI RepackOptions {
+    size_t                            threads;  //!< the threads that compress data, 0 for one per core
+    DataLayout                        layout;   //!< the layout of all data arrays
+    std::map<std::string, DataLayout> arrays;   //!< the layout of single data arrays by id, instead of layout
+
+    RepackOptions() : threads(0) { }
+};
+
+
+/**
+ * @brief What {@link File::repack} did.
+ */
+struct NIXAPI RepackReport {
+    uint64_t size_before;  //!< the size of the source file in bytes
+    uint64_t size_after;   //!< the size of the repacked file in bytes
+    size_t   arrays;       //!< the number of data arrays copied
+    size_t   rewritten;    //!< the number of data arrays stored in a new layout
+    double   seconds;      //!< the time the repack took
+};
+
+
+/**
+ * @brief A NIX file, the root of all entities.
+ *
+ * Several threads may read through the same File at the same time, also
+ * through shared Block, DataArray or other entity objects. All calls into
+ * HDF5 are serialized internally, while work done outside of HDF5, e.g.
+ * applying polynomials or converting units, runs in parallel. Modifying
+ * a file while other threads access it is not supported.
+ *
+ * Other processes can read a file while one process appends data to it
+ * (single-writer/multiple-reader): the writer opens the file with
+ * FileMode::SwmrWrite, creates all entities it needs and then calls
+ * {@link startSwmrWrite}. Readers open the file with FileMode::SwmrRead
+ * and call {@link DataArray::refresh} to see data appended since.
+ */
 class NIXAPI File : public base::ImplContainer<base::IFile> {
 
 public:
@@ -89,18 +162,128 @@ public:
      *                      overridden upon DataArray creation)
      * @param flags         Control aspects of the file opening process
      *
+     * With OpenFlags::InMemory the whole file is kept in memory and never
+     * written to disk; an existing file at name is loaded. Changes are lost
+     * on close, unless the file is exported with {@link toImage}. With
+     * OpenFlags::BackingStore the file is written back to name on close.
+     * Files in memory are told apart by name, so two of them must not be
+     * opened with the same name at the same time.
+     *
      * @return The opened file.
      */
     static File open(const std::string &name, FileMode mode=FileMode::ReadWrite,
                      const std::string &impl="hdf5", Compression compression=Compression::Auto,
                      OpenFlags flags=OpenFlags::None);
 
+    /**
+     * @brief Opens a file from an image of it in memory.
+     *
+     * The image, e.g. obtained by {@link toImage} or read from a network
+     * connection, is copied; the file lives in memory only. Changes made
+     * in FileMode::ReadWrite can be exported with {@link toImage}.
+     *
+     * @param image         Pointer to the image of the file.
+     * @param size          The size of the image in bytes.
+     * @param mode          FileMode::ReadOnly or FileMode::ReadWrite.
+     * @param compression   The compression mode, see {@link open}.
+     *
+     * @return The opened file.
+     */
+    static File fromImage(const void *image, size_t size, FileMode mode=FileMode::ReadOnly,
+                          Compression compression=Compression::Auto);
+
+    /**
+     * @brief Reads the header of a file without opening it as a File.
+     *
+     * The file is opened read-only and only the attributes of its root are
+     * read, which is much cheaper than {@link open}. Nothing in the file is
+     * changed. Errors, e.g. if the file does not exist or is not a NIX
+     * file, are not thrown but reported in the returned header.
+     *
+     * @param name      The name/path of the file.
+     * @param impl      The back-end implementation, currently only hdf5.
+     *
+     * @return The header of the file.
+     */
+    static FileHeader probe(const std::string &name, const std::string &impl="hdf5");
+
+    /**
+     * @brief Reads the headers of many files, see {@link probe(const std::string&, const std::string&)}.
+     *
+     * The files are probed on a pool of threads. The beginning of each file
+     * is read ahead outside of HDF5, so slow storage is accessed in parallel
+     * even though the calls into HDF5 are serialized.
+     *
+     * @param names     The names/paths of the files.
+     * @param threads   The number of threads, 0 for one per core.
+     * @param impl      The back-end implementation, currently only hdf5.
+     *
+     * @return The headers in the order of names.
+     */
+    static std::vector<FileHeader> probe(const std::vector<std::string> &names, size_t threads = 0,
+                                         const std::string &impl="hdf5");
+
+    /**
+     * @brief Rewrite a file into a new one that only holds what is in use.
+     *
+     * HDF5 does not give back the space of deleted entities or of data
+     * that was cut off, repacking does. Everything is copied as it is:
+     * ids, names, timestamps and the order entities were created in stay
+     * the same. The data of data arrays is copied chunk by chunk as it is
+     * stored, unless the options ask for a new chunk size, compression or
+     * storage. Then the chunks are read one by one and compressed on a
+     * pool of threads, so only a few chunks are held in memory at any
+     * time. The data of arrays of strings is always copied as it is.
+     *
+     * ~~~
+     * RepackOptions opts;
+     * opts.layout = DataLayout({ 4096 }, Compression::DeflateNormal);
+     * RepackReport report = File::repack("recording.nix", "recording.packed.nix", opts);
+     * ~~~
+     *
+     * @param source        The name/path of the file to repack, it is not changed.
+     * @param destination   The name/path of the new file, overwritten if it exists.
+     * @param options       The layout of the data and the number of threads.
+     * @param impl          The back-end implementation, currently only hdf5.
+     *
+     * @return The sizes of both files, the number of arrays and the time taken.
+     */
+    static RepackReport repack(const std::string &source, const std::string &destination,
+                               const RepackOptions &options = RepackOptions(),
+                               const std::string &impl="hdf5");
+
     /**
      * @brief Persists all cached changes to the backend.
      *
      */
     bool flush();
 
+    /**
+     * @brief Start single-writer/multiple-reader access to the file.
+     *
+     * The file must have been opened with FileMode::SwmrWrite. From then
+     * on readers in FileMode::SwmrRead can open the file while data is
+     * written to, or appended to, existing DataArrays. No entities, nor
+     * any of their attributes, may be created or changed after this call;
+     * readers would see an inconsistent file.
+     */
+    void startSwmrWrite() {
+        backend()->startSwmrWrite();
+    }
+
+    /**
+     * @brief Get an image of the file in memory.
+     *
+     * The image is the byte-for-byte content the file would have on disk
+     * after a {@link flush}; it can be stored or sent anywhere and opened
+     * again with {@link fromImage}.
+     *
+     * @return The image of the file.
+     */
+    std::vector<char> toImage() {
+        return backend()->toImage();
+    }
+
 
     /**
      * @brief Get the number of blocks in in the file.
@@ -166,6 +349,27 @@ public:
      */
     Block createBlock(const std::string &name, const std::string &type);
 
+    /**
+     * @brief Copy a block with all its entities into this file.
+     *
+     * The block may be part of this or of another file. All entities of the
+     * copy get new ids and the links between them, e.g. the sources of data
+     * arrays or the references of tags, point to the copies. The data is
+     * copied chunk by chunk as it is stored, without decompressing it or
+     * loading whole arrays into memory. Metadata sections of this file stay
+     * linked; sections of another file are linked to the top level section
+     * of the same name in this file, or copied there if there is none.
+     *
+     * @param source  The block to copy.
+     * @param name    The name of the copy, the name of the source if empty.
+     *
+     * @return The copy of the block.
+     *
+     * @throws nix::UnsupportedOperation If the file uses the file system
+     *         back-end, which can not copy entities.
+     */
+    Block copyBlock(const Block &source, const std::string &name = "");
+
     /**
      * @brief Deletes a block from the file.
      *
@@ -342,6 +546,20 @@ public:
      */
     Section createSection(const std::string &name, const std::string &type);
 
+    /**
+     * @brief Copy a section with its properties and subsections into this
+     *        file as a top level section, see {@link copyBlock}.
+     *
+     * @param source  The section to copy.
+     * @param name    The name of the copy, the name of the source if empty.
+     *
+     * @return The copy of the section.
+     *
+     * @throws nix::UnsupportedOperation If the file uses the file system
+     *         back-end, which can not copy entities.
+     */
+    Section copySection(const Section &source, const std::string &name = "");
+
     /**
      * @brief Deletes the Section that is specified with the id.
      *
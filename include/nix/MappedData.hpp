@@ -0,0 +1,121 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_MAPPED_DATA_H
+#define NIX_MAPPED_DATA_H
+
+#include <nix/DataType.hpp>
+#include <nix/NDSize.hpp>
+
+#include <nix/Platform.hpp>
+
+#include <memory>
+#include <stdexcept>
+
+namespace nix {
+
+namespace base {
+class IFile;
+}
+
+/**
+ * @brief Read-only view on the data of a DataArray that is mapped
+ * straight from the file into memory.
+ *
+ * The elements are laid out in row-major order, {@link strides} gives the
+ * distance between two consecutive elements along each dimension, in
+ * elements. Pages are only read from disk when they are first accessed.
+ *
+ * The view keeps the mapping alive on its own, but it becomes invalid as
+ * soon as the file it was created from is closed; {@link data} throws
+ * afterwards.
+ */
+class NIXAPI MappedData {
+
+    std::shared_ptr<const void>  region;
+    std::shared_ptr<base::IFile> file;
+    const void                  *ptr;
+    DataType                     dtype;
+    NDSize                       extent;
+
+public:
+
+    MappedData()
+        : ptr(nullptr), dtype(DataType::Nothing) { }
+
+    MappedData(const std::shared_ptr<const void> &region,
+               const std::shared_ptr<base::IFile> &file,
+               const void *ptr,
+               DataType dtype,
+               const NDSize &extent)
+        : region(region), file(file), ptr(ptr), dtype(dtype), extent(extent) { }
+
+    /**
+     * @brief Whether the file the view was created from is still open.
+     */
+    bool valid() const;
+
+    /**
+     * @brief Whether the view contains no elements.
+     */
+    bool empty() const {
+        return ptr == nullptr || size() == 0;
+    }
+
+    /**
+     * @brief Pointer to the first element of the mapped data.
+     */
+    const void *data() const {
+        if (!valid()) {
+            throw std::runtime_error("MappedData: view is not valid (file closed?)");
+        }
+        return ptr;
+    }
+
+    /**
+     * @brief Typed pointer to the first element of the mapped data.
+     *
+     * T must match the data type of the DataArray exactly, no conversion
+     * is performed.
+     */
+    template<typename T>
+    const T *data() const {
+        if (to_data_type<T>::value != dtype) {
+            throw std::invalid_argument("MappedData: requested type does not match the stored data type");
+        }
+        return static_cast<const T *>(data());
+    }
+
+    DataType dataType() const {
+        return dtype;
+    }
+
+    NDSize shape() const {
+        return extent;
+    }
+
+    NDSize strides() const {
+        NDSize strides(extent.size(), 1);
+        for (size_t i = extent.size(); i > 1; i--) {
+            strides[i - 2] = strides[i - 1] * extent[i - 1];
+        }
+        return strides;
+    }
+
+    ndsize_t size() const {
+        return ptr == nullptr ? 0 : extent.nelms();
+    }
+
+    size_t bytes() const {
+        return static_cast<size_t>(size()) * data_type_to_size(dtype);
+    }
+};
+
+} // namespace nix
+
+#endif // NIX_MAPPED_DATA_H
@@ -13,11 +13,14 @@
 #include <nix/base/IProperty.hpp>
 #include <nix/Variant.hpp>
 #include <nix/ObjectType.hpp>
+#include <nix/Exception.hpp>
 
 #include <nix/Platform.hpp>
 
 #include <ostream>
 #include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace nix {
 
@@ -237,6 +240,39 @@ public:
         return backend()->values();
     }
 
+    /**
+     * @brief Get all values of the property as typed values.
+     *
+     * Reads the values straight into the vector without going through
+     * {@link nix::Variant}. Numeric values are converted to T.
+     *
+     * @param values    The vector to read the values into, resized to
+     *                  the number of values.
+     */
+    template<typename T, typename std::enable_if<!std::is_same<T, Variant>::value, int>::type = 0>
+    void values(std::vector<T> &values) const {
+        static_assert(to_data_type<T>::is_valid, "Unsupported value type");
+        static_assert(!std::is_same<T, bool>::value, "std::vector<bool> is not contiguous");
+        ndsize_t count = backend()->valueCount();
+        values.resize(check::fits_in_size_t(count, "Can't resize: data to big for memory"));
+        backend()->readValues(to_data_type<T>::value, values.data(), count);
+    }
+
+    /**
+     * @brief Set the values of the property from typed values.
+     *
+     * Writes the values straight from memory without going through
+     * {@link nix::Variant}. T must match the data type of the property.
+     *
+     * @param data      Pointer to the first value.
+     * @param count     The number of values.
+     */
+    template<typename T>
+    void values(const T *data, ndsize_t count) {
+        static_assert(to_data_type<T>::is_valid, "Unsupported value type");
+        backend()->writeValues(to_data_type<T>::value, data, count);
+    }
+
     /**
      * @brief Deletes all values from the property.
      */
@@ -0,0 +1,95 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_STATS_H
+#define NIX_STATS_H
+
+#include <nix/Platform.hpp>
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+
+namespace nix {
+
+/**
+ * @brief The operations of the HDF5 back-end that are counted by {@link stats}.
+ */
+enum class StatOp : int {
+    GroupOpen = 0,  //!< H5Gopen
+    GroupCreate,    //!< H5Gcreate
+    LinkExists,     //!< H5Lexists
+    LinkName,       //!< H5Lget_name_by_idx
+    LinkIterate,    //!< H5Literate and H5Lvisit, to list the links of a group
+    ObjectOpen,     //!< H5Oopen, to check the type of an object
+    DataSetOpen,    //!< H5Dopen
+    DataSetCreate,  //!< H5Dcreate
+    DataSetRead,    //!< H5Dread
+    DataSetWrite,   //!< H5Dwrite
+    DataSetExtent,  //!< H5Dset_extent
+    DataSetInfo,    //!< H5Dget_space, H5Dget_type
+    VlenReclaim,    //!< H5Dvlen_reclaim, for datasets and attributes
+    AttrExists,     //!< H5Aexists
+    AttrOpen,       //!< H5Aopen
+    AttrCreate,     //!< H5Acreate
+    AttrRead,       //!< H5Aread
+    AttrWrite,      //!< H5Awrite
+    Count           //!< the number of operations
+};
+
+/**
+ * @brief Counters of one operation.
+ */
+struct OpStats {
+    uint64_t calls;       //!< number of calls
+    uint64_t nanos;       //!< cumulative time spent in the calls
+    uint64_t bytes;       //!< bytes read or written in memory, i.e. as requested
+    uint64_t file_bytes;  //!< the same data in the representation of the file
+};
+
+/**
+ * @brief A snapshot of the counters of all operations.
+ */
+struct NIXAPI Stats {
+    bool                                                 enabled;
+    std::array<OpStats, static_cast<size_t>(StatOp::Count)> ops;
+
+    const OpStats &operator[](StatOp op) const {
+        return ops[static_cast<size_t>(op)];
+    }
+
+    /**
+     * @brief The name of the operation, e.g. "dataset.read".
+     */
+    static const char *name(StatOp op);
+};
+
+/**
+ * @brief Get the counters of the calls the HDF5 back-end made since the
+ *        start or the last {@link resetStats}.
+ *
+ * The counters are only kept if the library was built with ENABLE_STATS
+ * (cmake -DENABLE_STATS=ON); otherwise all of them stay zero and
+ * Stats::enabled is false. Without ENABLE_STATS the instrumentation is
+ * not compiled in and costs nothing.
+ */
+NIXAPI Stats stats();
+
+/**
+ * @brief Set all counters to zero.
+ */
+NIXAPI void resetStats();
+
+/**
+ * @brief Print the counters of all operations that were called, one per line.
+ */
+NIXAPI std::ostream &operator<<(std::ostream &out, const Stats &stats);
+
+} // namespace nix
+
+#endif // NIX_STATS_H
@@ -17,6 +17,7 @@
 
 #include <string>
 #include <cstdint>
+#include <cstring>
 #include <stdexcept>
 #include <iostream>
 
@@ -26,7 +27,12 @@ namespace nix {
  */
 class NIXAPI Variant {
 private:
+    /* strings shorter than this (including the terminating null) are
+     * stored inline, longer ones on the heap */
+    static const size_t small_string_size = 24;
+
     DataType dtype;
+    bool     heap;
 
     union {
         bool v_bool;
@@ -36,26 +42,27 @@ private:
         uint64_t v_uint64;
         int64_t v_int64;
         char *v_string;
+        char v_small[small_string_size];
     };
 
 public:
-    Variant() : dtype(DataType::Nothing), v_bool(false) { }
+    Variant() : dtype(DataType::Nothing), heap(false), v_bool(false) { }
 
-    explicit Variant(char *value) : dtype(DataType::Nothing) {
+    explicit Variant(char *value) : dtype(DataType::Nothing), heap(false) {
         set(value);
     }
 
-    explicit Variant(const char *value) : dtype(DataType::Nothing) {
+    explicit Variant(const char *value) : dtype(DataType::Nothing), heap(false) {
         set(value);
     }
 
     template<typename T>
-    explicit Variant(const T &value) : dtype(DataType::Nothing) {
+    explicit Variant(const T &value) : dtype(DataType::Nothing), heap(false) {
         set(value);
     }
 
     template<size_t N>
-    explicit Variant(const char (&value)[N]) : dtype(DataType::Nothing) {
+    explicit Variant(const char (&value)[N]) : dtype(DataType::Nothing), heap(false) {
         set(value, N);
     }
 
@@ -64,18 +71,21 @@ public:
     }
 
     Variant(Variant &&other) NOEXCEPT : Variant() {
-        if (other.dtype == DataType::String) {
-            v_string = other.v_string;
-            dtype = DataType::String;
-            other.dtype = DataType::Nothing;
-            other.v_string = nullptr;
-        } else {
+        steal_from(other);
+    }
+
+    Variant &operator=(const Variant &other) {
+        if (this != &other) {
             assign_variant_from(other);
         }
+        return *this;
     }
 
-    Variant &operator=(Variant other) {
-        assign_variant_from(other);
+    Variant &operator=(Variant &&other) NOEXCEPT {
+        if (this != &other) {
+            maybe_deallocte_string();
+            steal_from(other);
+        }
         return *this;
     }
 
@@ -124,6 +134,20 @@ private:
 
     void maybe_deallocte_string();
 
+    const char *string_data() const {
+        return heap ? v_string : v_small;
+    }
+
+    /* takes over the value (and the heap buffer) of other, which is
+     * left as None; the caller must have released its own string */
+    void steal_from(Variant &other) NOEXCEPT {
+        dtype = other.dtype;
+        heap = other.heap;
+        std::memcpy(v_small, other.v_small, small_string_size);
+        other.dtype = DataType::Nothing;
+        other.heap = false;
+    }
+
     inline void check_argument_type(DataType check) const {
         if (dtype != check) {
             throw std::invalid_argument("Incompatible DataType");
@@ -135,7 +159,7 @@ private:
 template<>
 inline const char *Variant::get<const char *>() const {
     check_argument_type(DataType::String);
-    return v_string;
+    return string_data();
 }
 
 template<>
@@ -17,6 +17,7 @@
 #include <nix/base/IMultiTag.hpp>
 #include <nix/base/IGroup.hpp>
 #include <nix/Compression.hpp>
+#include <nix/DataStorage.hpp>
 #include <nix/NDSize.hpp>
 #include <nix/Identity.hpp>
 
@@ -48,6 +49,11 @@ public:
 
     virtual bool removeEntity(const nix::Identity &ident) = 0;
 
+    virtual std::vector<std::string> removeEntities(const std::vector<nix::Identity> &idents) = 0;
+
+    virtual std::shared_ptr<base::IEntity> copyEntity(const std::shared_ptr<base::IEntity> &source, ObjectType type,
+                                                      const std::string &name) = 0;
+
     template<typename T>
     std::shared_ptr<T> getEntity(const nix::Identity &ident) const {
         return std::dynamic_pointer_cast<T>(this->getEntity(ident));
@@ -78,7 +84,8 @@ public:
 
     virtual std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
                                                               DataType data_type, const NDSize &shape,
-                                                              const Compression &compression) = 0;
+                                                              const Compression &compression,
+                                                              const DataStorage &storage) = 0;
 
     //--------------------------------------------------
     // Methods concerning data frame
@@ -13,7 +13,11 @@
 #include <nix/base/IDimensions.hpp>
 #include <nix/DataFrame.hpp>
 #include <nix/Compression.hpp>
+#include <nix/DataStorage.hpp>
+#include <nix/DataStatistics.hpp>
+#include <nix/DataPyramid.hpp>
 #include <nix/DataType.hpp>
+#include <nix/MappedData.hpp>
 #include <nix/NDSize.hpp>
 #include <nix/ObjectType.hpp>
 
@@ -125,8 +129,10 @@ public:
      * @param dtype        The data type that should be stored in this data array.
      * @param size         The size of the data to store.
      * @param compression  En-/disables compression for this DataArray
+     * @param storage      Whether the data is stored in chunks or in one block
      */
-    virtual void createData(DataType dtype, const NDSize &size, const Compression &compression) = 0;
+    virtual void createData(DataType dtype, const NDSize &size, const Compression &compression,
+                            const DataStorage &storage) = 0;
 
     /**
      * @brief Check if the data array has some data.
@@ -155,6 +161,109 @@ public:
      */
     virtual void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const = 0;
 
+    /**
+     * @brief Read a strided selection of the data.
+     *
+     * @param dtype     The type of data to read (e.g. {@link nix::DataType::Int32}).
+     * @param buffer    Buffer of count * block elements where the data is written.
+     * @param count     The number of blocks to read along each dimension.
+     * @param offset    The position of the first block.
+     * @param stride    The distance between the starts of two blocks, empty means 1.
+     * @param block     The size of each block, empty means 1.
+     */
+    virtual void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset,
+                      const NDSize &stride, const NDSize &block) const = 0;
+
+    /**
+     * @brief Map the data of the data array read-only into memory.
+     *
+     * Only possible if the data is stored uncompressed, contiguously and in
+     * the native representation of its data type.
+     *
+     * @return A view on the mapped data.
+     */
+    virtual MappedData mappedData() const = 0;
+
+    /**
+     * @brief The size of the chunks the data is stored in.
+     *
+     * @return The chunk size, empty if the data is not stored in chunks.
+     */
+    virtual NDSize dataChunks() const = 0;
+
+    /**
+     * @brief Build the index of per chunk statistics of the data.
+     *
+     * Once it exists, the index is kept up to date by {@link write} and
+     * {@link dataExtent}.
+     */
+    virtual void createStatistics() = 0;
+
+    /**
+     * @brief Whether the data has an index of per chunk statistics.
+     */
+    virtual bool hasStatistics() const = 0;
+
+    /**
+     * @brief Remove the index of per chunk statistics.
+     *
+     * @return True if there was an index.
+     */
+    virtual bool deleteStatistics() = 0;
+
+    /**
+     * @brief The statistics of the stored values in a region of the data.
+     *
+     * @param offset    The start of the region.
+     * @param count     The size of the region.
+     */
+    virtual DataStatistics statistics(const NDSize &offset, const NDSize &count) const = 0;
+
+    /**
+     * @brief Build the min/max decimation pyramid of the 1-d data.
+     *
+     * Any change of the data removes the pyramid.
+     *
+     * @param options   The factors of the levels and the threads to use.
+     */
+    virtual void createPyramid(const PyramidOptions &options) = 0;
+
+    /**
+     * @brief Whether the data has a min/max decimation pyramid.
+     */
+    virtual bool hasPyramid() const = 0;
+
+    /**
+     * @brief Remove the min/max decimation pyramid.
+     *
+     * @return True if there was a pyramid.
+     */
+    virtual bool deletePyramid() = 0;
+
+    /**
+     * @brief The factors of the levels of the pyramid, empty without one.
+     */
+    virtual std::vector<ndsize_t> pyramidFactors() const = 0;
+
+    /**
+     * @brief Read bins of one level of the pyramid.
+     *
+     * @param factor    The factor of the level.
+     * @param offset    The first bin.
+     * @param count     The number of bins.
+     * @param min       The smallest value of every bin.
+     * @param max       The largest value of every bin.
+     */
+    virtual void readPyramid(ndsize_t factor, ndsize_t offset, ndsize_t count,
+                             std::vector<double> &min, std::vector<double> &max) const = 0;
+
+    /**
+     * @brief Reload the extent and layout of the data from the file.
+     *
+     * Needed by readers of a file that is concurrently appended to.
+     */
+    virtual void refresh() = 0;
+
 
     virtual NDSize dataExtent(void) const = 0;
 
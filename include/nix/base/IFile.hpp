@@ -27,15 +27,19 @@ namespace nix {
 enum class FileMode {
     ReadOnly = 0,
     ReadWrite,
-    Overwrite
+    Overwrite,
+    SwmrRead,   //!< read-only, while a single writer in SwmrWrite mode appends data
+    SwmrWrite   //!< single writer, see {@link nix::File::startSwmrWrite}
 };
 
 /**
  * @brief Control the open process
  */
 enum class OpenFlags {
-    None  = 0,
-    Force = 1 << 0,
+    None         = 0,
+    Force        = 1 << 0,
+    InMemory     = 1 << 1,  //!< keep the whole file in memory, nothing is written to disk
+    BackingStore = 1 << 2,  //!< keep the whole file in memory, write it to disk on close
 };
 
 
@@ -67,6 +71,12 @@ public:
     virtual bool flush() = 0;
 
 
+    virtual void startSwmrWrite() = 0;
+
+
+    virtual std::vector<char> toImage() = 0;
+
+
     virtual ndsize_t blockCount() const = 0;
 
 
@@ -84,6 +94,9 @@ public:
 
     virtual bool deleteBlock(const std::string &name_or_id) = 0;
 
+
+    virtual std::shared_ptr<IBlock> copyBlock(const std::shared_ptr<IBlock> &source, const std::string &name) = 0;
+
     //--------------------------------------------------
     // Methods concerning sections
     //--------------------------------------------------
@@ -105,6 +118,9 @@ public:
 
     virtual bool deleteSection(const std::string &name_or_id) = 0;
 
+
+    virtual std::shared_ptr<ISection> copySection(const std::shared_ptr<ISection> &source, const std::string &name) = 0;
+
     //--------------------------------------------------
     // Methods for file attribute access.
     //--------------------------------------------------
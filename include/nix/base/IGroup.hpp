@@ -46,6 +46,17 @@ public:
 
     virtual void addEntity(const nix::Identity &ident) = 0;
 
+    /**
+     * @brief Set all entities of one type that are members of the group.
+     *
+     * Members that are not in idents are removed, the others are added;
+     * entities that are already members are left alone.
+     *
+     * @param type      The type of the entities.
+     * @param idents    The entities that should be members.
+     */
+    virtual void entities(ObjectType type, const std::vector<nix::Identity> &idents) = 0;
+
     template<typename T>
     std::shared_ptr<T> getEntity(const nix::Identity &ident) const {
         return std::dynamic_pointer_cast<T>(this->getEntity(ident));
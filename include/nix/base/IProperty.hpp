@@ -80,6 +80,12 @@ public:
     virtual void values(const boost::none_t t) = 0;
 
 
+    virtual void readValues(DataType dtype, void *data, ndsize_t count) const = 0;
+
+
+    virtual void writeValues(DataType dtype, const void *data, ndsize_t count) = 0;
+
+
     virtual ~IProperty() {}
 };
 
@@ -22,6 +22,8 @@
 #include <nix/Tag.hpp>
 
 #include <ctime>
+#include <string>
+#include <vector>
 
 namespace nix {
 namespace util {
@@ -574,6 +576,129 @@ NIXAPI DEPRECATED std::vector<DataView> retrieveFeatureData(const MultiTag &tag,
 NIXAPI std::vector<DataView> featureData(const MultiTag &tag, std::vector<ndsize_t> position_indices,
                                          const Feature &feature, RangeMatch match = RangeMatch::Exclusive);
 
+
+/**
+ * @brief Positions and extents of a MultiTag, read from the file once.
+ *
+ * Resolving a MultiTag reads its positions and extents DataArrays in a few
+ * large blocks instead of one small read per position, and keeps them
+ * column-wise in memory, i.e. one vector per dimension. The object can be
+ * passed to getOffsetAndCount, taggedData and featureData instead of the
+ * MultiTag and be reused across calls. It does not notice later changes to
+ * the positions or extents of the tag.
+ */
+class NIXAPI ResolvedMultiTag {
+public:
+
+    /**
+     * @brief Resolve all positions and extents of the tag.
+     */
+    explicit ResolvedMultiTag(const MultiTag &tag);
+
+    /**
+     * @brief Resolve count positions and extents, starting at index first.
+     */
+    ResolvedMultiTag(const MultiTag &tag, ndsize_t first, ndsize_t count);
+
+    const MultiTag &multiTag() const {
+        return mtag;
+    }
+
+    /**
+     * @brief Index of the first resolved position.
+     */
+    ndsize_t first() const {
+        return first_index;
+    }
+
+    /**
+     * @brief Number of resolved positions.
+     */
+    ndsize_t positionCount() const {
+        return nrows;
+    }
+
+    /**
+     * @brief Whether position and, if the tag has extents, extent of index were resolved.
+     */
+    bool contains(ndsize_t index) const {
+        return index >= first_index && index - first_index < (has_extents ? nextent_rows : nrows);
+    }
+
+    /**
+     * @brief Number of columns, i.e. dimensions, the positions define.
+     */
+    size_t columns() const {
+        return position_cols.size();
+    }
+
+    bool hasExtents() const {
+        return has_extents;
+    }
+
+    /**
+     * @brief The positions in the given column, one per resolved position.
+     */
+    const std::vector<double> &positions(size_t column) const {
+        return position_cols.at(column);
+    }
+
+    /**
+     * @brief The extents in the given column, empty if the tag has no extents.
+     */
+    const std::vector<double> &extents(size_t column) const {
+        return extent_cols.at(column);
+    }
+
+    const std::vector<std::string> &units() const {
+        return tag_units;
+    }
+
+private:
+
+    void readColumns(const DataArray &array, std::vector<std::vector<double>> &cols, ndsize_t rows) const;
+
+    MultiTag                         mtag;
+    ndsize_t                         first_index;
+    ndsize_t                         nrows;
+    ndsize_t                         nextent_rows;
+    bool                             has_extents;
+    std::vector<std::vector<double>> position_cols;
+    std::vector<std::vector<double>> extent_cols;
+    std::vector<std::string>         tag_units;
+};
+
+
+NIXAPI void getOffsetAndCount(const ResolvedMultiTag &tag, const DataArray &array, const std::vector<ndsize_t> &indices,
+                              std::vector<NDSize> &offsets, std::vector<NDSize> &counts, RangeMatch match = RangeMatch::Inclusive);
+
+/**
+ * @brief Retrieve several data segments that are tagged by the given positions and extents of
+ *        a resolved MultiTag.
+ *
+ * @param tag                   The resolved multi tag.
+ * @param position_indices      The indices of the positions, empty means all resolved positions.
+ * @param array                 The referenced DataArray.
+ * @param match                 Controls the RangeMatch behavior.
+ *
+ * @return vector of nix::DataViews that contain the data tagged by the specified position indices.
+ */
+NIXAPI std::vector<DataView> taggedData(const ResolvedMultiTag &tag, std::vector<ndsize_t> &position_indices,
+                                        const DataArray &array, RangeMatch match = RangeMatch::Exclusive);
+
+/**
+ * @brief Returns the feature data associated with the positions of a resolved MultiTag.
+ *
+ * @param tag              The resolved MultiTag.
+ * @param position_indices A vector of position indices, empty means all resolved positions.
+ * @param feature          The feature of which the tagged data is requested.
+ * @param match            RangeMatch argument to control range matching behavior. Default is RangeMatch::Exclusive
+ *
+ * @return A vector of the associated data, may be empty.
+ */
+NIXAPI std::vector<DataView> featureData(const ResolvedMultiTag &tag, std::vector<ndsize_t> position_indices,
+                                         const Feature &feature, RangeMatch match = RangeMatch::Exclusive);
+
 } //namespace util
 } //namespace nix
 #endif // NIX_DATAACCESS_H
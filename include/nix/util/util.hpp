@@ -138,10 +138,22 @@ NIXAPI void checkEntityNameAndType(const std::string &name, const std::string &t
 /**
  * @brief Generates an ID-String.
  *
+ * The id is a random (version 4) UUID in its usual textual form. Every
+ * thread has its own generator, so this is safe to call concurrently.
+ *
  * @return The generated id string.
  */
 NIXAPI std::string createId();
 
+/**
+ * @brief Generates an ID-String into an existing string.
+ *
+ * Same as {@link createId()}, but reuses the storage of id.
+ *
+ * @param id    The string the id is written to.
+ */
+NIXAPI void createId(std::string &id);
+
 /**
  * @brief Convert a time value into a string representation.
  *
@@ -11,6 +11,45 @@
 
 namespace nix {
 
+// copy an entity of any kind into the block
+template<typename T>
+static T copy_entity(base::IBlock *block, const T &source, const std::string &name) {
+    util::checkEntityInput(source);
+    const std::string copy_name = name.empty() ? source.name() : name;
+    util::checkEntityName(copy_name);
+
+    const ObjectType type = objectToType<T>::value;
+    if (block->hasEntity({copy_name, type})) {
+        throw DuplicateName("copy entity");
+    }
+    std::shared_ptr<base::IEntity> copy = block->copyEntity(source.impl(), type, copy_name);
+    return T(std::dynamic_pointer_cast<typename objectToType<T>::backendType>(copy));
+}
+
+DataArray Block::copyDataArray(const DataArray &source, const std::string &name) {
+    return copy_entity(backend(), source, name);
+}
+
+DataFrame Block::copyDataFrame(const DataFrame &source, const std::string &name) {
+    return copy_entity(backend(), source, name);
+}
+
+Tag Block::copyTag(const Tag &source, const std::string &name) {
+    return copy_entity(backend(), source, name);
+}
+
+MultiTag Block::copyMultiTag(const MultiTag &source, const std::string &name) {
+    return copy_entity(backend(), source, name);
+}
+
+Source Block::copySource(const Source &source, const std::string &name) {
+    return copy_entity(backend(), source, name);
+}
+
+Group Block::copyGroup(const Group &source, const std::string &name) {
+    return copy_entity(backend(), source, name);
+}
+
 Source Block::createSource(const std::string &name, const std::string &type){
     util::checkEntityNameAndType(name, type);
     if (hasSource(name)) {
@@ -46,12 +85,15 @@ bool Block::deleteSource(const Source &source) {
 }
 
 DataArray Block::createDataArray(const std::string &name, const std::string &type, nix::DataType data_type,
-                                 const NDSize &shape, const Compression &compression) {
+                                 const NDSize &shape, const Compression &compression, const DataStorage &storage) {
     util::checkEntityNameAndType(name, type);
+    if (storage == DataStorage::Contiguous && compression == Compression::DeflateNormal) {
+        throw std::invalid_argument("Block::createDataArray: contiguous data can not be compressed!");
+    }
     if (hasDataArray(name)){
         throw DuplicateName("create DataArray");
     }
-    return backend()->createDataArray(name, type, data_type, shape, compression);
+    return backend()->createDataArray(name, type, data_type, shape, compression, storage);
 }
 
 std::vector<DataArray> Block::dataArrays(const util::AcceptAll<DataArray>::type &filter) const {
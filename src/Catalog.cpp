@@ -0,0 +1,689 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/Catalog.hpp>
+#include <nix/File.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+namespace bfs = boost::filesystem;
+
+namespace nix {
+
+const uint32_t Catalog::no_section;
+
+
+std::string Catalog::valueString(const Variant &value) {
+    std::ostringstream out;
+
+    switch (value.type()) {
+    case DataType::Bool:
+        return value.get<bool>() ? "true" : "false";
+    case DataType::String:
+        return value.get<std::string>();
+    case DataType::Int32:
+        out << value.get<int32_t>();
+        break;
+    case DataType::UInt32:
+        out << value.get<uint32_t>();
+        break;
+    case DataType::Int64:
+        out << value.get<int64_t>();
+        break;
+    case DataType::UInt64:
+        out << value.get<uint64_t>();
+        break;
+    case DataType::Double: {
+        // the shortest text that reads back as the same double
+        const double d = value.get<double>();
+        for (int p = 1; p <= std::numeric_limits<double>::max_digits10; p++) {
+            out.str(std::string());
+            out.precision(p);
+            out << d;
+            if (std::strtod(out.str().c_str(), nullptr) == d) {
+                break;
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    return out.str();
+}
+
+// the size and modification time in ns of a file, to tell whether it changed
+static bool file_stamp(const std::string &location, uint64_t &size, int64_t &mtime) {
+#ifndef _WIN32
+    struct stat st;
+    if (::stat(location.c_str(), &st) != 0) {
+        return false;
+    }
+#ifdef __APPLE__
+    mtime = static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+    size = static_cast<uint64_t>(st.st_size);
+#else
+    boost::system::error_code ec;
+    size = bfs::file_size(location, ec);
+    mtime = static_cast<int64_t>(bfs::last_write_time(location, ec)) * 1000000000;
+    if (ec) {
+        return false;
+    }
+#endif
+    return true;
+}
+
+// add the properties of a section and of all its subsections
+static void collect_properties(const Section &section,
+                               std::vector<std::pair<std::string, std::vector<std::string>>> &properties) {
+    for (const Property &p : section.properties()) {
+        std::vector<std::string> values;
+        for (const Variant &v : p.values()) {
+            values.push_back(Catalog::valueString(v));
+        }
+        properties.emplace_back(p.name(), std::move(values));
+    }
+
+    for (const Section &s : section.sections()) {
+        collect_properties(s, properties);
+    }
+}
+
+
+void Catalog::add(const File &file) {
+    const std::string location = file.location();
+    std::vector<bool> keep(file_records.size(), true);
+    for (uint32_t i = 0; i < file_records.size(); i++) {
+        if (file_records[i].location == location) {
+            keep[i] = false;
+            keepFiles(keep);
+            break;
+        }
+    }
+
+    const uint32_t fidx = static_cast<uint32_t>(file_records.size());
+    FileRecord fr = {location, 0, 0, ""};
+    file_stamp(location, fr.size, fr.mtime);
+    file_records.push_back(fr);
+
+    // sections are shared by many entities, keep each one once
+    std::unordered_map<std::string, uint32_t> section_index;
+    auto section_of = [&](const Section &s) -> uint32_t {
+        if (!s) {
+            return no_section;
+        }
+        auto it = section_index.find(s.id());
+        if (it != section_index.end()) {
+            return it->second;
+        }
+        SectionRecord sr;
+        sr.file = fidx;
+        sr.id = s.id();
+        collect_properties(s, sr.properties);
+        const uint32_t idx = static_cast<uint32_t>(sections.size());
+        sections.push_back(std::move(sr));
+        section_index.emplace(s.id(), idx);
+        return idx;
+    };
+
+    auto add_record = [&](ObjectType kind, const std::string &block, const std::string &id,
+                          const std::string &name, const std::string &type, const Section &metadata) {
+        Record r;
+        r.file = fidx;
+        r.section = section_of(metadata);
+        r.kind = kind;
+        r.block = block;
+        r.id = id;
+        r.name = name;
+        r.type = type;
+        r.dtype = DataType::Nothing;
+        records.push_back(std::move(r));
+        return records.size() - 1;
+    };
+
+    for (const Block &b : file.blocks()) {
+        add_record(ObjectType::Block, "", b.id(), b.name(), b.type(), b.metadata());
+        const std::string bid = b.id();
+
+        for (const DataArray &da : b.dataArrays()) {
+            Record &r = records[add_record(ObjectType::DataArray, bid, da.id(), da.name(), da.type(),
+                                           da.metadata())];
+            r.dtype = da.dataType();
+            r.extent = da.dataExtent();
+        }
+        for (const DataFrame &df : b.dataFrames()) {
+            Record &r = records[add_record(ObjectType::DataFrame, bid, df.id(), df.name(), df.type(),
+                                           df.metadata())];
+            r.extent = NDSize({df.rows()});
+        }
+        for (const Tag &t : b.tags()) {
+            add_record(ObjectType::Tag, bid, t.id(), t.name(), t.type(), t.metadata());
+        }
+        for (const MultiTag &mt : b.multiTags()) {
+            add_record(ObjectType::MultiTag, bid, mt.id(), mt.name(), mt.type(), mt.metadata());
+        }
+        for (const Group &g : b.groups()) {
+            add_record(ObjectType::Group, bid, g.id(), g.name(), g.type(), g.metadata());
+        }
+        for (const Source &s : b.findSources()) {
+            add_record(ObjectType::Source, bid, s.id(), s.name(), s.type(), s.metadata());
+        }
+    }
+}
+
+
+Catalog Catalog::scan(const std::string &location) {
+    Catalog catalog;
+    try {
+        File file = File::open(location, FileMode::ReadOnly);
+        catalog.add(file);
+        file.close();
+    } catch (const std::exception &e) {
+        catalog = Catalog();
+        FileRecord fr = {location, 0, 0, e.what()};
+        catalog.file_records.push_back(fr);
+    }
+    return catalog;
+}
+
+
+std::vector<Catalog> Catalog::scan(const std::vector<std::string> &locations, size_t threads) {
+    if (threads == 0) {
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    threads = std::min(threads, locations.size());
+
+    std::vector<Catalog> parts(locations.size());
+    std::atomic<size_t> next(0);
+    auto work = [&] {
+        for (size_t i = next++; i < locations.size(); i = next++) {
+            parts[i] = scan(locations[i]);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < threads; i++) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (auto &t : pool) {
+        t.join();
+    }
+
+    return parts;
+}
+
+
+Catalog Catalog::build(const std::vector<std::string> &files, size_t threads) {
+    Catalog catalog;
+    for (Catalog &part : scan(files, threads)) {
+        catalog.merge(std::move(part));
+    }
+    return catalog;
+}
+
+
+size_t Catalog::update(const std::vector<std::string> &files, size_t threads) {
+    std::unordered_map<std::string, uint32_t> known;
+    for (uint32_t i = 0; i < file_records.size(); i++) {
+        known.emplace(file_records[i].location, i);
+    }
+
+    std::vector<bool> keep(file_records.size(), false);
+    std::vector<std::string> changed;
+    for (const std::string &location : files) {
+        auto it = known.find(location);
+        if (it != known.end()) {
+            const FileRecord &fr = file_records[it->second];
+            uint64_t size = 0;
+            int64_t mtime = 0;
+            if (file_stamp(location, size, mtime) && fr.error.empty() && fr.size == size && fr.mtime == mtime) {
+                keep[it->second] = true;
+                continue;
+            }
+        }
+        changed.push_back(location);
+    }
+
+    keepFiles(keep);
+
+    for (Catalog &part : scan(changed, threads)) {
+        merge(std::move(part));
+    }
+    return changed.size();
+}
+
+
+void Catalog::merge(Catalog &&other) {
+    const uint32_t file_offset = static_cast<uint32_t>(file_records.size());
+    const uint32_t section_offset = static_cast<uint32_t>(sections.size());
+
+    for (FileRecord &fr : other.file_records) {
+        file_records.push_back(std::move(fr));
+    }
+    for (SectionRecord &sr : other.sections) {
+        sr.file += file_offset;
+        sections.push_back(std::move(sr));
+    }
+    for (Record &r : other.records) {
+        r.file += file_offset;
+        if (r.section != no_section) {
+            r.section += section_offset;
+        }
+        records.push_back(std::move(r));
+    }
+}
+
+
+void Catalog::keepFiles(const std::vector<bool> &keep) {
+    std::vector<uint32_t> file_map(file_records.size(), 0);
+    size_t nfiles = 0;
+    for (size_t i = 0; i < file_records.size(); i++) {
+        if (keep[i]) {
+            file_map[i] = static_cast<uint32_t>(nfiles);
+            if (nfiles != i) {
+                file_records[nfiles] = std::move(file_records[i]);
+            }
+            nfiles++;
+        }
+    }
+    if (nfiles == file_records.size()) {
+        return;
+    }
+    file_records.resize(nfiles);
+
+    std::vector<uint32_t> section_map(sections.size(), no_section);
+    size_t nsections = 0;
+    for (size_t i = 0; i < sections.size(); i++) {
+        if (keep[sections[i].file]) {
+            section_map[i] = static_cast<uint32_t>(nsections);
+            sections[i].file = file_map[sections[i].file];
+            if (nsections != i) {
+                sections[nsections] = std::move(sections[i]);
+            }
+            nsections++;
+        }
+    }
+    sections.resize(nsections);
+
+    size_t nrecords = 0;
+    for (size_t i = 0; i < records.size(); i++) {
+        if (keep[records[i].file]) {
+            Record &r = records[i];
+            r.file = file_map[r.file];
+            if (r.section != no_section) {
+                r.section = section_map[r.section];
+            }
+            if (nrecords != i) {
+                records[nrecords] = std::move(r);
+            }
+            nrecords++;
+        }
+    }
+    records.resize(nrecords);
+}
+
+
+std::vector<std::string> Catalog::files() const {
+    std::vector<std::string> locations;
+    for (const FileRecord &fr : file_records) {
+        locations.push_back(fr.location);
+    }
+    return locations;
+}
+
+
+std::map<std::string, std::string> Catalog::errors() const {
+    std::map<std::string, std::string> errs;
+    for (const FileRecord &fr : file_records) {
+        if (!fr.error.empty()) {
+            errs.emplace(fr.location, fr.error);
+        }
+    }
+    return errs;
+}
+
+
+CatalogEntry Catalog::entry(const Record &r) const {
+    CatalogEntry e;
+    e.file = file_records[r.file].location;
+    e.block = r.block;
+    e.kind = r.kind;
+    e.id = r.id;
+    e.name = r.name;
+    e.type = r.type;
+    e.dtype = r.dtype;
+    e.extent = r.extent;
+    e.metadata = r.section != no_section ? sections[r.section].id : "";
+    return e;
+}
+
+
+std::vector<CatalogEntry> Catalog::entries() const {
+    std::vector<CatalogEntry> result;
+    result.reserve(records.size());
+    for (const Record &r : records) {
+        result.push_back(entry(r));
+    }
+    return result;
+}
+
+
+std::vector<CatalogEntry> Catalog::find(const std::string &property, const std::string &value,
+                                        ObjectType kind) const {
+    // match the sections first, there are far fewer of them than entities
+    std::vector<bool> matches(sections.size(), false);
+    for (size_t i = 0; i < sections.size(); i++) {
+        for (const auto &p : sections[i].properties) {
+            if (p.first == property && std::find(p.second.begin(), p.second.end(), value) != p.second.end()) {
+                matches[i] = true;
+                break;
+            }
+        }
+    }
+
+    std::vector<CatalogEntry> result;
+    for (const Record &r : records) {
+        if (r.section != no_section && matches[r.section] && (kind == ObjectType::Unknown || r.kind == kind)) {
+            result.push_back(entry(r));
+        }
+    }
+    return result;
+}
+
+
+std::vector<CatalogEntry> Catalog::find(const std::string &property, const Variant &value,
+                                        ObjectType kind) const {
+    return find(property, valueString(value), kind);
+}
+
+
+std::vector<CatalogEntry> Catalog::find(const std::function<bool(const CatalogEntry &)> &filter) const {
+    std::vector<CatalogEntry> result;
+    for (const Record &r : records) {
+        CatalogEntry e = entry(r);
+        if (filter(e)) {
+            result.push_back(std::move(e));
+        }
+    }
+    return result;
+}
+
+
+std::multimap<std::string, std::vector<std::string>> Catalog::metadata(const CatalogEntry &entry) const {
+    std::multimap<std::string, std::vector<std::string>> props;
+    if (entry.metadata.empty()) {
+        return props;
+    }
+
+    for (const SectionRecord &sr : sections) {
+        if (sr.id == entry.metadata && file_records[sr.file].location == entry.file) {
+            props.insert(sr.properties.begin(), sr.properties.end());
+            break;
+        }
+    }
+    return props;
+}
+
+// The index file: a magic string and a format version followed by the
+// files, the sections and the entities, each as a count and the records.
+// Integers are stored little-endian with a fixed width, strings as their
+// length and the bytes.
+
+static const char catalog_magic[8] = {'N', 'I', 'X', 'C', 'A', 'T', '\0', '\0'};
+static const uint32_t catalog_version = 1;
+
+namespace {
+
+class Writer {
+public:
+    explicit Writer(std::ostream &out) : out(out) { }
+
+    void u64(uint64_t v) {
+        put(v, 8);
+    }
+
+    void u32(uint32_t v) {
+        put(v, 4);
+    }
+
+    void str(const std::string &s) {
+        u64(s.size());
+        out.write(s.data(), s.size());
+    }
+
+private:
+    void put(uint64_t v, int width) {
+        char buf[8];
+        for (int i = 0; i < width; i++) {
+            buf[i] = static_cast<char>((v >> (8 * i)) & 0xff);
+        }
+        out.write(buf, width);
+    }
+
+    std::ostream &out;
+};
+
+class Reader {
+public:
+    explicit Reader(std::istream &in) : in(in) { }
+
+    uint64_t u64() {
+        return get(8);
+    }
+
+    uint32_t u32() {
+        return static_cast<uint32_t>(get(4));
+    }
+
+    // counts are bounded by what is left in the stream, so that a corrupt
+    // file does not make us allocate huge amounts of memory
+    size_t count(size_t min_record) {
+        const uint64_t n = u64();
+        if (min_record > 0 && n > remaining / min_record) {
+            throw std::runtime_error("Catalog::load: corrupt index file");
+        }
+        return static_cast<size_t>(n);
+    }
+
+    std::string str() {
+        const size_t n = count(1);
+        std::string s(n, '\0');
+        in.read(&s[0], n);
+        check();
+        return s;
+    }
+
+    void limit(uint64_t bytes) {
+        remaining = bytes;
+    }
+
+private:
+    uint64_t get(int width) {
+        unsigned char buf[8];
+        in.read(reinterpret_cast<char *>(buf), width);
+        check();
+        uint64_t v = 0;
+        for (int i = width - 1; i >= 0; i--) {
+            v = (v << 8) | buf[i];
+        }
+        return v;
+    }
+
+    void check() {
+        if (!in) {
+            throw std::runtime_error("Catalog::load: truncated index file");
+        }
+        remaining = in.gcount() > static_cast<std::streamsize>(remaining) ? 0 : remaining - in.gcount();
+    }
+
+    std::istream &in;
+    uint64_t     remaining = std::numeric_limits<uint64_t>::max();
+};
+
+} // anonymous namespace
+
+
+void Catalog::save(const std::string &path) const {
+    // written next to the index and renamed over it, readers never see half a file
+    const std::string temp = path + bfs::unique_path(".%%%%-%%%%-%%%%.tmp").string();
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Catalog::save: cannot open " + temp);
+    }
+
+    Writer w(out);
+    out.write(catalog_magic, sizeof(catalog_magic));
+    w.u32(catalog_version);
+
+    w.u64(file_records.size());
+    for (const FileRecord &fr : file_records) {
+        w.str(fr.location);
+        w.u64(fr.size);
+        w.u64(static_cast<uint64_t>(fr.mtime));
+        w.str(fr.error);
+    }
+
+    w.u64(sections.size());
+    for (const SectionRecord &sr : sections) {
+        w.u32(sr.file);
+        w.str(sr.id);
+        w.u64(sr.properties.size());
+        for (const auto &p : sr.properties) {
+            w.str(p.first);
+            w.u64(p.second.size());
+            for (const std::string &v : p.second) {
+                w.str(v);
+            }
+        }
+    }
+
+    w.u64(records.size());
+    for (const Record &r : records) {
+        w.u32(r.file);
+        w.u32(r.section);
+        w.u32(static_cast<uint32_t>(r.kind));
+        w.str(r.block);
+        w.str(r.id);
+        w.str(r.name);
+        w.str(r.type);
+        w.u32(static_cast<uint32_t>(r.dtype));
+        w.u64(r.extent.size());
+        for (size_t i = 0; i < r.extent.size(); i++) {
+            w.u64(r.extent[i]);
+        }
+    }
+
+    out.close();
+    boost::system::error_code ec;
+    if (!out) {
+        bfs::remove(temp, ec);
+        throw std::runtime_error("Catalog::save: cannot write " + path);
+    }
+
+    bfs::rename(temp, path, ec);
+    if (ec) {
+        const std::string reason = ec.message();
+        bfs::remove(temp, ec);
+        throw std::runtime_error("Catalog::save: cannot replace " + path + ": " + reason);
+    }
+}
+
+
+Catalog Catalog::load(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Catalog::load: cannot open " + path);
+    }
+
+    char magic[sizeof(catalog_magic)];
+    in.read(magic, sizeof(magic));
+    if (!in || !std::equal(magic, magic + sizeof(magic), catalog_magic)) {
+        throw std::runtime_error("Catalog::load: not a catalog index file: " + path);
+    }
+
+    boost::system::error_code ec;
+    Reader r(in);
+    r.limit(bfs::file_size(path, ec));
+    if (r.u32() != catalog_version) {
+        throw std::runtime_error("Catalog::load: unsupported index file version");
+    }
+
+    Catalog catalog;
+    const size_t nfiles = r.count(24);
+    for (size_t i = 0; i < nfiles; i++) {
+        FileRecord fr;
+        fr.location = r.str();
+        fr.size = r.u64();
+        fr.mtime = static_cast<int64_t>(r.u64());
+        fr.error = r.str();
+        catalog.file_records.push_back(std::move(fr));
+    }
+
+    const size_t nsections = r.count(12);
+    for (size_t i = 0; i < nsections; i++) {
+        SectionRecord sr;
+        sr.file = r.u32();
+        sr.id = r.str();
+        const size_t nprops = r.count(16);
+        for (size_t j = 0; j < nprops; j++) {
+            std::string name = r.str();
+            std::vector<std::string> values(r.count(8));
+            for (std::string &v : values) {
+                v = r.str();
+            }
+            sr.properties.emplace_back(std::move(name), std::move(values));
+        }
+        if (sr.file >= nfiles) {
+            throw std::runtime_error("Catalog::load: corrupt index file");
+        }
+        catalog.sections.push_back(std::move(sr));
+    }
+
+    const size_t nrecords = r.count(60);
+    for (size_t i = 0; i < nrecords; i++) {
+        Record rec;
+        rec.file = r.u32();
+        rec.section = r.u32();
+        rec.kind = static_cast<ObjectType>(r.u32());
+        rec.block = r.str();
+        rec.id = r.str();
+        rec.name = r.str();
+        rec.type = r.str();
+        rec.dtype = static_cast<DataType>(r.u32());
+        rec.extent = NDSize(r.count(8), 0);
+        for (size_t j = 0; j < rec.extent.size(); j++) {
+            rec.extent[j] = r.u64();
+        }
+        if (rec.file >= nfiles || (rec.section != no_section && rec.section >= nsections)) {
+            throw std::runtime_error("Catalog::load: corrupt index file");
+        }
+        catalog.records.push_back(std::move(rec));
+    }
+
+    return catalog;
+}
+
+} // namespace nix
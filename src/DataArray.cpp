@@ -25,12 +25,19 @@ static void convertData(DataType source, DataType destination, void *data, size_
 
 
 void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    ioRead(dtype, data, count, offset, {}, {});
+}
+
+
+void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const NDSize &offset,
+                       const NDSize &stride, const NDSize &block) const {
     const std::vector<double> poly = polynomCoefficients();
     boost::optional<double> opt_origin = expansionOrigin();
 
     if (poly.size() || opt_origin) {
         size_t data_esize = data_type_to_size(dtype);
-        size_t nelms = check::fits_in_size_t(count.nelms(),
+        const NDSize shape = block ? count * block : count;
+        size_t nelms = check::fits_in_size_t(shape.nelms(),
 			"Cannot apply polynom or origin transform. Buffer needed exceeds memory.");
         std::vector<double> tmp;
         double *read_buffer;
@@ -43,7 +50,7 @@ void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const ND
             read_buffer = reinterpret_cast<double *>(data);
         }
 
-        getDataDirect(DataType::Double, read_buffer, count, offset);
+        getDataDirect(DataType::Double, read_buffer, count, offset, stride, block);
         const double origin = opt_origin ? *opt_origin : 0.0;
 
         util::applyPolynomial(poly, origin, read_buffer, read_buffer, nelms);
@@ -54,7 +61,7 @@ void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const ND
         }
 
     } else {
-        getDataDirect(dtype, data, count, offset);
+        getDataDirect(dtype, data, count, offset, stride, block);
     }
 }
 
@@ -97,6 +104,74 @@ void DataArray::appendData(DataType dtype, const void *data, const NDSize &count
 
 }
 
+DataStatistics DataArray::statistics(const NDSize &offset, const NDSize &count) const {
+    const NDSize extent = dataExtent();
+    if (offset.size() != extent.size() || count.size() != extent.size()) {
+        throw IncompatibleDimensions("Offset and count must have the rank of the data", "statistics");
+    }
+    for (size_t i = 0; i < extent.size(); i++) {
+        if (offset[i] + count[i] > extent[i]) {
+            throw OutOfBounds("statistics: offset + count is out of bounds", offset[i] + count[i]);
+        }
+    }
+    return backend()->statistics(offset, count);
+}
+
+
+DataEnvelope DataArray::envelopeByIndex(size_t pixels, ndsize_t offset, ndsize_t count) const {
+    const NDSize extent = dataExtent();
+    if (extent.size() != 1) {
+        throw InvalidRank("envelope is only supported for 1-d data");
+    }
+    if (offset + count > extent[0]) {
+        throw OutOfBounds("envelope: offset + count is out of bounds", offset + count);
+    }
+
+    DataEnvelope env;
+    env.offset = offset;
+    if (count == 0) {
+        return env;
+    }
+
+    // the coarsest level that still has enough bins
+    const std::vector<ndsize_t> factors = pyramidFactors();
+    for (auto it = factors.rbegin(); it != factors.rend(); ++it) {
+        if (count / *it >= std::max<size_t>(pixels, 1)) {
+            env.factor = *it;
+            break;
+        }
+    }
+
+    if (env.factor == 1) {
+        env.min.resize(static_cast<size_t>(count));
+        getDataDirect(DataType::Double, env.min.data(), {count}, {offset});
+        env.max = env.min;
+    } else {
+        const ndsize_t first = offset / env.factor;
+        const ndsize_t last = (offset + count - 1) / env.factor;
+        backend()->readPyramid(env.factor, first, last - first + 1, env.min, env.max);
+        env.offset = first * env.factor;
+    }
+    return env;
+}
+
+
+DataEnvelope DataArray::envelope(size_t pixels, double start, double end) const {
+    const NDSize extent = dataExtent();
+    if (extent.size() != 1) {
+        throw InvalidRank("envelope is only supported for 1-d data");
+    }
+
+    SampledDimension dim = getDimension(1).asSampledDimension();
+    boost::optional<std::pair<ndsize_t, ndsize_t>> range = dim.indexOf(start, end, RangeMatch::Inclusive);
+    if (!range || range->first >= extent[0]) {
+        return DataEnvelope();
+    }
+    const ndsize_t last = std::min(range->second, extent[0] - 1);
+    return envelopeByIndex(pixels, range->first, last - range->first + 1);
+}
+
+
 void DataArray::unit(const std::string &unit) {
     std::string dblnk_unit = util::deblankString(unit);
     util::checkEmptyString(dblnk_unit, "unit");
@@ -13,8 +13,155 @@
 
 #include <nix/Exception.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
 namespace nix {
 
+struct DataView::ReadAheadBuffer {
+    std::mutex        lock;
+    size_t            max_bytes = 0;
+    ndsize_t          chunk_rows = 1;
+
+    // rows [first, last) of the view along the first dimension, all of it
+    // along the other dimensions, stored as dtype
+    DataType          dtype = DataType::Nothing;
+    ndsize_t          first = 0;
+    ndsize_t          last = 0;
+    std::vector<char> data;
+
+    DataView::ReadAheadStats stats = {0, 0, 0};
+};
+
+void DataView::readAhead(size_t max_bytes) {
+    if (max_bytes == 0) {
+        cache.reset();
+        return;
+    }
+
+    cache = std::make_shared<ReadAheadBuffer>();
+    cache->max_bytes = max_bytes;
+    const NDSize chunks = array.dataChunks();
+    if (chunks.size() > 0 && chunks[0] > 0) {
+        cache->chunk_rows = chunks[0];
+    }
+}
+
+size_t DataView::readAhead() const {
+    return cache ? cache->max_bytes : 0;
+}
+
+DataView::ReadAheadStats DataView::readAheadStats() const {
+    if (!cache) {
+        return ReadAheadStats{0, 0, 0};
+    }
+    std::lock_guard<std::mutex> guard(cache->lock);
+    return cache->stats;
+}
+
+/*
+ * Copy the box at origin with the extent cnt out of a row-major array with
+ * the extent src_extent into the row-major array dst with the extent cnt.
+ */
+static void copy_box(char *dst, const char *src, const NDSize &src_extent, const NDSize &origin,
+                     const NDSize &cnt, size_t elem_size) {
+    const size_t rank = cnt.size();
+    const size_t run = static_cast<size_t>(cnt[rank - 1]) * elem_size;
+    const ndsize_t runs = cnt.nelms() / cnt[rank - 1];
+
+    NDSize src_strides(rank, 1);
+    for (size_t i = rank - 1; i > 0; i--) {
+        src_strides[i - 1] = src_strides[i] * src_extent[i];
+    }
+
+    NDSize pos(rank, 0);
+    for (ndsize_t r = 0; r < runs; r++) {
+        ndsize_t src_index = 0;
+        for (size_t i = 0; i < rank; i++) {
+            src_index += (origin[i] + pos[i]) * src_strides[i];
+        }
+        std::memcpy(dst, src + src_index * elem_size, run);
+        dst += run;
+
+        for (size_t i = rank - 1; i > 0; i--) {
+            if (++pos[i - 1] < cnt[i - 1] || i == 1) {
+                break;
+            }
+            pos[i - 1] = 0;
+        }
+    }
+}
+
+bool DataView::readCached(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    const size_t rank = this->count.size();
+    if (rank == 0 || dtype == DataType::String || count.nelms() == 0) {
+        return false;
+    }
+
+    const size_t elem_size = data_type_to_size(dtype);
+    NDSize row(this->count);
+    row[0] = 1;
+    const size_t row_bytes = static_cast<size_t>(row.nelms()) * elem_size;
+
+    const ndsize_t req_first = offset ? offset[0] : 0;
+    const ndsize_t req_last = req_first + count[0];
+
+    std::lock_guard<std::mutex> guard(cache->lock);
+
+    const bool covered = cache->dtype == dtype && req_first >= cache->first && req_last <= cache->last;
+    if (!covered) {
+        cache->stats.misses++;
+
+        const ndsize_t max_rows = row_bytes > 0 ? cache->max_bytes / row_bytes : 0;
+        if (count[0] > max_rows) {
+            return false;
+        }
+
+        // align to the chunks of the array, but fetch at most max_rows
+        // and never outside of the view
+        const ndsize_t chunk = cache->chunk_rows;
+        const ndsize_t view_first = this->offset[0];
+        const ndsize_t view_last = view_first + this->count[0];
+
+        ndsize_t first = req_first + view_first;
+        ndsize_t aligned = std::max(first / chunk * chunk, view_first);
+        if (req_last + view_first - aligned <= max_rows) {
+            first = aligned;
+        }
+        ndsize_t last = std::min(first + max_rows, view_last);
+        aligned = last / chunk * chunk;
+        if (aligned >= req_last + view_first) {
+            last = aligned;
+        }
+
+        NDSize fetch_count(this->count);
+        fetch_count[0] = last - first;
+        NDSize fetch_offset(this->offset);
+        fetch_offset[0] = first;
+
+        cache->dtype = DataType::Nothing;
+        cache->data.resize(static_cast<size_t>(fetch_count[0]) * row_bytes);
+        array.getData(dtype, cache->data.data(), fetch_count, fetch_offset);
+
+        cache->dtype = dtype;
+        cache->first = first - view_first;
+        cache->last = last - view_first;
+        cache->stats.bytes_read += cache->data.size();
+    } else {
+        cache->stats.hits++;
+    }
+
+    NDSize src_extent(this->count);
+    src_extent[0] = cache->last - cache->first;
+    NDSize origin = offset ? offset : NDSize(rank, 0);
+    origin[0] -= cache->first;
+
+    copy_box(static_cast<char *>(data), cache->data.data(), src_extent, origin, count, elem_size);
+    return true;
+}
+
 void DataView::dataExtent(const NDSize &extent) {
     throw std::runtime_error("Not allowed!");
 }
@@ -46,13 +193,46 @@ void DataView::ioRead(DataType dtype, void *data, const NDSize &count, const NDS
 
     const NDSize &real_count =  count ? count : this->count;
     NDSize base = transform_coordinates(real_count, offset);
+
+    if (cache && readCached(dtype, data, real_count, offset)) {
+        return;
+    }
     array.getData(dtype, data, real_count, base);
 }
 
+void DataView::ioRead(DataType dtype, void *data, const NDSize &count, const NDSize &offset,
+                      const NDSize &stride, const NDSize &block) const {
+
+    if (count.size() != this->count.size()) {
+        throw IncompatibleDimensions("Count dimensionality does not match dimensionality of the DataView", "nix::DataView");
+    }
+    if ((stride && stride.size() != count.size()) || (block && block.size() != count.size())) {
+        throw InvalidRank("Rank of count, stride and block must match");
+    }
+
+    // the area spanned by the selection, from the first to the end of the last block
+    NDSize span(count.size(), 0);
+    for (size_t i = 0; i < count.size(); i++) {
+        if (count[i] == 0) {
+            continue;
+        }
+        span[i] = (count[i] - 1) * (stride ? stride[i] : 1) + (block ? block[i] : 1);
+    }
+
+    NDSize base = transform_coordinates(span, offset);
+    array.getData(dtype, data, count, base, stride, block);
+}
+
 void DataView::ioWrite(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
 
     const NDSize &real_count =  count ? count : this->count;
     NDSize base = transform_coordinates(real_count, offset);
+
+    if (cache) {
+        std::lock_guard<std::mutex> guard(cache->lock);
+        cache->dtype = DataType::Nothing;
+        cache->data.clear();
+    }
     array.setData(dtype, data, real_count, base);
 }
 
@@ -9,6 +9,7 @@
 #include <nix/Dimensions.hpp>
 
 #include <cmath>
+#include <memory>
 #include <nix/DataArray.hpp>
 #include <nix/util/util.hpp>
 #include <nix/Exception.hpp>
@@ -278,6 +279,40 @@ boost::optional<std::pair<ndsize_t, ndsize_t>> SampledDimension::indexOf(double
 }
 
 
+/*
+ * Batch version of indexOf(start, end, sampling_interval, offset, match).
+ * The loop body is kept free of branches and calls other than floor/ceil,
+ * so that the compiler can vectorize it; the results are the same as
+ * those of getSampledIndex for each single position.
+ */
+static size_t sampledIndices(const double *starts, const double *ends, size_t count,
+                             const double sampling_interval, const double offset, const bool exclusive,
+                             ndsize_t *start_indices, ndsize_t *end_indices, bool *valid) {
+    const double eps = numeric_limits<double>::epsilon();
+    size_t nvalid = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const double start = starts[i];
+        const double end = ends[i];
+
+        double si = ceil((start - offset) / sampling_interval);
+        si = si < 0.0 ? 0.0 : si;
+
+        double ei = floor((end - offset) / sampling_interval);
+        const bool on_tick = fabs(ei * sampling_interval + offset - end) <= eps;
+        const bool step_back = exclusive && on_tick;
+        const bool end_ok = end >= offset && (!step_back || ei >= 1.0);
+        ei = step_back ? ei - 1.0 : ei;
+
+        const bool ok = start <= end && end_ok && si <= ei;
+        start_indices[i] = ok ? static_cast<ndsize_t>(si) : 0;
+        end_indices[i] = ok ? static_cast<ndsize_t>(ei) : 0;
+        valid[i] = ok;
+        nvalid += ok;
+    }
+    return nvalid;
+}
+
+
 std::vector<boost::optional<std::pair<ndsize_t, ndsize_t>>> SampledDimension::indexOf(const std::vector<double> &start_positions,
                                                                                       const std::vector<double> &end_positions,
                                                                                       const RangeMatch range_matching) const {
@@ -285,15 +320,34 @@ std::vector<boost::optional<std::pair<ndsize_t, ndsize_t>>> SampledDimension::in
         throw runtime_error("Dimension::IndexOf - Number of start and end positions must match!");
     }
 
-    std::vector<boost::optional<std::pair<ndsize_t, ndsize_t>>> indices;
-    double offset = backend()->offset() ? *(backend()->offset()) : 0.0;
-    double sampling_interval = backend()->samplingInterval();
-    for (size_t i = 0; i < start_positions.size(); ++i) {
-        indices.push_back(indexOf(start_positions[i], end_positions[i], sampling_interval, offset, range_matching));
+    size_t count = start_positions.size();
+    std::vector<ndsize_t> start_indices(count), end_indices(count);
+    std::unique_ptr<bool[]> valid(new bool[count]);
+    indexOf(start_positions.data(), end_positions.data(), count, start_indices.data(), end_indices.data(),
+            valid.get(), range_matching);
+
+    std::vector<boost::optional<std::pair<ndsize_t, ndsize_t>>> indices(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (valid[i]) {
+            indices[i] = std::pair<ndsize_t, ndsize_t>(start_indices[i], end_indices[i]);
+        }
     }
     return indices;
 }
 
+
+size_t SampledDimension::indexOf(const double *start_positions, const double *end_positions, size_t count,
+                                 ndsize_t *start_indices, ndsize_t *end_indices, bool *valid,
+                                 const RangeMatch range_matching) const {
+    if (count == 0) {
+        return 0;
+    }
+    double offset = backend()->offset() ? *(backend()->offset()) : 0.0;
+    double sampling_interval = backend()->samplingInterval();
+    return sampledIndices(start_positions, end_positions, count, sampling_interval, offset,
+                          range_matching == RangeMatch::Exclusive, start_indices, end_indices, valid);
+}
+
 std::vector<std::pair<ndsize_t, ndsize_t>> SampledDimension::indexOf(const std::vector<double> &start_positions,
                                                                      const std::vector<double> &end_positions) const {
     if (start_positions.size() != end_positions.size()) {
@@ -17,6 +17,11 @@
 #include <nix/valid/validate.hpp>
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <thread>
+
 namespace bfs = boost::filesystem;
 
 namespace nix {
@@ -26,7 +31,7 @@ File File::open(const std::string &name,
                 const std::string &impl,
                 Compression compression,
                 OpenFlags flags) {
-    if (mode == nix::FileMode::ReadOnly && !bfs::exists(bfs::path{name})) {
+    if ((mode == nix::FileMode::ReadOnly || mode == nix::FileMode::SwmrRead) && !bfs::exists(bfs::path{name})) {
         throw std::runtime_error("Cannot open non-existent file in ReadOnly mode!");
     }
     if (compression == Compression::Auto) {
@@ -38,6 +43,8 @@ File File::open(const std::string &name,
 #ifdef  ENABLE_FS_BACKEND
     else if (impl == "file") {
          return File(std::make_shared<file::FileFS>(name, mode, compression));
+    } else if (impl == "file-packed") {
+         return File(std::make_shared<file::FileFS>(name, mode, compression, file::AttributeFormat::Packed));
     }
 #endif
     else {
@@ -46,6 +53,73 @@ File File::open(const std::string &name,
 }
 
 
+File File::fromImage(const void *image, size_t size, FileMode mode, Compression compression) {
+    if (compression == Compression::Auto) {
+         compression = Compression::None;
+    }
+    return File(std::make_shared<hdf5::FileHDF5>(image, size, mode, compression));
+}
+
+
+FileHeader File::probe(const std::string &name, const std::string &impl) {
+    if (impl != "hdf5") {
+        throw std::runtime_error("Unknown implementation!");
+    }
+    return hdf5::FileHDF5::probe(name);
+}
+
+
+// read the beginning of a file, where HDF5 keeps the root group and its
+// attributes in small files, into the page cache
+static void read_ahead(const std::string &name) {
+    std::ifstream in(name, std::ios::binary);
+    std::vector<char> buffer(64 * 1024);
+    in.read(buffer.data(), buffer.size());
+}
+
+
+std::vector<FileHeader> File::probe(const std::vector<std::string> &names, size_t threads,
+                                    const std::string &impl) {
+    if (impl != "hdf5") {
+        throw std::runtime_error("Unknown implementation!");
+    }
+
+    if (threads == 0) {
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    threads = std::min(threads, names.size());
+
+    std::vector<FileHeader> headers(names.size());
+    std::atomic<size_t> next(0);
+    auto work = [&] {
+        for (size_t i = next++; i < names.size(); i = next++) {
+            read_ahead(names[i]);
+            headers[i] = hdf5::FileHDF5::probe(names[i]);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < threads; i++) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (auto &t : pool) {
+        t.join();
+    }
+
+    return headers;
+}
+
+
+RepackReport File::repack(const std::string &source, const std::string &destination,
+                          const RepackOptions &options, const std::string &impl) {
+    if (impl != "hdf5") {
+        throw std::runtime_error("Unknown implementation!");
+    }
+    return hdf5::FileHDF5::repack(source, destination, options);
+}
+
+
 bool File::flush() {
     return backend()->flush();
 }
@@ -60,6 +134,17 @@ Block File::createBlock(const std::string &name, const std::string &type) {
 }
 
 
+Block File::copyBlock(const Block &source, const std::string &name) {
+    util::checkEntityInput(source);
+    const std::string copy_name = name.empty() ? source.name() : name;
+    util::checkEntityName(copy_name);
+    if (backend()->hasBlock(copy_name)) {
+        throw DuplicateName("Block with the given name already exists!");
+    }
+    return backend()->copyBlock(source.impl(), copy_name);
+}
+
+
 bool File::hasBlock(const Block &block) const {
     if(!util::checkEntityInput(block, false)) {
         return false;
@@ -92,6 +177,17 @@ Section File::createSection(const std::string &name, const std::string &type) {
 }
 
 
+Section File::copySection(const Section &source, const std::string &name) {
+    util::checkEntityInput(source);
+    const std::string copy_name = name.empty() ? source.name() : name;
+    util::checkEntityName(copy_name);
+    if (backend()->hasSection(copy_name)) {
+        throw DuplicateName("Section with the given name already exists!");
+    }
+    return backend()->copySection(source.impl(), copy_name);
+}
+
+
 bool File::hasSection(const Section &section) const {
     if(!util::checkEntityInput(section, false)) {
         return false;
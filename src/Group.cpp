@@ -14,16 +14,13 @@ using namespace nix;
 template<typename T>
 void Group::replaceEntities(const std::vector<T> &entities)
 {
-    base::IGroup *ig = backend();
-    ObjectType ot = objectToType<T>::value;
-
-    while (ig->entityCount(ot) > 0) {
-        ig->removeEntity(ig->getEntity<typename objectToType<T>::backendType>(0));
-    }
-
+    std::vector<nix::Identity> idents;
+    idents.reserve(entities.size());
     for (const auto &e : entities) {
-        ig->addEntity(e);
+        idents.emplace_back(e);
     }
+
+    backend()->entities(objectToType<T>::value, idents);
 }
 
 void Group::dataArrays(const std::vector<DataArray> &data_arrays) {
@@ -0,0 +1,18 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/MappedData.hpp>
+#include <nix/base/IFile.hpp>
+
+namespace nix {
+
+bool MappedData::valid() const {
+    return file && file->isOpen();
+}
+
+} // namespace nix
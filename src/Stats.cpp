@@ -0,0 +1,95 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/Stats.hpp>
+
+#include "hdf5/h5x/H5Stats.hpp"
+
+#include <iomanip>
+
+namespace nix {
+
+const char *Stats::name(StatOp op) {
+    static const char *names[] = {
+        "group.open",
+        "group.create",
+        "link.exists",
+        "link.name",
+        "link.iterate",
+        "object.open",
+        "dataset.open",
+        "dataset.create",
+        "dataset.read",
+        "dataset.write",
+        "dataset.extent",
+        "dataset.info",
+        "vlen.reclaim",
+        "attr.exists",
+        "attr.open",
+        "attr.create",
+        "attr.read",
+        "attr.write"
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == static_cast<size_t>(StatOp::Count),
+                  "every StatOp needs a name");
+
+    const size_t i = static_cast<size_t>(op);
+    return i < static_cast<size_t>(StatOp::Count) ? names[i] : "unknown";
+}
+
+Stats stats() {
+    Stats s;
+#ifdef NIX_STATS
+    s.enabled = true;
+#else
+    s.enabled = false;
+#endif
+
+    const hdf5::StatCounters *counters = hdf5::statCounters();
+    for (size_t i = 0; i < s.ops.size(); i++) {
+        s.ops[i].calls = counters[i].calls.load(std::memory_order_relaxed);
+        s.ops[i].nanos = counters[i].nanos.load(std::memory_order_relaxed);
+        s.ops[i].bytes = counters[i].bytes.load(std::memory_order_relaxed);
+        s.ops[i].file_bytes = counters[i].file_bytes.load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+void resetStats() {
+    hdf5::StatCounters *counters = hdf5::statCounters();
+    for (size_t i = 0; i < static_cast<size_t>(StatOp::Count); i++) {
+        counters[i].calls.store(0, std::memory_order_relaxed);
+        counters[i].nanos.store(0, std::memory_order_relaxed);
+        counters[i].bytes.store(0, std::memory_order_relaxed);
+        counters[i].file_bytes.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::ostream &operator<<(std::ostream &out, const Stats &stats) {
+    if (!stats.enabled) {
+        return out << "stats: not enabled (build with -DENABLE_STATS=ON)" << std::endl;
+    }
+
+    for (size_t i = 0; i < stats.ops.size(); i++) {
+        const OpStats &op = stats.ops[i];
+        if (op.calls == 0) {
+            continue;
+        }
+        out << std::left << std::setw(16) << Stats::name(static_cast<StatOp>(i)) << std::right
+            << " calls: " << std::setw(9) << op.calls
+            << " ms: " << std::setw(10) << std::fixed << std::setprecision(3) << op.nanos / 1e6
+            << " us/call: " << std::setw(8) << op.nanos / 1e3 / op.calls;
+        if (op.bytes > 0 || op.file_bytes > 0) {
+            out << " bytes: " << op.bytes << " file bytes: " << op.file_bytes;
+        }
+        out << std::endl;
+    }
+    return out;
+}
+
+} // namespace nix
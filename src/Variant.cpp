@@ -13,12 +13,16 @@
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <new>
 
 namespace nix {
 
 void Variant::maybe_deallocte_string() {
     if (dtype == DataType::String) {
-        std::free(v_string);
+        if (heap) {
+            std::free(v_string);
+            heap = false;
+        }
         dtype = DataType::Nothing;
     }
 }
@@ -82,16 +86,34 @@ void Variant::set(const std::string &value) {
 void Variant::set(const char *value, const size_t len) {
 
     const size_t len_plus_null = len + 1;
-    void *data;
 
-    if (dtype != DataType::String) {
+    if (len_plus_null <= small_string_size) {
+        // value might point into our own buffer, copy it first
+        char tmp[small_string_size];
+        std::memcpy(tmp, value, len);
+        maybe_deallocte_string();
         dtype = DataType::String;
-        data = std::malloc(len_plus_null);
-    } else {
+        std::memcpy(v_small, tmp, len);
+        v_small[len] = '\0';
+        return;
+    }
+
+    void *data;
+
+    if (dtype == DataType::String && heap) {
         data = std::realloc(v_string, len_plus_null);
+    } else {
+        data = std::malloc(len_plus_null);
+    }
+
+    if (data == nullptr) {
+        throw std::bad_alloc();
     }
 
     std::memcpy(data, value, len);
+
+    dtype = DataType::String;
+    heap = true;
     v_string = static_cast<char *>(data);
     v_string[len] = '\0';
 }
@@ -140,7 +162,7 @@ void Variant::get(double &value) const {
 
 void Variant::get(std::string &value) const {
     check_argument_type(DataType::String);
-    value = v_string;
+    value = string_data();
 }
 
 /* swap and swap helpers */
@@ -154,25 +176,20 @@ void Variant::get(std::string &value) const {
 
 void Variant::swap(Variant &other) {
     Variant tmp(std::move(*this));
-    assign_variant_from(other);
+    *this = std::move(other);
     other = std::move(tmp);
 }
 
 void Variant::assign_variant_from(const Variant &other) {
-    switch (other.dtype) {
-        case DataType::Bool:    set(other.v_bool);   break;
-        case DataType::Int32:   set(other.v_int32);  break;
-        case DataType::UInt32:  set(other.v_uint32); break;
-        case DataType::Int64:   set(other.v_int64);  break;
-        case DataType::UInt64:  set(other.v_uint64); break;
-        case DataType::Double:  set(other.v_double); break;
-        case DataType::String:  set(other.v_string); break;
-        case DataType::Nothing: set(none);           break;
-
-#ifndef CHECK_SUPPORTED_VALUES
-        default: assert(DATATYPE_SUPPORT_NOT_IMPLEMENTED);
-#endif
+    if (other.dtype != DataType::String || !other.heap) {
+        // plain values and inline strings are just bytes
+        maybe_deallocte_string();
+        dtype = other.dtype;
+        std::memcpy(v_small, other.v_small, small_string_size);
+        return;
     }
+
+    set(other.v_string, std::strlen(other.v_string));
 }
 
 
@@ -35,14 +35,18 @@ void scalePositions(const vector<double> &starts, const vector<double> &ends,
     if (scaled_ends.size() != count)
         scaled_ends.resize(count);
     double scaling= 1.0;
+    const string *scaled_unit = nullptr;
     for (size_t i = 0; i < count; ++i) {
-        if (i < units.size() && units[i] != "none" && dim_unit != "none") {
+        // positions mostly share one unit, only look up the scaling when it changes
+        if (i < units.size() && units[i] != "none" && dim_unit != "none" &&
+            (scaled_unit == nullptr || *scaled_unit != units[i])) {
             try {
                 scaling = util::getSIScaling(units[i], dim_unit);
             } catch (...) {
                 throw nix::IncompatibleDimensions("Provided units are not scalable!",
                                                   "nix::util::positionToIndex");
             }
+            scaled_unit = &units[i];
         }
         scaled_starts[i] = starts[i] * scaling;
         scaled_ends[i] = ends[i] * scaling;
@@ -409,11 +413,82 @@ void getOffsetAndCount(const Tag &tag, const DataArray &array, NDSize &offset, N
 }
 
 
-void getOffsetAndCount(const MultiTag &tag, const DataArray &array, const vector<ndsize_t> &indices,
-                       vector<NDSize> &offsets, vector<NDSize> &counts, RangeMatch match) {
+ResolvedMultiTag::ResolvedMultiTag(const MultiTag &tag)
+    : ResolvedMultiTag(tag, 0, tag.positions() ? tag.positions().dataExtent()[0] : 0) {
+}
+
+
+ResolvedMultiTag::ResolvedMultiTag(const MultiTag &tag, ndsize_t first, ndsize_t count)
+    : mtag(tag), first_index(first), nrows(count), nextent_rows(0), has_extents(false) {
     DataArray positions = tag.positions();
+    if (!positions) {
+        throw UninitializedEntity();
+    }
+
+    NDSize position_size = positions.dataExtent();
+    if (first > position_size[0] || count > position_size[0] - first) {
+        throw OutOfBounds("Index out of bounds of positions or extents!", 0);
+    }
+
+    size_t ncols = position_size.size() > 1 ?
+        check::fits_in_size_t(position_size[1], "ResolvedMultiTag: number of position columns > size_t.") : 1;
+    position_cols.resize(ncols);
+    readColumns(positions, position_cols, nrows);
+
     DataArray extents = tag.extents();
-    NDSize position_size, extent_size;
+    if (extents) {
+        has_extents = true;
+        ndsize_t extent_rows = extents.dataExtent()[0];
+        nextent_rows = extent_rows > first ? std::min(count, extent_rows - first) : 0;
+        extent_cols.resize(ncols);
+        readColumns(extents, extent_cols, nextent_rows);
+    }
+
+    tag_units = tag.units();
+}
+
+
+void ResolvedMultiTag::readColumns(const DataArray &array, vector<vector<double>> &cols, ndsize_t rows) const {
+    // read whole rows, in blocks to keep the temporary buffer small
+    const ndsize_t block_rows = 65536;
+    const NDSize size = array.dataExtent();
+    const size_t ncols = std::min(cols.size(), size.size() > 1 ? static_cast<size_t>(size[1]) : size_t(1));
+    const size_t nrows = check::fits_in_size_t(rows, "ResolvedMultiTag: number of positions > size_t.");
+
+    for (auto &col : cols) {
+        col.assign(nrows, 0.0);
+    }
+
+    vector<double> buffer;
+    for (ndsize_t row = 0; row < rows; row += block_rows) {
+        const ndsize_t n = std::min(block_rows, rows - row);
+        NDSize count(size.size(), 1);
+        NDSize offset(size.size(), 0);
+        count[0] = n;
+        offset[0] = first_index + row;
+        if (size.size() > 1) {
+            count[1] = ncols;
+        }
+
+        buffer.resize(static_cast<size_t>(n) * ncols);
+        array.getData(DataType::Double, buffer.data(), count, offset);
+
+        for (size_t c = 0; c < ncols; c++) {
+            double *col = cols[c].data() + row;
+            for (size_t i = 0; i < n; i++) {
+                col[i] = buffer[i * ncols + c];
+            }
+        }
+    }
+}
+
+
+void getOffsetAndCount(const ResolvedMultiTag &tag, const DataArray &array, const vector<ndsize_t> &indices,
+                       vector<NDSize> &offsets, vector<NDSize> &counts, RangeMatch match) {
+    if (indices.empty()) {
+        return;
+    }
+
     ndsize_t dimension_count = array.dimensionCount();
     vector<Dimension> dimensions = array.dimensions();
     vector<string> units = tag.units();
@@ -421,59 +496,38 @@ void getOffsetAndCount(const MultiTag &tag, const DataArray &array, const vector
     while (units.size() < dimension_count) {
         units.push_back("none");
     }
-    vector<pair<double, double>> max_extents;
-    if (position_size.size() < dimension_count) {
-        max_extents = maximumExtents(array);
-    }
-    if (positions) {
-        position_size = positions.dataExtent();
-    }
-    if (extents) {
-        extent_size = extents.dataExtent();
-    }
-    ndsize_t max_index = *max_element(indices.begin(), indices.end());
-    if (max_index >= positions.dataExtent()[0] || (extents && max_index >= extents.dataExtent()[0])) {
-        throw OutOfBounds("Index out of bounds of positions or extents!", 0);
+
+    for (ndsize_t index : indices) {
+        if (!tag.contains(index)) {
+            throw OutOfBounds("Index out of bounds of positions or extents!", 0);
+        }
     }
 
     size_t dimcount_sizet = check::fits_in_size_t(dimension_count, "getOffsetAndCount() failed; dimension count > size_t.");
 
-    NDSize temp_offset(positions.dataExtent().size(), static_cast<NDSize::value_type>(0));
-    NDSize temp_count(positions.dataExtent().size(), static_cast<NDSize::value_type>(1));
-
-    int dim_index = dimension_count > 1 ? 1 : 0;
-    ndsize_t count = dimension_count > 1 ? position_size[dim_index] : 1;
-    temp_count[dim_index] = static_cast<NDSize::value_type>(count);
-
-    vector<vector<double>> start_positions(dimension_count);
-    vector<vector<double>> end_positions(dimension_count);
-    vector<double> offset, extent;
-    for (size_t idx = 0; idx < indices.size(); ++idx) {
-        temp_offset[0] = indices[idx];
-        positions.getData(offset, temp_count, temp_offset);
-        if (extents) {
-            extents.getData(extent, temp_count, temp_offset);
-        } else {
-            extent.resize(offset.size(), 0.0);
-        }
-        // add pos/extents if missing
-        while (offset.size() < dimensions.size()) {
-            offset.push_back(get<0>(max_extents[offset.size()]));
-            extent.push_back(get<1>(max_extents[extent.size()]));
-        }
-        // throw away info, if not needed
-        while (offset.size() > dimensions.size()) {
-            offset.pop_back();
-            extent.pop_back();
-        }
+    // a 1-d array only ever uses the first column, missing columns span the whole dimension
+    const size_t used_cols = std::min(tag.columns(), dimcount_sizet);
+    vector<pair<double, double>> max_extents;
+    if (used_cols < dimcount_sizet) {
+        max_extents = maximumExtents(array);
+    }
+
+    vector<vector<double>> start_positions(dimcount_sizet, vector<double>(indices.size()));
+    vector<vector<double>> end_positions(dimcount_sizet, vector<double>(indices.size()));
+    for (size_t dim_index = 0; dim_index < dimcount_sizet; ++dim_index) {
+        vector<double> &starts = start_positions[dim_index];
+        vector<double> &ends = end_positions[dim_index];
 
-        for (size_t dim_index = 0; dim_index < dimensions.size(); ++dim_index) {
-            if (idx == 0) {
-                start_positions[dim_index] = vector<double>(indices.size());
-                end_positions[dim_index] = vector<double>(indices.size());
+        if (dim_index < used_cols) {
+            const vector<double> &pos = tag.positions(dim_index);
+            for (size_t idx = 0; idx < indices.size(); ++idx) {
+                const size_t row = static_cast<size_t>(indices[idx] - tag.first());
+                starts[idx] = pos[row];
+                ends[idx] = pos[row] + (tag.hasExtents() ? tag.extents(dim_index)[row] : 0.0);
             }
-            start_positions[dim_index][idx] = offset[dim_index];
-            end_positions[dim_index][idx] = offset[dim_index] + extent[dim_index];
+        } else {
+            std::fill(starts.begin(), starts.end(), get<0>(max_extents[dim_index]));
+            std::fill(ends.begin(), ends.end(), get<0>(max_extents[dim_index]) + get<1>(max_extents[dim_index]));
         }
     }
 
@@ -482,11 +536,12 @@ void getOffsetAndCount(const MultiTag &tag, const DataArray &array, const vector
         vector<string> temp_units(start_positions[dim_index].size(), units[dim_index]);
         vector<optional<pair<ndsize_t, ndsize_t>>> ranges = positionToIndex(start_positions[dim_index], end_positions[dim_index],
                                                                             temp_units, match, dimensions[dim_index]);
-                                                                          
         data_indices.push_back(ranges);
     }
     // at this point we do have all the start and end indices of the tagged positions that the caller wants the data of.
     // data_indices contains for each dimension a vector of optionals, one for each position index
+    offsets.reserve(offsets.size() + indices.size());
+    counts.reserve(counts.size() + indices.size());
     for (size_t i = 0; i < indices.size(); ++i) {  // for each of the requested positions
         NDSize data_offset(dimcount_sizet, 0);
         NDSize data_count(dimcount_sizet, 1);
@@ -498,19 +553,34 @@ void getOffsetAndCount(const MultiTag &tag, const DataArray &array, const vector
                 data_count[dim_index] += count;
             } else {
                 if (end_positions[dim_index][i] == start_positions[dim_index][i]) {
-                    optional<ndsize_t> ofst = positionToIndex(end_positions[dim_index][i], units[dim_index], PositionMatch::GreaterOrEqual, dimensions[dim_index]);  
+                    optional<ndsize_t> ofst = positionToIndex(end_positions[dim_index][i], units[dim_index], PositionMatch::GreaterOrEqual, dimensions[dim_index]);
                     if (!ofst) {
                         throw nix::OutOfBounds("util::offsetAndCount:An invalid range was encountered!");
                     }
-                    temp_offset[i] = *ofst;
+                    data_offset[dim_index] = *ofst;
                 }
-            }   
+            }
         }
         offsets.push_back(data_offset);
         counts.push_back(data_count);
     }
 }
 
+
+void getOffsetAndCount(const MultiTag &tag, const DataArray &array, const vector<ndsize_t> &indices,
+                       vector<NDSize> &offsets, vector<NDSize> &counts, RangeMatch match) {
+    if (indices.empty()) {
+        return;
+    }
+    // only resolve the window of positions that is actually needed
+    auto minmax = std::minmax_element(indices.begin(), indices.end());
+    if (!tag.positions() || *minmax.second >= tag.positions().dataExtent()[0]) {
+        throw OutOfBounds("Index out of bounds of positions or extents!", 0);
+    }
+    ResolvedMultiTag resolved(tag, *minmax.first, *minmax.second - *minmax.first + 1);
+    getOffsetAndCount(resolved, array, indices, offsets, counts, match);
+}
+
 void getOffsetAndCount(const MultiTag &tag, const DataArray &array, ndsize_t index, NDSize &offsets, NDSize &counts, RangeMatch match) {
     vector<NDSize> temp_offsets, temp_counts;
     getOffsetAndCount(tag, array, {index}, temp_offsets, temp_counts, match);
@@ -670,31 +740,47 @@ DataView taggedData(const MultiTag &tag, ndsize_t position_index,
     return taggedData(tag, position_indices, array, match)[0];
 }
 
-vector<DataView> taggedData(const MultiTag &tag, vector<ndsize_t> &position_indices,
+vector<DataView> taggedData(const ResolvedMultiTag &tag, vector<ndsize_t> &position_indices,
                             const DataArray &array, RangeMatch match) {
     vector<NDSize> counts, offsets;
     vector<DataView> views;
 
     if (position_indices.size() < 1) {
-        size_t pos_count = check::fits_in_size_t(tag.positions().dataExtent()[0],
-                                                 "Number of positions > size_t.");
+        size_t pos_count = check::fits_in_size_t(tag.positionCount(), "Number of positions > size_t.");
         position_indices.resize(pos_count);
-        std::iota(position_indices.begin(), position_indices.end(), 0);
+        std::iota(position_indices.begin(), position_indices.end(), tag.first());
     }
 
     getOffsetAndCount(tag, array, position_indices, offsets, counts, match);
 
+    const NDSize shape = array.dataExtent();
+    views.reserve(offsets.size());
     for (size_t i = 0; i < offsets.size(); ++i) {
-        if (!positionAndExtentInData(array, offsets[i], counts[i])) {
+        if (shape.size() != offsets[i].size() || !(offsets[i] + counts[i] <= shape)) {
             throw OutOfBounds("References data slice out of the extent of the DataArray!", 0);
         }
-        DataView io = DataView(array, counts[i], offsets[i]);
-        views.push_back(io);
+        views.emplace_back(array, counts[i], offsets[i]);
     }
     return views;
 }
 
 
+vector<DataView> taggedData(const MultiTag &tag, vector<ndsize_t> &position_indices,
+                            const DataArray &array, RangeMatch match) {
+    if (position_indices.size() < 1) {
+        ResolvedMultiTag resolved(tag);
+        return taggedData(resolved, position_indices, array, match);
+    }
+
+    auto minmax = std::minmax_element(position_indices.begin(), position_indices.end());
+    if (!tag.positions() || *minmax.second >= tag.positions().dataExtent()[0]) {
+        throw OutOfBounds("Index out of bounds of positions or extents!", 0);
+    }
+    ResolvedMultiTag resolved(tag, *minmax.first, *minmax.second - *minmax.first + 1);
+    return taggedData(resolved, position_indices, array, match);
+}
+
+
 DataView retrieveData(const Tag &tag, ndsize_t reference_index, RangeMatch match) {
     return taggedData(tag, reference_index, match);
 }
@@ -817,9 +903,39 @@ std::vector<DataView> retrieveFeatureData(const MultiTag &tag, std::vector<ndsiz
 }
 
 
+// feature data of indexed and untagged features, does not need positions or extents
+static std::vector<DataView> untaggedFeatureData(const std::vector<ndsize_t> &position_indices,
+                                                 const Feature &feature, const DataArray &data) {
+    std::vector<DataView> views;
+    const NDSize extent = data.dataExtent();
+    views.reserve(position_indices.size());
+
+    if (feature.linkType() == LinkType::Indexed) {
+        // For now we return slices across the first dim.
+        for (size_t idx = 0; idx < position_indices.size(); ++idx) {
+            NDSize offset(extent.size(), 0);
+            offset[0] = position_indices[idx];
+            NDSize count(extent);
+            count[0] = 1;
+            if (!(offset + count <= extent)) {
+                throw OutOfBounds("Requested data slice out of the extent of the Feature!",
+                                  position_indices[idx]);
+            }
+            views.emplace_back(data, count, offset);
+        }
+    } else {
+        for (size_t idx = 0; idx < position_indices.size(); ++idx){
+            // In the untagged case all data is returned for each position
+            NDSize offset(extent.size(), 0);
+            views.emplace_back(data, extent, offset);
+        }
+    }
+    return views;
+}
+
+
 std::vector<DataView> featureData(const MultiTag &tag, std::vector<ndsize_t> position_indices,
                                   const Feature &feature, RangeMatch match) {
-    std::vector<DataView> views;
     DataArray data = feature.data();
     if (data == nix::none) {
         throw UninitializedEntity();
@@ -831,38 +947,38 @@ std::vector<DataView> featureData(const MultiTag &tag, std::vector<ndsize_t> pos
         std::iota(position_indices.begin(), position_indices.end(), 0);
     }
     if (feature.linkType() == LinkType::Tagged) {
-        views = taggedData(tag, position_indices, data, match);
-        return views;
+        return taggedData(tag, position_indices, data, match);
     }
 
     ndsize_t max_index = *max_element(position_indices.begin(), position_indices.end());
     if (max_index >= tag.positions().dataExtent()[0]) {
         throw OutOfBounds("Index out of bounds of positions!", 0);
     }
+    return untaggedFeatureData(position_indices, feature, data);
+}
 
-    if (feature.linkType() == LinkType::Indexed) {
-        // For now we return slices across the first dim.
-        for (size_t idx = 0; idx < position_indices.size(); ++idx) {
-            NDSize offset(data.dataExtent().size(), 0);
-            offset[0] = position_indices[idx];
-            NDSize count(data.dataExtent());
-            count[0] = 1;
-            if (!positionAndExtentInData(data, offset, count)) {
-                throw OutOfBounds("Requested data slice out of the extent of the Feature!",
-                                  position_indices[idx]);
-            }
-            DataView io = DataView(data, count, offset);
-            views.push_back(io);
-        }
-    } else {
-        for (size_t idx = 0; idx < position_indices.size(); ++idx){
-            // In the untagged case all data is returned for each position
-            NDSize offset(data.dataExtent().size(), 0);
-            DataView io = DataView(data, data.dataExtent(), offset);
-            views.push_back(io);
+
+std::vector<DataView> featureData(const ResolvedMultiTag &tag, std::vector<ndsize_t> position_indices,
+                                  const Feature &feature, RangeMatch match) {
+    DataArray data = feature.data();
+    if (data == nix::none) {
+        throw UninitializedEntity();
+    }
+    if (position_indices.size() < 1) {
+        size_t pos_count = check::fits_in_size_t(tag.positionCount(), "Number of positions > size_t.");
+        position_indices.resize(pos_count);
+        std::iota(position_indices.begin(), position_indices.end(), tag.first());
+    }
+    if (feature.linkType() == LinkType::Tagged) {
+        return taggedData(tag, position_indices, data, match);
+    }
+
+    for (ndsize_t index : position_indices) {
+        if (index < tag.first() || index - tag.first() >= tag.positionCount()) {
+            throw OutOfBounds("Index out of bounds of positions!", 0);
         }
     }
-    return views;
+    return untaggedFeatureData(position_indices, feature, data);
 }
 
 
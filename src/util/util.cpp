@@ -14,14 +14,23 @@
 #include <cstdlib>
 #include <mutex>
 #include <random>
+#include <limits>
+#include <unordered_map>
 #include <math.h>
+#include <cmath>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/regex.hpp>
-#include <boost/random.hpp>
-#include <boost/uuid/uuid.hpp>
-#include <boost/uuid/uuid_generators.hpp>
-#include <boost/uuid/uuid_io.hpp>
 
 
 using namespace std;
@@ -40,13 +49,216 @@ const map<string, double> PREFIX_FACTORS = {{"y", 1.0e-24}, {"z", 1.0e-21}, {"a"
     {"p", 1.0e-12}, {"n",1.0e-9}, {"u", 1.0e-6}, {"m", 1.0e-3}, {"c", 1.0e-2}, {"d",1.0e-1}, {"da", 1.0e1}, {"h", 1.0e2},
     {"k", 1.0e3}, {"M",1.0e6}, {"G", 1.0e9}, {"T", 1.0e12}, {"P", 1.0e15}, {"E",1.0e18}, {"Z", 1.0e21}, {"Y", 1.0e24}};
 
+namespace {
+
+// The unit grammar, compiled once. Matching against a const regex is thread-safe.
+struct UnitRegexes {
+    const boost::regex prefix_and_unit_and_power;
+    const boost::regex prefix_and_unit;
+    const boost::regex unit_and_power;
+    const boost::regex unit_only;
+    const boost::regex prefix_only;
+    const boost::regex atomic_unit;
+    const boost::regex compound_unit;
+
+    UnitRegexes()
+        : prefix_and_unit_and_power(PREFIXES + UNITS + POWER),
+          prefix_and_unit(PREFIXES + UNITS),
+          unit_and_power(UNITS + POWER),
+          unit_only(UNITS),
+          prefix_only(PREFIXES),
+          atomic_unit(PREFIXES + "?" + UNITS + POWER + "?"),
+          compound_unit("(" + PREFIXES + "?" + UNITS + POWER + "?" + "(\\*|/))+" + PREFIXES + "?" + UNITS + POWER + "?") { }
+};
+
+const UnitRegexes &unitRegexes() {
+    static const UnitRegexes regexes;
+    return regexes;
+}
+
+struct ParsedUnit {
+    bool   atomic;
+    bool   compound;
+    string prefix;
+    string unit;
+    string power;
+};
+
+// Memoizes results by string key. Units come from a small set in practice,
+// the size limit only guards against unbounded growth.
+template<typename T>
+class UnitCache {
+public:
+    bool get(const string &key, T &value) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = entries.find(key);
+        if (it == entries.end()) {
+            return false;
+        }
+        value = it->second;
+        return true;
+    }
+
+    void put(const string &key, const T &value) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (entries.size() >= max_entries) {
+            entries.clear();
+        }
+        entries.emplace(key, value);
+    }
+
+private:
+    static const size_t max_entries = 4096;
+    std::mutex mtx;
+    std::unordered_map<string, T> entries;
+};
+
+void parseSplitUnit(const string &combinedUnit, string &prefix, string &unit, string &power) {
+    const UnitRegexes &re = unitRegexes();
+
+    if (boost::regex_match(combinedUnit, re.prefix_and_unit_and_power)) {
+        boost::match_results<std::string::const_iterator> m;
+        boost::regex_search(combinedUnit, m, re.prefix_only);
+        prefix = m[0];
+        string suffix = m.suffix();
+        boost::regex_search(suffix, m, re.unit_only);
+        unit = m[0];
+        power = m.suffix();
+        power = power.substr(1);
+    } else if (boost::regex_match(combinedUnit, re.unit_and_power)) {
+        prefix = "";
+        boost::match_results<std::string::const_iterator> m;
+        boost::regex_search(combinedUnit, m, re.unit_only);
+        unit = m[0];
+        power = m.suffix();
+        power = power.substr(1);
+    } else if (boost::regex_match(combinedUnit, re.prefix_and_unit)) {
+        boost::match_results<std::string::const_iterator> m;
+        boost::regex_search(combinedUnit, m, re.prefix_only);
+        prefix = m[0];
+        unit = m.suffix();
+        power = "";
+    } else {
+        unit = combinedUnit;
+        prefix = "";
+        power = "";
+    }
+}
+
+ParsedUnit parseUnit(const string &unit) {
+    static UnitCache<ParsedUnit> cache;
+
+    ParsedUnit parsed;
+    if (cache.get(unit, parsed)) {
+        return parsed;
+    }
+
+    const UnitRegexes &re = unitRegexes();
+    parsed.atomic = boost::regex_match(unit, re.atomic_unit);
+    parsed.compound = !unit.empty() && boost::regex_match(unit, re.compound_unit);
+    parseSplitUnit(unit, parsed.prefix, parsed.unit, parsed.power);
+
+    cache.put(unit, parsed);
+    return parsed;
+}
+
+} // anonymous namespace
+
+
+namespace {
+
+// bumped in the child after fork(), so that it does not continue the
+// id sequences of its parent
+std::atomic<unsigned> fork_generation(0);
+
+#ifndef _WIN32
+void on_fork_child() {
+    fork_generation++;
+}
+#endif
+
+// the two hex digits of every byte value
+struct HexTable {
+    char pairs[512];
+
+    HexTable() {
+        static const char digits[] = "0123456789abcdef";
+        for (int i = 0; i < 256; i++) {
+            pairs[2 * i] = digits[i >> 4];
+            pairs[2 * i + 1] = digits[i & 0xF];
+        }
+    }
+};
+
+class IdGenerator {
+public:
+    IdGenerator() : generation(~0u) { }
+
+    void next(char *out) {
+        if (generation != fork_generation.load(std::memory_order_relaxed)) {
+            seed();
+        }
+
+        uint64_t hi = engine();
+        uint64_t lo = engine();
+        // version 4 (random) and variant 1 as in RFC 4122
+        hi = (hi & 0xFFFFFFFFFFFF0FFFULL) | 0x0000000000004000ULL;
+        lo = (lo & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL;
+
+        // string positions of the 16 bytes, the dashes go in between
+        static const unsigned char pos[16] = {0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34};
+        static const HexTable hex;
+        for (int i = 0; i < 8; i++) {
+            memcpy(out + pos[i], hex.pairs + 2 * ((hi >> (56 - 8 * i)) & 0xFF), 2);
+            memcpy(out + pos[i + 8], hex.pairs + 2 * ((lo >> (56 - 8 * i)) & 0xFF), 2);
+        }
+        out[8] = out[13] = out[18] = out[23] = '-';
+    }
+
+private:
+    void seed() {
+#ifndef _WIN32
+        static std::once_flag registered;
+        std::call_once(registered, [] { pthread_atfork(nullptr, nullptr, on_fork_child); });
+#endif
+        generation = fork_generation.load();
+
+        // random_device alone may be deterministic on some platforms, so
+        // mix in the time, the thread and an address as well
+        std::random_device rd;
+        const uint64_t now = static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+        const uint64_t tid = static_cast<uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        const uint64_t addr = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(this));
+        std::seed_seq seq{rd(), rd(), rd(), rd(),
+                          static_cast<uint32_t>(now), static_cast<uint32_t>(now >> 32),
+                          static_cast<uint32_t>(tid), static_cast<uint32_t>(tid >> 32),
+                          static_cast<uint32_t>(addr), static_cast<uint32_t>(addr >> 32),
+                          static_cast<uint32_t>(generation)};
+        engine.seed(seq);
+    }
+
+    std::mt19937_64 engine;
+    unsigned        generation;
+};
+
+IdGenerator &idGenerator() {
+    static thread_local IdGenerator generator;
+    return generator;
+}
+
+} // anonymous namespace
+
 
 string createId() {
-    typedef boost::mt19937::result_type seed_type;
-    static boost::mt19937 ran(static_cast<seed_type>(std::time(0)));
-    static boost::uuids::basic_random_generator<boost::mt19937> gen(&ran);
-    boost::uuids::uuid u = gen();
-    return boost::uuids::to_string(u);
+    string id(36, '\0');
+    idGenerator().next(&id[0]);
+    return id;
+}
+
+
+void createId(string &id) {
+    id.resize(36);
+    idGenerator().next(&id[0]);
 }
 
 
@@ -116,39 +328,10 @@ std::string unitSanitizer(const std::string &unit) {
 }
 
 void splitUnit(const string &combinedUnit, string &prefix, string &unit, string &power) {
-    boost::regex prefix_and_unit_and_power(PREFIXES + UNITS + POWER);
-    boost::regex prefix_and_unit(PREFIXES + UNITS);
-    boost::regex unit_and_power(UNITS + POWER);
-    boost::regex unit_only(UNITS);
-    boost::regex prefix_only(PREFIXES);
-
-    if (boost::regex_match(combinedUnit, prefix_and_unit_and_power)) {
-        boost::match_results<std::string::const_iterator> m;
-        boost::regex_search(combinedUnit, m, prefix_only);
-        prefix = m[0];
-        string suffix = m.suffix();
-        boost::regex_search(suffix, m, unit_only);
-        unit = m[0];
-        power = m.suffix();
-        power = power.substr(1);
-    } else if (boost::regex_match(combinedUnit, unit_and_power)) {
-        prefix = "";
-        boost::match_results<std::string::const_iterator> m;
-        boost::regex_search(combinedUnit, m, unit_only);
-        unit = m[0];
-        power = m.suffix();
-        power = power.substr(1);
-    } else if (boost::regex_match(combinedUnit, prefix_and_unit)) {
-        boost::match_results<std::string::const_iterator> m;
-        boost::regex_search(combinedUnit, m, prefix_only);
-        prefix = m[0];
-        unit = m.suffix();
-        power = "";
-    } else {
-        unit = combinedUnit;
-        prefix = "";
-        power = "";
-    }
+    const ParsedUnit parsed = parseUnit(combinedUnit);
+    prefix = parsed.prefix;
+    unit = parsed.unit;
+    power = parsed.power;
 }
 
 
@@ -169,8 +352,7 @@ void invertPower(std::string &unit) {
 
 void splitCompoundUnit(const std::string &compoundUnit, std::vector<std::string> &atomicUnits) {
     string s = compoundUnit;
-    boost::regex opt_prefix_and_unit_and_power(PREFIXES + "?" + UNITS + POWER + "?");
-    boost::regex separator("(\\*|/)");
+    const boost::regex &opt_prefix_and_unit_and_power = unitRegexes().atomic_unit;
     boost::match_results<std::string::const_iterator> m;
     string sep;
     while (boost::regex_search(s, m, opt_prefix_and_unit_and_power) && (m.suffix().length() > 0)) {
@@ -202,15 +384,12 @@ bool isSIUnit(const string &unit) {
 
 
 bool isAtomicSIUnit(const string &unit) {
-    boost::regex opt_prefix_and_unit_and_power(PREFIXES + "?" + UNITS + POWER + "?");
-    return boost::regex_match(unit, opt_prefix_and_unit_and_power);
+    return parseUnit(unit).atomic;
 }
 
 
 bool isCompoundSIUnit(const string &unit) {
-    string atomic_unit = PREFIXES + "?" + UNITS + POWER + "?";
-    boost::regex compound_unit("(" + atomic_unit + "(\\*|/))+"+ atomic_unit);
-    return !unit.empty() && boost::regex_match(unit, compound_unit);
+    return parseUnit(unit).compound;
 }
 
 
@@ -225,11 +404,9 @@ bool isScalable(const string &unitA, const string &unitB) {
     if (!(isSIUnit(unitA) && isSIUnit(unitB))) {
         return false;
     }
-    string a_unit, a_prefix, a_power;
-    string b_unit, b_prefix, b_power;
-    splitUnit(unitA, a_prefix, a_unit, a_power);
-    splitUnit(unitB, b_prefix, b_unit, b_power);
-    if (!(a_unit == b_unit) || !(a_power == b_power) ) {
+    const ParsedUnit a = parseUnit(unitA);
+    const ParsedUnit b = parseUnit(unitB);
+    if (!(a.unit == b.unit) || !(a.power == b.power) ) {
         return false;
     }
     return true;
@@ -274,35 +451,51 @@ bool isSetAtSamePos(const vector<string> &unitsA, const vector<string> &unitsB)
 }
 
 
-double getSIScaling(const string &originUnit, const string &destinationUnit) {
+static double computeSIScaling(const string &originUnit, const string &destinationUnit) {
     double scaling = 1.0;
     if (!isScalable(originUnit, destinationUnit)) {
-        throw nix::InvalidUnit("Origin unit and destination unit are not scalable versions of the same SI unit!",
-                               "nix::util::getSIScaling");
+        return std::numeric_limits<double>::quiet_NaN();
     }
-    
-    string org_unit, org_prefix, org_power;
-    string dest_unit, dest_prefix, dest_power;
-    splitUnit(originUnit, org_prefix, org_unit, org_power);
-    splitUnit(destinationUnit, dest_prefix, dest_unit, dest_power);
 
-    if ((org_prefix == dest_prefix) && (org_power == dest_power)) {
+    const ParsedUnit org = parseUnit(originUnit);
+    const ParsedUnit dest = parseUnit(destinationUnit);
+
+    if ((org.prefix == dest.prefix) && (org.power == dest.power)) {
         return scaling;
     }
-    if (dest_prefix.empty() && !org_prefix.empty()) {
-        scaling = PREFIX_FACTORS.at(org_prefix);
-    } else if (org_prefix.empty() && !dest_prefix.empty()) {
-        scaling = 1.0 / PREFIX_FACTORS.at(dest_prefix);
-    } else if (!org_prefix.empty() && !dest_prefix.empty()) {
-        scaling = PREFIX_FACTORS.at(org_prefix) / PREFIX_FACTORS.at(dest_prefix);
+    if (dest.prefix.empty() && !org.prefix.empty()) {
+        scaling = PREFIX_FACTORS.at(org.prefix);
+    } else if (org.prefix.empty() && !dest.prefix.empty()) {
+        scaling = 1.0 / PREFIX_FACTORS.at(dest.prefix);
+    } else if (!org.prefix.empty() && !dest.prefix.empty()) {
+        scaling = PREFIX_FACTORS.at(org.prefix) / PREFIX_FACTORS.at(dest.prefix);
     }
-    if (!org_power.empty()) {
-        int power = std::stoi(org_power);
+    if (!org.power.empty()) {
+        int power = std::stoi(org.power);
         scaling = pow(scaling, power);
     }
     return scaling;
 }
 
+
+double getSIScaling(const string &originUnit, const string &destinationUnit) {
+    static UnitCache<double> cache;
+
+    // units never contain a newline, so this is unambiguous
+    const string key = originUnit + '\n' + destinationUnit;
+    double scaling;
+    if (!cache.get(key, scaling)) {
+        scaling = computeSIScaling(originUnit, destinationUnit);
+        cache.put(key, scaling);
+    }
+
+    if (std::isnan(scaling)) {
+        throw nix::InvalidUnit("Origin unit and destination unit are not scalable versions of the same SI unit!",
+                               "nix::util::getSIScaling");
+    }
+    return scaling;
+}
+
 void applyPolynomial(const std::vector<double> &coefficients,
                      double origin,
                      const double *input,
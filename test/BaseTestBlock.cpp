@@ -8,6 +8,7 @@
 
 #include "BaseTestBlock.hpp"
 
+#include <algorithm>
 #include <iterator>
 #include <boost/math/constants/constants.hpp>
 
@@ -331,6 +332,134 @@ void BaseTestBlock::testMultiTagAccess() {
 }
 
 
+void BaseTestBlock::testDeleteEntities() {
+    DataArray da_1 = block.createDataArray("array 1", "test", DataType::Double, NDSize({ 4 }));
+    DataArray da_2 = block.createDataArray("array 2", "test", DataType::Double, NDSize({ 4 }));
+    DataArray da_3 = block.createDataArray("array 3", "test", DataType::Double, NDSize({ 4 }));
+    Source src = block.createSource("source", "test");
+    Source child = src.createSource("child", "test");
+
+    Tag tag = block.createTag("tag", "test", std::vector<double>{ 0.0 });
+    tag.references({da_1, da_2, da_3});
+    tag.createFeature(da_2, LinkType::Untagged);
+    tag.addSource(child);
+    MultiTag mtag = block.createMultiTag("mtag", "test", da_3);
+    mtag.addReference(da_1);
+    Group g = block.createGroup("group", "test");
+    g.dataArrays({da_1, da_2});
+    da_3.addSource(child);
+
+    // links of a deleted tag to deleted arrays are removed as well
+    Tag gone = block.createTag("gone", "test", std::vector<double>{ 0.0 });
+    gone.addReference(da_1);
+
+    std::vector<std::string> removed = block.deleteEntities({da_1, da_2, src, gone});
+
+    // 2 arrays + 1 source + tag, 3 references, 1 feature, 1 multi tag
+    // reference, 2 group members, child source with its 2 links
+    CPPUNIT_ASSERT_EQUAL(size_t(14), removed.size());
+    CPPUNIT_ASSERT(std::find(removed.begin(), removed.end(), "data_arrays/array 1") != removed.end());
+
+    CPPUNIT_ASSERT(block.dataArrayCount() == 1);
+    CPPUNIT_ASSERT(block.hasDataArray(da_3));
+    CPPUNIT_ASSERT(block.sourceCount() == 0);
+    CPPUNIT_ASSERT(block.tagCount() == 1);
+    CPPUNIT_ASSERT(tag.referenceCount() == 1 && tag.hasReference(da_3));
+    CPPUNIT_ASSERT(tag.sourceCount() == 0);
+    CPPUNIT_ASSERT(mtag.referenceCount() == 0);
+    CPPUNIT_ASSERT(mtag.positions().id() == da_3.id());
+    CPPUNIT_ASSERT(g.dataArrayCount() == 0);
+    CPPUNIT_ASSERT(da_3.sourceCount() == 0);
+
+    CPPUNIT_ASSERT(block.deleteEntities({}).empty());
+    CPPUNIT_ASSERT(block.deleteEntities({nix::Identity(da_3.name(), ObjectType::Tag)}).empty());
+    // the array, its reference and the positions of the multi tag
+    CPPUNIT_ASSERT(block.deleteEntities({da_3}).size() == 3);
+    CPPUNIT_ASSERT(block.dataArrayCount() == 0);
+}
+
+
+void BaseTestBlock::testCopyEntities() {
+    std::vector<double> values(1000);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<double>(i) / 10.0;
+    }
+    DataArray da = block.createDataArray("array", "test", values, DataType::Double, Compression::DeflateNormal);
+    da.appendAliasRangeDimension();
+    da.metadata(section);
+    Source src = block.createSource("source", "test");
+    Source child = src.createSource("child", "test");
+    da.addSource(child);
+    DataArray pos = block.createDataArray("positions", "test", DataType::Double, NDSize({ 2 }));
+    Tag tag = block.createTag("tag", "test", std::vector<double>{ 1.0 });
+    tag.addReference(da);
+    tag.createFeature(pos, LinkType::Untagged);
+    DataFrame df = block.createDataFrame("frame", "test", {{"name", "", DataType::String},
+                                                           {"value", "mV", DataType::Double}});
+    df.rows(2);
+    df.writeRow(1, {Variant("b"), Variant(2.5)});
+
+    // within the same block the links stay as they are
+    Tag tag_copy = block.copyTag(tag, "tag copy");
+    CPPUNIT_ASSERT(tag_copy.id() != tag.id());
+    CPPUNIT_ASSERT_EQUAL(std::string("tag copy"), tag_copy.name());
+    CPPUNIT_ASSERT(tag_copy.referenceCount() == 1 && tag_copy.hasReference(da));
+    CPPUNIT_ASSERT(tag_copy.featureCount() == 1);
+    CPPUNIT_ASSERT(tag_copy.getFeature(0).id() != tag.getFeature(0).id());
+    CPPUNIT_ASSERT_EQUAL(pos.id(), tag_copy.getFeature(0).data().id());
+    CPPUNIT_ASSERT(tag_copy.position() == tag.position());
+    CPPUNIT_ASSERT_THROW(block.copyTag(tag, "tag copy"), DuplicateName);
+    CPPUNIT_ASSERT_THROW(block.copyTag(tag), DuplicateName);
+
+    // into another block the linked entities are copied along
+    DataArray da_copy = block_other.copyDataArray(da);
+    CPPUNIT_ASSERT(da_copy.id() != da.id());
+    CPPUNIT_ASSERT_EQUAL(da.name(), da_copy.name());
+    CPPUNIT_ASSERT_EQUAL(da.dataExtent(), da_copy.dataExtent());
+    CPPUNIT_ASSERT_EQUAL(da.dataChunks(), da_copy.dataChunks());
+    std::vector<double> data;
+    da_copy.getData(data);
+    CPPUNIT_ASSERT(data == values);
+    CPPUNIT_ASSERT(da_copy.getDimension(1).asRangeDimension().alias());
+    CPPUNIT_ASSERT_EQUAL(section.id(), da_copy.metadata().id());
+    CPPUNIT_ASSERT(da_copy.sourceCount() == 1);
+    Source child_copy = da_copy.getSource(0);
+    CPPUNIT_ASSERT(child_copy.id() != child.id());
+    CPPUNIT_ASSERT_EQUAL(child_copy.id(), block_other.getSource("child").id());
+
+    Tag tag_other = block_other.copyTag(tag);
+    CPPUNIT_ASSERT(tag_other.hasReference(da_copy));
+    CPPUNIT_ASSERT_EQUAL(block_other.getDataArray("positions").id(), tag_other.getFeature(0).data().id());
+    CPPUNIT_ASSERT(block_other.dataArrayCount() == 2);
+
+    Source src_copy = block_other.copySource(src);
+    CPPUNIT_ASSERT(src_copy.sourceCount() == 1 && src_copy.getSource(0).id() != child.id());
+
+    DataFrame df_copy = block_other.copyDataFrame(df, "frame copy");
+    CPPUNIT_ASSERT(df_copy.rows() == 2);
+    CPPUNIT_ASSERT(df_copy.readRow(1) == df.readRow(1));
+
+    // into another file the metadata is copied as well
+    File other = File::open("test_block_copy.h5", FileMode::Overwrite);
+    Block b = other.createBlock("copies", "test");
+    DataArray da_far = b.copyDataArray(da, "far");
+    CPPUNIT_ASSERT_EQUAL(std::string("far"), da_far.name());
+    da_far.getData(data);
+    CPPUNIT_ASSERT(data == values);
+    CPPUNIT_ASSERT(other.sectionCount() == 1);
+    CPPUNIT_ASSERT(da_far.metadata().id() != section.id());
+    CPPUNIT_ASSERT_EQUAL(section.name(), da_far.metadata().name());
+    CPPUNIT_ASSERT_EQUAL(da_far.id(), b.getDataArray("far").id());
+    CPPUNIT_ASSERT(b.copyTag(tag).hasReference("array"));
+    CPPUNIT_ASSERT(other.sectionCount() == 1);
+    other.close();
+
+    // the original is left alone
+    CPPUNIT_ASSERT(block.dataArrayCount() == 2 && block.tagCount() == 2 && block.sourceCount() == 1);
+    CPPUNIT_ASSERT(da.sourceCount() == 1 && da.getSource(0).id() == child.id());
+}
+
+
 void BaseTestBlock::testGroupAccess() {
     std::vector<std::string> names = { "group_a", "group_b", "group_c", "group_d", "group_e" };
     Group g;
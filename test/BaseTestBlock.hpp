@@ -36,6 +36,8 @@ public:
     void testTagAccess();
     void testMultiTagAccess();
     void testGroupAccess();
+    void testDeleteEntities();
+    void testCopyEntities();
 
     void testOperators();
     void testUpdatedAt();
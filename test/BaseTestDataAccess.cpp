@@ -662,6 +662,229 @@ void BaseTestDataAccess::testDataView() {
 }
 
 
+void BaseTestDataAccess::testDataViewReadAhead() {
+    typedef boost::multi_array<int32_t, 2> array_type;
+    array_type values(boost::extents[1000][4]);
+    for (size_t i = 0; i < 1000; i++) {
+        for (size_t j = 0; j < 4; j++) {
+            values[i][j] = static_cast<int32_t>(i * 4 + j);
+        }
+    }
+    nix::DataArray da = block.createDataArray("read ahead", "test", values);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), da.dataChunks().size());
+
+    DataView view(da, {800, 3}, {100, 1});
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), view.readAhead());
+    view.readAhead(64 * 3 * sizeof(double));
+    CPPUNIT_ASSERT_EQUAL(64 * 3 * sizeof(double), view.readAhead());
+
+    // sliding windows of 10 rows, as doubles and ints
+    std::vector<double> window(10 * 3);
+    NDSize window_offset(2, 0);
+    for (ndsize_t start = 0; start + 10 <= 800; start += 5) {
+        window_offset[0] = start;
+        view.getData(DataType::Double, window.data(), {10, 3}, window_offset);
+        for (size_t i = 0; i < 10; i++) {
+            for (size_t j = 0; j < 3; j++) {
+                CPPUNIT_ASSERT_EQUAL(static_cast<double>(values[100 + start + i][1 + j]), window[i * 3 + j]);
+            }
+        }
+    }
+    array_type sub(boost::extents[4][2]);
+    view.getData(sub, {4, 2}, {796, 1});
+    for (size_t i = 0; i < 4; i++) {
+        CPPUNIT_ASSERT_EQUAL(values[896 + i][2], sub[i][0]);
+        CPPUNIT_ASSERT_EQUAL(values[896 + i][3], sub[i][1]);
+    }
+
+    DataView::ReadAheadStats stats = view.readAheadStats();
+    CPPUNIT_ASSERT(stats.misses > 0);
+    CPPUNIT_ASSERT(stats.hits > 5 * stats.misses);
+    CPPUNIT_ASSERT(stats.bytes_read <= 2 * 800 * 3 * sizeof(double));
+
+    // writes through the view are visible to following reads
+    array_type one(boost::extents[1][1]);
+    one[0][0] = 0;
+    view.setData(one, {0, 0});
+    one[0][0] = 1;
+    view.getData(one, {1, 1}, {0, 0});
+    CPPUNIT_ASSERT_EQUAL(0, one[0][0]);
+
+    // reads larger than the buffer go to the array directly
+    array_type all;
+    view.getData(all);
+    CPPUNIT_ASSERT_EQUAL(values[101][1], all[1][0]);
+    CPPUNIT_ASSERT_EQUAL(values[899][3], all[799][2]);
+
+    view.readAhead(0);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), view.readAhead());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), view.readAheadStats().hits);
+}
+
+
+void BaseTestDataAccess::testStridedData() {
+    std::vector<int32_t> signal(3000);
+    for (size_t i = 0; i < signal.size(); i++) {
+        signal[i] = static_cast<int32_t>(i % 30 == 7 ? 1000 + i : i);
+    }
+    nix::DataArray da = block.createDataArray("strided", "nix.sampled", signal);
+
+    // every 30th sample
+    std::vector<int32_t> decimated;
+    da.getData(decimated, {100}, {0}, {30});
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(100), decimated.size());
+    for (size_t i = 0; i < decimated.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(signal[i * 30], decimated[i]);
+    }
+
+    // blocks of 2, 10 apart, with offset
+    std::vector<int32_t> blocks;
+    da.getData(blocks, {5}, {3}, {10}, {2});
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(10), blocks.size());
+    for (size_t i = 0; i < 5; i++) {
+        CPPUNIT_ASSERT_EQUAL(signal[3 + i * 10], blocks[2 * i]);
+        CPPUNIT_ASSERT_EQUAL(signal[3 + i * 10 + 1], blocks[2 * i + 1]);
+    }
+
+    // strided reads honour the polynomial
+    std::vector<double> scaled;
+    da.polynomCoefficients({0.0, 2.0});
+    da.getData(scaled, {10}, {0}, {30});
+    for (size_t i = 0; i < scaled.size(); i++) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0 * signal[i * 30], scaled[i], 1e-12);
+    }
+    da.polynomCoefficients(nix::none);
+
+    CPPUNIT_ASSERT_THROW(da.getData(decimated, {200}, {0}, {30}), std::exception);
+    CPPUNIT_ASSERT_THROW(da.getData(decimated, {10}, {0}, {30, 1}), std::exception);
+
+    // 2-d, through a DataView
+    typedef boost::multi_array<double, 4> array_type;
+    array_type ref;
+    data_array.getData(ref);
+
+    DataView view(data_array, {2, 6, 5, 8}, {0, 2, 0, 1});
+    array_type sub;
+    view.getData(sub, {2, 3, 1, 4}, {0, 0, 1, 0}, {1, 2, 1, 2});
+    for (size_t i = 0; i < 2; i++) {
+        for (size_t j = 0; j < 3; j++) {
+            for (size_t l = 0; l < 4; l++) {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(ref[i][2 + j * 2][1][1 + l * 2], sub[i][j][0][l],
+                                             std::numeric_limits<double>::epsilon());
+            }
+        }
+    }
+    CPPUNIT_ASSERT_THROW(view.getData(sub, {2, 4, 1, 4}, {0, 0, 1, 0}, {1, 2, 1, 2}), OutOfBounds);
+
+    // min/max decimation
+    std::vector<int32_t> mins, maxs;
+    da.getDataMinMax(mins, maxs, 100);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(100), mins.size());
+    for (size_t i = 0; i < mins.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(signal[i * 30], mins[i]);
+        CPPUNIT_ASSERT_EQUAL(signal[i * 30 + 7], maxs[i]);
+    }
+
+    // uneven bins cover everything exactly once
+    da.getDataMinMax(mins, maxs, 7, 100, 2000);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(7), maxs.size());
+    CPPUNIT_ASSERT_EQUAL(signal[100], mins.front());
+    CPPUNIT_ASSERT_EQUAL(*std::max_element(signal.begin() + 100, signal.begin() + 2100),
+                         *std::max_element(maxs.begin(), maxs.end()));
+
+    da.getDataMinMax(mins, maxs, 5000);
+    CPPUNIT_ASSERT_EQUAL(signal.size(), mins.size());
+    CPPUNIT_ASSERT(mins == signal && maxs == signal);
+
+    CPPUNIT_ASSERT_THROW(da.getDataMinMax(mins, maxs, 10, 2000, 2000), OutOfBounds);
+    CPPUNIT_ASSERT_THROW(data_array.getDataMinMax(mins, maxs, 10), InvalidRank);
+}
+
+
+void BaseTestDataAccess::testResolvedMultiTag() {
+    // 2-d positions and extents on 4-d data
+    util::ResolvedMultiTag resolved(multi_tag);
+    CPPUNIT_ASSERT_EQUAL(multi_tag.positions().dataExtent()[0], resolved.positionCount());
+    CPPUNIT_ASSERT_EQUAL(multi_tag.positions().dataExtent()[1], static_cast<ndsize_t>(resolved.columns()));
+    CPPUNIT_ASSERT(resolved.hasExtents());
+
+    std::vector<double> first_position;
+    NDSize first_count(2, 1);
+    first_count[1] = resolved.columns();
+    multi_tag.positions().getData(first_position, first_count, NDSize(2, 0));
+    for (size_t c = 0; c < resolved.columns(); c++) {
+        CPPUNIT_ASSERT_EQUAL(first_position[c], resolved.positions(c)[0]);
+    }
+
+    std::vector<ndsize_t> indices(1, 0);
+    std::vector<DataView> views = util::taggedData(resolved, indices, data_array, RangeMatch::Inclusive);
+    DataView reference = util::taggedData(multi_tag, 0, data_array, RangeMatch::Inclusive);
+    CPPUNIT_ASSERT_EQUAL(reference.dataExtent(), views[0].dataExtent());
+
+    indices[0] = 1;
+    CPPUNIT_ASSERT_THROW(util::taggedData(resolved, indices, data_array), nix::OutOfBounds);
+    indices[0] = 10;
+    CPPUNIT_ASSERT_THROW(util::taggedData(resolved, indices, data_array), nix::OutOfBounds);
+
+    // many positions on a sampled dimension, compared against one-by-one resolution
+    nix::DataArray sinus = mtag2.references()[0];
+    std::vector<double> starts(500), extents(500);
+    for (size_t i = 0; i < starts.size(); i++) {
+        starts[i] = 0.04 * i;
+        extents[i] = 0.25 + 0.01 * (i % 7);
+    }
+    nix::DataArray pos = block.createDataArray("many_starts", "test", starts);
+    nix::DataArray ext = block.createDataArray("many_extents", "test", extents);
+    nix::MultiTag many = block.createMultiTag("many_segments", "test", pos);
+    many.extents(ext);
+    many.addReference(sinus);
+
+    util::ResolvedMultiTag all(many);
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(500), all.positionCount());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), all.columns());
+
+    std::vector<ndsize_t> every;
+    std::vector<DataView> slices = util::taggedData(all, every, sinus);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(500), slices.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(500), every.size());
+
+    for (ndsize_t i = 0; i < 500; i += 37) {
+        NDSize offset, count;
+        util::getOffsetAndCount(many, sinus, i, offset, count, RangeMatch::Exclusive);
+        CPPUNIT_ASSERT_EQUAL(count, slices[i].dataExtent());
+        std::vector<double> expected, actual;
+        sinus.getData(expected, count, offset);
+        slices[i].getData(actual);
+        CPPUNIT_ASSERT(expected == actual);
+    }
+
+    // a window of positions
+    util::ResolvedMultiTag window(many, 100, 50);
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(100), window.first());
+    CPPUNIT_ASSERT(window.contains(149) && !window.contains(150) && !window.contains(99));
+    CPPUNIT_ASSERT_EQUAL(starts[120], window.positions(0)[20]);
+    CPPUNIT_ASSERT_EQUAL(extents[120], window.extents(0)[20]);
+
+    std::vector<ndsize_t> some = {120, 101};
+    std::vector<DataView> some_slices = util::taggedData(window, some, sinus);
+    CPPUNIT_ASSERT_EQUAL(slices[120].dataExtent(), some_slices[0].dataExtent());
+    CPPUNIT_ASSERT_EQUAL(slices[101].dataExtent(), some_slices[1].dataExtent());
+    some[0] = 150;
+    CPPUNIT_ASSERT_THROW(util::taggedData(window, some, sinus), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(util::ResolvedMultiTag(many, 480, 30), nix::OutOfBounds);
+
+    // feature data through the resolved tag
+    nix::Feature feature = many.createFeature(sinus, nix::LinkType::Tagged);
+    std::vector<DataView> feature_views = util::featureData(window, {101}, feature);
+    CPPUNIT_ASSERT_EQUAL(slices[101].dataExtent(), feature_views[0].dataExtent());
+    nix::Feature untagged = many.createFeature(pos, nix::LinkType::Untagged);
+    feature_views = util::featureData(window, {101, 102}, untagged);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), feature_views.size());
+    CPPUNIT_ASSERT_EQUAL(pos.dataExtent(), feature_views[1].dataExtent());
+    CPPUNIT_ASSERT_THROW(util::featureData(window, {10}, untagged), nix::OutOfBounds);
+}
+
+
 void BaseTestDataAccess::testDataSlice() {
     nix::Block b = file.createBlock("slicing data", "nix.test");
 
@@ -42,6 +42,9 @@ public:
     void testMultiTagFeatureData();
     void testMultiTagUnitSupport();
     void testDataView();
+    void testDataViewReadAhead();
+    void testStridedData();
+    void testResolvedMultiTag();
     void testDataSlice();
     void testFlexibleTagging();
 };
@@ -13,6 +13,9 @@
 #include <iterator>
 #include <stdexcept>
 #include <limits>
+#include <cmath>
+#include <numeric>
+#include <algorithm>
 
 #include <boost/math/constants/constants.hpp>
 #include <boost/math/tools/rational.hpp>
@@ -21,6 +24,7 @@
 #include <nix/util/util.hpp>
 #include <nix/valid/validate.hpp>
 #include <nix/hydra/multiArray.hpp>
+#include <nix/DataCursor.hpp>
 
 #include "BaseTestDataArray.hpp"
 
@@ -615,6 +619,309 @@ void BaseTestDataArray::testDataFrameDimension() {
 }
 
 
+void BaseTestDataArray::testMappedData() {
+    // chunked data cannot be mapped
+    CPPUNIT_ASSERT_THROW(array3.mappedData(), std::runtime_error);
+
+    std::vector<int32_t> values(6 * 1000);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int32_t>(i) - 3000;
+    }
+
+    // the file compresses by default, contiguous data is never compressed
+    nix::File f = nix::File::open("test_mapped.h5", nix::FileMode::Overwrite, "hdf5",
+                                  nix::Compression::DeflateNormal);
+    nix::Block b = f.createBlock("mapped", "test");
+    CPPUNIT_ASSERT_THROW(b.createDataArray("compressed", "raw", nix::DataType::Int32, nix::NDSize({6, 1000}),
+                                           nix::Compression::DeflateNormal, nix::DataStorage::Contiguous),
+                         std::invalid_argument);
+
+    nix::DataArray da = b.createDataArray("mapped", "raw", nix::DataType::Int32, nix::NDSize({6, 1000}),
+                                          nix::Compression::Auto, nix::DataStorage::Contiguous);
+    CPPUNIT_ASSERT(da.dataChunks().size() == 0);
+    da.setData(nix::DataType::Int32, values.data(), nix::NDSize({6, 1000}), nix::NDSize({0, 0}));
+    CPPUNIT_ASSERT_THROW(da.dataExtent(nix::NDSize({6, 2000})), std::exception);
+
+    nix::MappedData view = da.mappedData();
+    CPPUNIT_ASSERT(view.valid());
+    CPPUNIT_ASSERT(!view.empty());
+    CPPUNIT_ASSERT_EQUAL(nix::DataType::Int32, view.dataType());
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({6, 1000}), view.shape());
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({1000, 1}), view.strides());
+    CPPUNIT_ASSERT_EQUAL(values.size() * sizeof(int32_t), view.bytes());
+    CPPUNIT_ASSERT_THROW(view.data<double>(), std::invalid_argument);
+
+    const int32_t *mapped = view.data<int32_t>();
+    CPPUNIT_ASSERT(std::equal(values.begin(), values.end(), mapped));
+
+    // writes through HDF5 show up in new views
+    values[4242] = 42;
+    da.setData(nix::DataType::Int32, &values[4242], nix::NDSize({1, 1}), nix::NDSize({4, 242}));
+    CPPUNIT_ASSERT_EQUAL(42, da.mappedData().data<int32_t>()[4242]);
+
+    nix::DataArray empty = b.createDataArray("mapped_empty", "raw", nix::DataType::Double, nix::NDSize({0}),
+                                             nix::Compression::None, nix::DataStorage::Contiguous);
+    CPPUNIT_ASSERT(empty.mappedData().empty());
+
+    f.close();
+    CPPUNIT_ASSERT(!view.valid());
+    CPPUNIT_ASSERT_THROW(view.data(), std::runtime_error);
+}
+
+
+void BaseTestDataArray::testStatistics() {
+    const size_t n = 100000;
+    std::vector<double> values(n);
+    for (size_t i = 0; i < n; i++) {
+        values[i] = std::sin(static_cast<double>(i) / 1000.0) * static_cast<double>(i % 977);
+    }
+
+    auto expected = [&values](size_t offset, size_t count) {
+        nix::DataStatistics stats;
+        stats.min = *std::min_element(values.begin() + offset, values.begin() + offset + count);
+        stats.max = *std::max_element(values.begin() + offset, values.begin() + offset + count);
+        stats.sum = std::accumulate(values.begin() + offset, values.begin() + offset + count, 0.0);
+        stats.count = count;
+        return stats;
+    };
+
+    auto check = [](const nix::DataStatistics &expected, const nix::DataStatistics &actual) {
+        CPPUNIT_ASSERT_EQUAL(expected.count, actual.count);
+        CPPUNIT_ASSERT_EQUAL(expected.min, actual.min);
+        CPPUNIT_ASSERT_EQUAL(expected.max, actual.max);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.sum, actual.sum, 1e-6 * std::abs(expected.sum) + 1e-6);
+    };
+
+    nix::DataArray da = block.createDataArray("stats", "raw", nix::DataType::Double, nix::NDSize({n}));
+    da.setData(nix::DataType::Double, values.data(), nix::NDSize({n}), nix::NDSize({0}));
+
+    // without an index the values are read
+    CPPUNIT_ASSERT(!da.hasStatistics());
+    check(expected(123, 45678), da.statistics({123}, {45678}));
+
+    da.createStatistics();
+    CPPUNIT_ASSERT(da.hasStatistics());
+    check(expected(0, n), da.statistics());
+    check(expected(123, 45678), da.statistics({123}, {45678}));
+    check(expected(n - 1, 1), da.statistics({n - 1}, {1}));
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(0), da.statistics({10}, {0}).count);
+    CPPUNIT_ASSERT(std::isnan(da.statistics({10}, {0}).min));
+    CPPUNIT_ASSERT_THROW(da.statistics({n - 10}, {11}), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(da.statistics({0, 0}, {1, 1}), nix::IncompatibleDimensions);
+
+    // writes keep the index up to date
+    std::vector<double> patch(5000, -1000.0);
+    std::copy(patch.begin(), patch.end(), values.begin() + 31000);
+    da.setData(nix::DataType::Double, patch.data(), nix::NDSize({patch.size()}), nix::NDSize({31000}));
+    check(expected(0, n), da.statistics());
+
+    std::vector<int32_t> more(20000);
+    for (size_t i = 0; i < more.size(); i++) {
+        more[i] = static_cast<int32_t>(i) * 3 - 7000;
+        values.push_back(static_cast<double>(more[i]));
+    }
+    da.appendData(nix::DataType::Int32, more.data(), nix::NDSize({more.size()}), 0);
+    check(expected(0, values.size()), da.statistics());
+    check(expected(n - 500, 1000), da.statistics({n - 500}, {1000}));
+
+    da.dataExtent(nix::NDSize({n / 2}));
+    values.resize(n / 2);
+    check(expected(0, n / 2), da.statistics());
+
+    CPPUNIT_ASSERT(da.deleteStatistics());
+    CPPUNIT_ASSERT(!da.hasStatistics());
+    CPPUNIT_ASSERT(!da.deleteStatistics());
+    check(expected(0, n / 2), da.statistics());
+
+    // an index built through another handle of the array is kept up to date as well
+    nix::DataArray handle = block.getDataArray(da.id());
+    da.setData(nix::DataType::Double, patch.data(), nix::NDSize({10}), nix::NDSize({0}));
+    std::copy(patch.begin(), patch.begin() + 10, values.begin());
+    handle.createStatistics();
+    patch.assign(100, 5000.0);
+    std::copy(patch.begin(), patch.end(), values.begin() + 200);
+    da.setData(nix::DataType::Double, patch.data(), nix::NDSize({patch.size()}), nix::NDSize({200}));
+    check(expected(0, n / 2), handle.statistics());
+    CPPUNIT_ASSERT(handle.deleteStatistics());
+
+    nix::DataArray text = block.createDataArray("stats_text", "raw", nix::DataType::String, nix::NDSize({2}));
+    CPPUNIT_ASSERT_THROW(text.createStatistics(), std::runtime_error);
+}
+
+
+void BaseTestDataArray::testPyramid() {
+    const size_t n = 3000000 + 123;
+    std::vector<int16_t> values(n);
+    for (size_t i = 0; i < n; i++) {
+        values[i] = static_cast<int16_t>((i * 7919) % 20011) - 10000;
+    }
+
+    // every bin must hold the min and max of its samples
+    auto check = [&values, n](const nix::DataEnvelope &env, size_t offset, size_t count) {
+        CPPUNIT_ASSERT(env.offset <= offset);
+        CPPUNIT_ASSERT(env.offset + env.factor * env.min.size() >= offset + count);
+        CPPUNIT_ASSERT_EQUAL(env.min.size(), env.max.size());
+        for (size_t b = 0; b < env.min.size(); b++) {
+            const size_t start = env.offset + b * env.factor;
+            const size_t end = std::min<size_t>(start + env.factor, n);
+            auto mm = std::minmax_element(values.begin() + start, values.begin() + end);
+            CPPUNIT_ASSERT_EQUAL(static_cast<double>(*mm.first), env.min[b]);
+            CPPUNIT_ASSERT_EQUAL(static_cast<double>(*mm.second), env.max[b]);
+        }
+    };
+
+    nix::DataArray da = block.createDataArray("pyramid", "raw", values);
+    da.appendSampledDimension(1.0 / 30000);
+    CPPUNIT_ASSERT(!da.hasPyramid());
+    CPPUNIT_ASSERT(da.pyramidFactors().empty());
+
+    // without a pyramid the samples are read
+    nix::DataEnvelope env = da.envelopeByIndex(100, 1000, 500);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(1), env.factor);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(1000), env.offset);
+    CPPUNIT_ASSERT_EQUAL(size_t(500), env.min.size());
+    CPPUNIT_ASSERT(env.min == env.max);
+    check(env, 1000, 500);
+
+    nix::PyramidOptions opts;
+    opts.threads = 4;
+    da.createPyramid(opts);
+    CPPUNIT_ASSERT(da.hasPyramid());
+    CPPUNIT_ASSERT(da.pyramidFactors() == std::vector<nix::ndsize_t>({16, 256, 4096}));
+
+    env = da.envelopeByIndex(800, 0, n);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(256), env.factor);
+    check(env, 0, n);
+    env = da.envelopeByIndex(500, 12345, 600 * 4096 + 7);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(4096), env.factor);
+    check(env, 12345, 600 * 4096 + 7);
+    env = da.envelopeByIndex(800, 55555, 20000);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(16), env.factor);
+    check(env, 55555, 20000);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(1), da.envelopeByIndex(800, 55555, 2000).factor);
+    check(da.envelopeByIndex(10, n - 5000, 5000), n - 5000, 5000);
+    CPPUNIT_ASSERT_THROW(da.envelopeByIndex(1, n, 1), nix::OutOfBounds);
+
+    // positions of the sampled dimension, the range is cut at the end of the data
+    check(da.envelope(800, 10.0, 20.0), 300000, 300001);
+    check(da.envelope(800, 99.0, 300.0), 2970000, n - 2970000);
+    CPPUNIT_ASSERT(da.envelope(800, 200.0, 300.0).min.empty());
+
+    // changes of the data remove the pyramid
+    da.setData(nix::DataType::Int16, values.data(), {10}, {0});
+    CPPUNIT_ASSERT(!da.hasPyramid());
+
+    // also one built through another handle of the array
+    nix::DataArray handle = block.getDataArray(da.id());
+    handle.createPyramid(opts);
+    da.setData(nix::DataType::Int16, values.data(), {10}, {0});
+    CPPUNIT_ASSERT(!handle.hasPyramid());
+    CPPUNIT_ASSERT(handle.pyramidFactors().empty());
+
+    opts.factors = {16, 100};
+    CPPUNIT_ASSERT_THROW(da.createPyramid(opts), std::invalid_argument);
+    CPPUNIT_ASSERT(!da.hasPyramid());
+    opts.factors = {10, 100};
+    opts.threads = 1;
+    da.createPyramid(opts);
+    check(da.envelopeByIndex(5, 0, n), 0, n);
+    CPPUNIT_ASSERT(da.deletePyramid());
+    CPPUNIT_ASSERT(!da.deletePyramid());
+
+    // NaN is left out unless a bin holds nothing else
+    std::vector<double> samples(1000, 1.0);
+    std::fill(samples.begin(), samples.begin() + 32, std::numeric_limits<double>::quiet_NaN());
+    samples[40] = std::numeric_limits<double>::quiet_NaN();
+    samples[50] = -3.0;
+    nix::DataArray nan = block.createDataArray("pyramid_nan", "raw", samples);
+    nan.createPyramid();
+    env = nan.envelopeByIndex(60, 0, 1000);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(16), env.factor);
+    CPPUNIT_ASSERT(std::isnan(env.min[0]) && std::isnan(env.max[1]));
+    CPPUNIT_ASSERT_EQUAL(1.0, env.min[2]);
+    CPPUNIT_ASSERT_EQUAL(-3.0, env.min[3]);
+    CPPUNIT_ASSERT_EQUAL(1.0, env.max[3]);
+
+    nix::DataArray matrix = block.createDataArray("pyramid_2d", "raw", nix::DataType::Double, nix::NDSize({4, 4}));
+    CPPUNIT_ASSERT_THROW(matrix.createPyramid(), nix::InvalidRank);
+}
+
+
+void BaseTestDataArray::testDataCursor() {
+    typedef boost::multi_array<int32_t, 2> array_type;
+    array_type values(boost::extents[1000][7]);
+    for (size_t i = 0; i < 1000; i++) {
+        for (size_t j = 0; j < 7; j++) {
+            values[i][j] = static_cast<int32_t>(i * 7 + j);
+        }
+    }
+    nix::DataArray da = block.createDataArray("streamed", "test", values);
+
+    // along the first axis, with prefetching
+    nix::DataCursor<double> rows(da, 0, 64, true);
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(64), rows.blockSlices());
+    size_t nblocks = 0;
+    nix::ndsize_t next_row = 0;
+    const double *buffers[2] = {nullptr, nullptr};
+    while (rows.next()) {
+        const nix::NDSize shape = rows.shape();
+        CPPUNIT_ASSERT_EQUAL(next_row, rows.offset()[0]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(7), shape[1]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(shape[0] * 7), rows.size());
+        for (size_t i = 0; i < shape[0]; i++) {
+            for (size_t j = 0; j < 7; j++) {
+                CPPUNIT_ASSERT_EQUAL(static_cast<double>(values[next_row + i][j]), rows.data()[i * 7 + j]);
+            }
+        }
+        // the two buffers are reused alternately
+        if (nblocks < 2) {
+            buffers[nblocks] = rows.data();
+        } else {
+            CPPUNIT_ASSERT(rows.data() == buffers[nblocks % 2]);
+        }
+        next_row += shape[0];
+        nblocks++;
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(1000), next_row);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(16), nblocks);
+    CPPUNIT_ASSERT(!rows.next());
+
+    rows.rewind();
+    CPPUNIT_ASSERT(rows.next());
+    CPPUNIT_ASSERT_EQUAL(static_cast<double>(values[0][0]), rows.data()[0]);
+
+    // along the second axis
+    nix::DataCursor<int32_t> columns(da, 1, 3);
+    std::vector<nix::ndsize_t> widths;
+    while (columns.next()) {
+        const nix::NDSize shape = columns.shape();
+        const nix::ndsize_t first = columns.offset()[1];
+        widths.push_back(shape[1]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(1000), shape[0]);
+        CPPUNIT_ASSERT_EQUAL(values[999][first + shape[1] - 1], columns.data()[999 * shape[1] + shape[1] - 1]);
+    }
+    CPPUNIT_ASSERT(widths == std::vector<nix::ndsize_t>({3, 3, 1}));
+
+    // default block size covers everything here
+    nix::DataCursor<int32_t> all(da);
+    CPPUNIT_ASSERT(all.next());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(7000), all.size());
+    CPPUNIT_ASSERT(!all.next());
+
+    // over a view
+    nix::DataView view(da, nix::NDSize({10, 2}), nix::NDSize({500, 5}));
+    nix::DataCursor<int32_t> viewed(view, 0, 4, true);
+    nix::ndsize_t seen = 0;
+    while (viewed.next()) {
+        CPPUNIT_ASSERT_EQUAL(values[500 + seen][5], viewed.data()[0]);
+        seen += viewed.shape()[0];
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(10), seen);
+
+    CPPUNIT_ASSERT_THROW(nix::DataCursor<int32_t>(da, 2), nix::OutOfBounds);
+}
+
+
 void BaseTestDataArray::testOperator() {
     std::stringstream mystream;
     mystream << array1;
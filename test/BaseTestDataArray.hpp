@@ -37,6 +37,10 @@ public:
     void testDimension();
     void testAliasRangeDimension();
     void testDataFrameDimension();
+    void testMappedData();
+    void testStatistics();
+    void testPyramid();
+    void testDataCursor();
     void testOperator();
     void testValidate();
 };
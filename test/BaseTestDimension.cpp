@@ -11,6 +11,7 @@
 #include <iostream>
 #include <iterator>
 #include <stdexcept>
+#include <memory>
 
 #include <nix/util/util.hpp>
 #include <nix/valid/validate.hpp>
@@ -339,6 +340,41 @@ void BaseTestDimension::testSampledDimIndexOf() {
     CPPUNIT_ASSERT(ranges[2] && (*ranges[2]).first == 2 && (*ranges[2]).second == 40 && 
                    sd.positionAt((*ranges[2]).first) == 1.0 && sd.positionAt((*ranges[2]).second) == 39);
     CPPUNIT_ASSERT(!ranges[3]);
+
+    // batch version into caller provided arrays must match the scalar one
+    std::vector<double> starts, ends;
+    for (double p = -3.0; p < 5.0; p += 0.25) {
+        starts.push_back(p);
+        ends.push_back(p);
+        starts.push_back(p);
+        ends.push_back(p + 1.5);
+        starts.push_back(p + 1.0);
+        ends.push_back(p);
+    }
+    size_t count = starts.size();
+    std::vector<ndsize_t> start_indices(count), end_indices(count);
+    std::unique_ptr<bool[]> valid(new bool[count]);
+    for (RangeMatch match : {RangeMatch::Inclusive, RangeMatch::Exclusive}) {
+        for (double offset : {-1.0, 0.0, 0.5}) {
+            sd.offset(offset);
+            sd.samplingInterval(0.5);
+            size_t nvalid = sd.indexOf(starts.data(), ends.data(), count, start_indices.data(),
+                                       end_indices.data(), valid.get(), match);
+            size_t expected = 0;
+            for (size_t i = 0; i < count; ++i) {
+                range = sd.indexOf(starts[i], ends[i], match);
+                CPPUNIT_ASSERT_EQUAL(static_cast<bool>(range), valid[i]);
+                if (range) {
+                    expected++;
+                    CPPUNIT_ASSERT_EQUAL((*range).first, start_indices[i]);
+                    CPPUNIT_ASSERT_EQUAL((*range).second, end_indices[i]);
+                }
+            }
+            CPPUNIT_ASSERT_EQUAL(expected, nvalid);
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), sd.indexOf(nullptr, nullptr, 0, nullptr, nullptr, nullptr,
+                                                            RangeMatch::Inclusive));
     data_array.deleteDimensions();
 }
 
@@ -11,6 +11,8 @@
 #include <nix/util/util.hpp>
 #include <nix/valid/validate.hpp>
 #include <ctime>
+#include <atomic>
+#include <thread>
 #include <boost/filesystem.hpp>
 
 using namespace nix;
@@ -202,6 +204,63 @@ void BaseTestFile::testId() {
 }
 
 
+void BaseTestFile::testConcurrentRead() {
+    const size_t narrays = 8, nelms = 1000, nthreads = 8, rounds = 25;
+
+    Block b = file_open.createBlock("concurrent", "test");
+    Section s = file_open.createSection("settings", "test");
+    for (size_t i = 0; i < narrays; i++) {
+        std::vector<int32_t> values(nelms);
+        for (size_t j = 0; j < nelms; j++) {
+            values[j] = static_cast<int32_t>(i * nelms + j);
+        }
+        DataArray da = b.createDataArray("array " + std::to_string(i), "test", values);
+        da.polynomCoefficients({0.0, 0.5});
+        da.unit("mV");
+        da.appendSampledDimension(0.1 * (i + 1));
+        s.createProperty("gain " + std::to_string(i), Variant(static_cast<double>(i)));
+    }
+    file_open.flush();
+
+    // all threads share the File, the Block and one of the DataArrays
+    DataArray shared = b.getDataArray(0);
+    std::atomic<size_t> failures(0);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < nthreads; t++) {
+        workers.emplace_back([&, t] {
+            try {
+                std::vector<double> data;
+                for (size_t r = 0; r < rounds; r++) {
+                    const size_t i = (t + r) % narrays;
+                    DataArray da = r % 2 ? shared : b.getDataArray("array " + std::to_string(i));
+                    const size_t k = r % 2 ? 0 : i;
+
+                    da.getData(data);
+                    bool ok = data.size() == nelms && *da.unit() == "mV";
+                    for (size_t j = 0; ok && j < nelms; j++) {
+                        ok = data[j] == 0.5 * static_cast<double>(k * nelms + j);
+                    }
+                    SampledDimension dim = da.getDimension(1).asSampledDimension();
+                    ok = ok && std::abs(dim.samplingInterval() - 0.1 * (k + 1)) < 1e-12;
+                    Property p = file_open.getSection("settings").getProperty("gain " + std::to_string(k));
+                    ok = ok && p.values()[0].get<double>() == static_cast<double>(k);
+                    ok = ok && b.dataArrayCount() == narrays && !da.id().empty();
+                    if (!ok) {
+                        failures++;
+                    }
+                }
+            } catch (...) {
+                failures++;
+            }
+        });
+    }
+    for (auto &w : workers) {
+        w.join();
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), failures.load());
+}
+
+
 #define ASSERT_FLAGS_EQUAL(want, have)                     \
     CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long>(have), \
                          static_cast<unsigned long>(want));
@@ -220,3 +279,56 @@ void BaseTestFile::testFlags() {
     ASSERT_FLAGS_EQUAL(nix::OpenFlags::Force, flags & nix::OpenFlags::Force);
 }
 
+
+
+void BaseTestFile::testCopyBlock() {
+    Section section = file_open.createSection("recording", "test");
+    section.createSection("subject", "test").createProperty("species", Variant("mouse"));
+    Block b = file_open.createBlock("original", "test");
+    b.metadata(section);
+    DataArray da = b.createDataArray("signal", "test", std::vector<double>{ 1.0, 2.0, 3.0 });
+    DataArray pos = b.createDataArray("positions", "test", std::vector<double>{ 0.5, 1.5 });
+    Source src = b.createSource("source", "test");
+    da.addSource(src);
+    MultiTag mt = b.createMultiTag("events", "test", pos);
+    mt.addReference(da);
+    mt.createFeature(da, LinkType::Indexed);
+    Group g = b.createGroup("group", "test");
+    g.addDataArray(da);
+
+    Block copy = file_open.copyBlock(b, "copy");
+    CPPUNIT_ASSERT(copy.id() != b.id());
+    CPPUNIT_ASSERT_EQUAL(std::string("copy"), copy.name());
+    CPPUNIT_ASSERT_EQUAL(section.id(), copy.metadata().id());
+    CPPUNIT_ASSERT(copy.dataArrayCount() == 2 && copy.multiTagCount() == 1 && copy.groupCount() == 1);
+    DataArray da_copy = copy.getDataArray("signal");
+    CPPUNIT_ASSERT(da_copy.id() != da.id());
+    CPPUNIT_ASSERT_EQUAL(copy.getSource("source").id(), da_copy.getSource(0).id());
+    MultiTag mt_copy = copy.getMultiTag("events");
+    CPPUNIT_ASSERT_EQUAL(copy.getDataArray("positions").id(), mt_copy.positions().id());
+    CPPUNIT_ASSERT(mt_copy.hasReference(da_copy));
+    CPPUNIT_ASSERT_EQUAL(da_copy.id(), mt_copy.getFeature(0).data().id());
+    CPPUNIT_ASSERT(copy.getGroup("group").hasDataArray(da_copy));
+    CPPUNIT_ASSERT_THROW(file_open.copyBlock(b, "copy"), DuplicateName);
+    CPPUNIT_ASSERT_THROW(file_open.copyBlock(b), DuplicateName);
+
+    Block other = file_other.copyBlock(b);
+    CPPUNIT_ASSERT_EQUAL(b.name(), other.name());
+    CPPUNIT_ASSERT(file_other.sectionCount() == 1);
+    Section md = other.metadata();
+    CPPUNIT_ASSERT(md.id() != section.id());
+    CPPUNIT_ASSERT_EQUAL(section.name(), md.name());
+    Property species = md.getSection("subject").getProperty("species");
+    CPPUNIT_ASSERT(species.id() != section.getSection("subject").getProperty("species").id());
+    CPPUNIT_ASSERT(species.values()[0] == Variant("mouse"));
+
+    Block again = file_other.copyBlock(b, "again");
+    CPPUNIT_ASSERT(file_other.sectionCount() == 1);
+    CPPUNIT_ASSERT_EQUAL(md.id(), again.metadata().id());
+
+    Section s = file_other.copySection(section, "recording copy");
+    CPPUNIT_ASSERT(s.id() != section.id());
+    CPPUNIT_ASSERT(s.sectionCount() == 1 && s.getSection("subject").propertyCount() == 1);
+    CPPUNIT_ASSERT(file_other.sectionCount() == 2);
+    CPPUNIT_ASSERT_THROW(file_other.copySection(section), DuplicateName);
+}
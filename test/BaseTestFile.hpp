@@ -52,6 +52,8 @@ public:
     void testCompare();
     void testFlags();
     void testId();
+    void testConcurrentRead();
+    void testCopyBlock();
 
 };
 
@@ -134,6 +134,39 @@ void BaseTestGroup::testDataArrays() {
     file.deleteBlock(b);
 }
 
+void BaseTestGroup::testSetMembers() {
+    Group g = block.createGroup("member group", "group");
+    std::vector<DataArray> first(arrays.begin(), arrays.begin() + 3);
+    std::vector<DataArray> second(arrays.begin() + 1, arrays.end());
+
+    g.dataArrays(first);
+    CPPUNIT_ASSERT(g.dataArrayCount() == first.size());
+    g.dataArrays(second);
+    CPPUNIT_ASSERT(g.dataArrayCount() == second.size());
+    CPPUNIT_ASSERT(!g.hasDataArray(arrays[0]));
+    for (const auto &a : second) {
+        CPPUNIT_ASSERT(g.hasDataArray(a));
+    }
+
+    // an entity of another block must not change the members
+    Block b = file.createBlock("another block", "test");
+    Tag foreign = b.createTag("foreign", "tag", std::vector<double>{ 0.0 });
+    Tag t1 = block.createTag("member tag 1", "tag", std::vector<double>{ 0.0 });
+    Tag t2 = block.createTag("member tag 2", "tag", std::vector<double>{ 0.0 });
+    g.tags({t1});
+    CPPUNIT_ASSERT_THROW(g.tags({t2, foreign}), std::runtime_error);
+    CPPUNIT_ASSERT(g.tagCount() == 1 && g.hasTag(t1));
+    g.tags({t2, t2});
+    CPPUNIT_ASSERT(g.tagCount() == 1 && g.hasTag(t2));
+
+    g.dataArrays(std::vector<DataArray>());
+    CPPUNIT_ASSERT(g.dataArrayCount() == 0);
+    CPPUNIT_ASSERT(g.tagCount() == 1);
+
+    file.deleteBlock(b.id());
+}
+
+
 void BaseTestGroup::testDataFrames() {
     Group g = block.createGroup("test frame group", "group");
 
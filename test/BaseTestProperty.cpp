@@ -104,6 +104,58 @@ void BaseTestProperty::testValues()
     CPPUNIT_ASSERT(p2.values().empty() == true);
 }
 
+void BaseTestProperty::testTypedValues()
+{
+    nix::Section section = file.createSection("typed", "values");
+
+    std::vector<double> calibration = {0.5, 1.25, -3.0, 1e-9};
+    nix::Property p1 = section.createProperty("calibration", nix::DataType::Double);
+    p1.values(calibration.data(), calibration.size());
+    CPPUNIT_ASSERT_EQUAL(p1.valueCount(), static_cast<ndsize_t>(calibration.size()));
+
+    std::vector<double> dvals;
+    p1.values(dvals);
+    CPPUNIT_ASSERT(dvals == calibration);
+
+    // same layout as writing through Variants
+    std::vector<nix::Variant> vvals = p1.values();
+    CPPUNIT_ASSERT_EQUAL(vvals.size(), calibration.size());
+    for (size_t i = 0; i < vvals.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(vvals[i].get<double>(), calibration[i]);
+    }
+
+    std::vector<nix::Variant> electrodes = {nix::Variant(int32_t(3)),
+                                            nix::Variant(int32_t(7)),
+                                            nix::Variant(int32_t(-1))};
+    nix::Property p2 = section.createProperty("electrodes", electrodes);
+    std::vector<int32_t> ivals;
+    p2.values(ivals);
+    CPPUNIT_ASSERT_EQUAL(ivals.size(), electrodes.size());
+    CPPUNIT_ASSERT_EQUAL(ivals[1], int32_t(7));
+
+    // numbers are converted on read
+    std::vector<double> converted;
+    p2.values(converted);
+    CPPUNIT_ASSERT_EQUAL(converted[2], -1.0);
+
+    // but the type has to match on write
+    CPPUNIT_ASSERT_THROW(p2.values(calibration.data(), calibration.size()), std::invalid_argument);
+
+    std::vector<std::string> names = {"left", "right", "a much longer electrode name"};
+    nix::Property p3 = section.createProperty("names", nix::DataType::String);
+    p3.values(names.data(), names.size());
+    std::vector<std::string> svals;
+    p3.values(svals);
+    CPPUNIT_ASSERT(svals == names);
+    CPPUNIT_ASSERT_EQUAL(p3.values()[2].get<std::string>(), names[2]);
+    CPPUNIT_ASSERT_THROW(p3.values(dvals), std::invalid_argument);
+
+    p3.values(names.data(), 0);
+    CPPUNIT_ASSERT_EQUAL(p3.valueCount(), static_cast<ndsize_t>(0));
+    p3.values(svals);
+    CPPUNIT_ASSERT(svals.empty());
+}
+
 
 void BaseTestProperty::testDataType() {
     nix::Section section = file.createSection("Area51", "Boolean");
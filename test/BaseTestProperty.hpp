@@ -32,6 +32,7 @@ public:
     void testDefinition();
     void testDataType();
     void testValues();
+    void testTypedValues();
     void testUnit();
     void testUncertainty();
     void testIsValidEntity();
@@ -257,6 +257,67 @@ void BaseTestTag::testReferences() {
 }
 
 
+void BaseTestTag::testSetReferences() {
+    std::vector<DataArray> first(refs.begin(), refs.begin() + 3);
+    std::vector<DataArray> second(refs.begin() + 2, refs.end());
+
+    tag.references(first);
+    CPPUNIT_ASSERT(tag.referenceCount() == first.size());
+
+    // overlapping and duplicate entries
+    second.push_back(refs[4]);
+    tag.references(second);
+    CPPUNIT_ASSERT(tag.referenceCount() == 3);
+    for (size_t i = 0; i < refs.size(); ++i) {
+        CPPUNIT_ASSERT(tag.hasReference(refs[i]) == (i >= 2));
+    }
+
+    // an array of another block must not change the references
+    Block other = file.createBlock("other block", "test");
+    DataArray foreign = other.createDataArray("foreign", "reference", DataType::Double, NDSize({ 0 }));
+    std::vector<DataArray> invalid = {refs[0], foreign};
+    CPPUNIT_ASSERT_THROW(tag.references(invalid), std::runtime_error);
+    CPPUNIT_ASSERT(tag.referenceCount() == 3);
+    CPPUNIT_ASSERT(!tag.hasReference(refs[0]));
+
+    // the references are in the order of the last call
+    auto order = [this](const std::vector<DataArray> &expected) {
+        CPPUNIT_ASSERT(tag.referenceCount() == expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            CPPUNIT_ASSERT_EQUAL(expected[i].id(), tag.getReference(i).id());
+        }
+    };
+    tag.references({refs[0], refs[1], refs[2]});
+    tag.references({refs[2], refs[0]});
+    order({refs[2], refs[0]});
+    tag.references({refs[1], refs[2], refs[0], refs[3]});
+    order({refs[1], refs[2], refs[0], refs[3]});
+    tag.references({refs[2], refs[0], refs[3], refs[4]});
+    order({refs[2], refs[0], refs[3], refs[4]});
+    tag.references({refs[2], refs[3], refs[0]});
+    order({refs[2], refs[3], refs[0]});
+
+    tag.references(std::vector<DataArray>());
+    CPPUNIT_ASSERT(tag.referenceCount() == 0);
+
+    std::vector<Source> sources;
+    for (const auto &name : {"source_a", "source_b", "source_c"}) {
+        sources.push_back(block.createSource(name, "channel"));
+    }
+    Source foreign_source = other.createSource("source_f", "channel");
+
+    tag.sources({sources[0], sources[1]});
+    tag.sources({sources[1], sources[2], foreign_source});
+    CPPUNIT_ASSERT(tag.sourceCount() == 2);
+    CPPUNIT_ASSERT(!tag.hasSource(sources[0]));
+    CPPUNIT_ASSERT(tag.hasSource(sources[1]));
+    CPPUNIT_ASSERT(tag.hasSource(sources[2]));
+    CPPUNIT_ASSERT(!tag.hasSource(foreign_source));
+
+    file.deleteBlock(other.id());
+}
+
+
 void BaseTestTag::testFeatures() {
     DataArray a;
     Feature f;
@@ -41,6 +41,7 @@ public:
     void testSourceAccess();
     void testUnits();
     void testReferences();
+    void testSetReferences();
     void testFeatures();
     void testOperators();
     void testCreatedAt();
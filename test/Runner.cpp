@@ -14,9 +14,13 @@
 #include "TestVersion.hpp"
 #include "TestOptionalObligatory.hpp"
 #include "TestDataType.hpp"
+#include "TestCatalog.hpp"
 
 #include "TestValidate.hpp"
 
+#include <nix/Stats.hpp>
+#include <cstdlib>
+
 #include "hdf5/TestH5.hpp"
 #include "hdf5/TestEntityHDF5.hpp"
 #include "hdf5/TestEntityWithMetadataHDF5.hpp"
@@ -42,6 +46,7 @@
 
 #ifdef ENABLE_FS_BACKEND
 #include "fs/TestAttributesFS.hpp"
+#include "fs/TestDirectoryFS.hpp"
 #include "fs/TestFileFS.hpp"
 #include "fs/TestBlockFS.hpp"
 #include "fs/TestEntityFS.hpp"
@@ -89,11 +94,13 @@ int main(int argc, char* argv[]) {
     CPPUNIT_TEST_SUITE_REGISTRATION(TestOptionalObligatory);
     CPPUNIT_TEST_SUITE_REGISTRATION(TestValidate);
     CPPUNIT_TEST_SUITE_REGISTRATION(TestVersion);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestCatalog);
     CPPUNIT_TEST_SUITE_REGISTRATION(TestReadOnlyHDF5);
     CPPUNIT_TEST_SUITE_REGISTRATION(TestGroupHDF5);
 
 #ifdef ENABLE_FS_BACKEND
     CPPUNIT_TEST_SUITE_REGISTRATION(TestAttributesFS);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestDirectoryFS);
     CPPUNIT_TEST_SUITE_REGISTRATION(TestFileFS);
     CPPUNIT_TEST_SUITE_REGISTRATION(TestBlockFS);
     CPPUNIT_TEST_SUITE_REGISTRATION(TestEntityFS);
@@ -143,6 +150,11 @@ int main(int argc, char* argv[]) {
     CPPUNIT_NS::CompilerOutputter compileroutputter(&collectedresults, std::cerr);
     compileroutputter.write();
 
+    // NIX_STATS=1 dumps the HDF5 call counters, see cmake -DENABLE_STATS=ON
+    if (std::getenv("NIX_STATS") != nullptr) {
+        std::cerr << "\n" << nix::stats();
+    }
+
     std::cout << "\n";
 
     return !collectedresults.wasSuccessful();
@@ -0,0 +1,205 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "TestCatalog.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+void TestCatalog::writeFile(const std::string &name, const std::string &subject, size_t narrays) {
+    nix::File f = nix::File::open(name, nix::FileMode::Overwrite);
+    nix::Section session = f.createSection("session", "recording");
+    session.createProperty("subject", nix::Variant(subject));
+    nix::Section animal = session.createSection("animal", "subject");
+    animal.createProperty("age", nix::Variant(int64_t(42)));
+    animal.createProperty("weight", nix::Variant(0.1));
+
+    nix::Block b = f.createBlock("block", "session");
+    b.metadata(session);
+    for (size_t i = 0; i < narrays; i++) {
+        nix::DataArray da = b.createDataArray("array." + std::to_string(i), "trace",
+                                              nix::DataType::Float, nix::NDSize({ size_t(10), i + 1 }));
+        if (i % 2 == 0) {
+            da.metadata(session);
+        }
+    }
+    nix::Tag t = b.createTag("stimulus", "event", std::vector<double>{ 0.0 });
+    t.metadata(animal);
+    nix::Source s = b.createSource("electrode", "probe");
+    s.createSource("channel", "probe");
+    b.createGroup("trials", "grouping");
+    f.close();
+}
+
+
+void TestCatalog::setUp() {
+    files = {"test_catalog_a.h5", "test_catalog_b.h5", "test_catalog_c.h5"};
+    writeFile(files[0], "X", 3);
+    writeFile(files[1], "Y", 2);
+    writeFile(files[2], "X", 1);
+}
+
+
+void TestCatalog::tearDown() {
+}
+
+
+void TestCatalog::testBuild() {
+    std::vector<std::string> names = files;
+    names.insert(names.begin() + 1, "test_catalog_missing.h5");
+
+    nix::Catalog catalog = nix::Catalog::build(names, 2);
+    CPPUNIT_ASSERT(catalog.files() == names);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), catalog.errors().size());
+    CPPUNIT_ASSERT(catalog.errors().count("test_catalog_missing.h5") == 1);
+
+    // block, tag, 2 sources, group and the arrays of each file
+    CPPUNIT_ASSERT_EQUAL(size_t(3 * 5 + 3 + 2 + 1), catalog.size());
+
+    std::vector<nix::CatalogEntry> arrays = catalog.find([](const nix::CatalogEntry &e) {
+        return e.kind == nix::ObjectType::DataArray && e.file == "test_catalog_a.h5";
+    });
+    CPPUNIT_ASSERT_EQUAL(size_t(3), arrays.size());
+
+    nix::File f = nix::File::open("test_catalog_a.h5", nix::FileMode::ReadOnly);
+    nix::Block b = f.getBlock("block");
+    for (const nix::CatalogEntry &e : arrays) {
+        nix::DataArray da = b.getDataArray(e.id);
+        CPPUNIT_ASSERT_EQUAL(da.name(), e.name);
+        CPPUNIT_ASSERT_EQUAL(std::string("trace"), e.type);
+        CPPUNIT_ASSERT_EQUAL(b.id(), e.block);
+        CPPUNIT_ASSERT_EQUAL(nix::DataType::Float, e.dtype);
+        CPPUNIT_ASSERT_EQUAL(da.dataExtent(), e.extent);
+        CPPUNIT_ASSERT_EQUAL(da.metadata() ? da.metadata().id() : std::string(), e.metadata);
+    }
+    f.close();
+}
+
+
+void TestCatalog::testFind() {
+    nix::Catalog catalog = nix::Catalog::build(files);
+
+    std::vector<nix::CatalogEntry> hits = catalog.find("subject", "X", nix::ObjectType::DataArray);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), hits.size());
+    for (const nix::CatalogEntry &e : hits) {
+        CPPUNIT_ASSERT(e.file != "test_catalog_b.h5");
+        CPPUNIT_ASSERT(e.name == "array.0" || e.name == "array.2");
+    }
+
+    // properties of subsections count for the linked section
+    CPPUNIT_ASSERT_EQUAL(size_t(3 + 2), catalog.find("subject", "X").size());
+    CPPUNIT_ASSERT_EQUAL(size_t(3), catalog.find("age", nix::Variant(int64_t(42)), nix::ObjectType::Tag).size());
+    CPPUNIT_ASSERT_EQUAL(size_t(4 + 3 + 3), catalog.find("weight", nix::Variant(0.1)).size());
+    CPPUNIT_ASSERT(catalog.find("subject", "Z").empty());
+    CPPUNIT_ASSERT(catalog.find("age", "42", nix::ObjectType::Source).empty());
+
+    std::multimap<std::string, std::vector<std::string>> props = catalog.metadata(hits[0]);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), props.size());
+    CPPUNIT_ASSERT(props.find("subject")->second == std::vector<std::string>{"X"});
+    CPPUNIT_ASSERT(props.find("age")->second == std::vector<std::string>{"42"});
+
+    std::vector<nix::CatalogEntry> blocks = catalog.find("subject", "Y", nix::ObjectType::Block);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), blocks.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("test_catalog_b.h5"), blocks[0].file);
+}
+
+
+void TestCatalog::testSaveLoad() {
+    nix::Catalog catalog = nix::Catalog::build({files[0], "test_catalog_missing.h5", files[1]});
+    catalog.save("test_catalog.nixcat");
+
+    // saved again over the old index, nothing is left behind
+    catalog.save("test_catalog.nixcat");
+    size_t tmp_files = 0;
+    for (boost::filesystem::directory_iterator it("."), end; it != end; ++it) {
+        tmp_files += it->path().filename().string().find("test_catalog.nixcat.") == 0 ? 1 : 0;
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(0), tmp_files);
+    CPPUNIT_ASSERT_THROW(catalog.save("test_catalog_missing/catalog.nixcat"), std::runtime_error);
+
+    nix::Catalog loaded = nix::Catalog::load("test_catalog.nixcat");
+    CPPUNIT_ASSERT(loaded.files() == catalog.files());
+    CPPUNIT_ASSERT(loaded.errors() == catalog.errors());
+    CPPUNIT_ASSERT_EQUAL(catalog.size(), loaded.size());
+
+    std::vector<nix::CatalogEntry> a = catalog.entries();
+    std::vector<nix::CatalogEntry> b = loaded.entries();
+    for (size_t i = 0; i < a.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(a[i].file, b[i].file);
+        CPPUNIT_ASSERT_EQUAL(a[i].block, b[i].block);
+        CPPUNIT_ASSERT(a[i].kind == b[i].kind);
+        CPPUNIT_ASSERT_EQUAL(a[i].id, b[i].id);
+        CPPUNIT_ASSERT_EQUAL(a[i].name, b[i].name);
+        CPPUNIT_ASSERT_EQUAL(a[i].type, b[i].type);
+        CPPUNIT_ASSERT_EQUAL(a[i].dtype, b[i].dtype);
+        CPPUNIT_ASSERT_EQUAL(a[i].extent, b[i].extent);
+        CPPUNIT_ASSERT_EQUAL(a[i].metadata, b[i].metadata);
+        CPPUNIT_ASSERT(catalog.metadata(a[i]) == loaded.metadata(b[i]));
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(2), loaded.find("subject", "X", nix::ObjectType::DataArray).size());
+
+    CPPUNIT_ASSERT_THROW(nix::Catalog::load("test_catalog_missing.nixcat"), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(nix::Catalog::load(files[0]), std::runtime_error);
+
+    // cut the index file short
+    std::string data;
+    {
+        std::ifstream in("test_catalog.nixcat", std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    std::ofstream("test_catalog_short.nixcat", std::ios::binary) << data.substr(0, data.size() / 2);
+    CPPUNIT_ASSERT_THROW(nix::Catalog::load("test_catalog_short.nixcat"), std::runtime_error);
+}
+
+
+void TestCatalog::testUpdate() {
+    nix::Catalog catalog = nix::Catalog::build(files);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), catalog.update(files));
+    CPPUNIT_ASSERT_EQUAL(size_t(3 * 5 + 6), catalog.size());
+
+    writeFile(files[1], "X", 4);
+    std::vector<std::string> names = {files[0], files[1], "test_catalog_missing.h5"};
+    CPPUNIT_ASSERT_EQUAL(size_t(2), catalog.update(names));
+
+    CPPUNIT_ASSERT_EQUAL(size_t(3), catalog.files().size());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), catalog.errors().size());
+    CPPUNIT_ASSERT_EQUAL(size_t(2 * 5 + 3 + 4), catalog.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(2 + 2), catalog.find("subject", "X", nix::ObjectType::DataArray).size());
+    CPPUNIT_ASSERT(catalog.find("subject", "Y").empty());
+    CPPUNIT_ASSERT(catalog.find([](const nix::CatalogEntry &e) { return e.file == "test_catalog_c.h5"; }).empty());
+
+    // every section still belongs to the entities of its own file
+    for (const nix::CatalogEntry &e : catalog.find("age", "42")) {
+        CPPUNIT_ASSERT_EQUAL(size_t(1), catalog.metadata(e).count("weight"));
+    }
+
+    // files that failed are scanned again
+    CPPUNIT_ASSERT_EQUAL(size_t(1), catalog.update(names));
+
+    // dropping files in the middle keeps the sections of the others in place
+    catalog = nix::Catalog::build(files);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), catalog.update({files[2]}));
+    CPPUNIT_ASSERT(catalog.files() == std::vector<std::string>{files[2]});
+    CPPUNIT_ASSERT_EQUAL(size_t(5 + 1), catalog.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), catalog.find("subject", "X", nix::ObjectType::DataArray).size());
+    for (const nix::CatalogEntry &e : catalog.find("age", "42")) {
+        CPPUNIT_ASSERT_EQUAL(files[2], e.file);
+        CPPUNIT_ASSERT_EQUAL(size_t(1), catalog.metadata(e).count("weight"));
+    }
+}
+
+
+void TestCatalog::testValueString() {
+    CPPUNIT_ASSERT_EQUAL(std::string("true"), nix::Catalog::valueString(nix::Variant(true)));
+    CPPUNIT_ASSERT_EQUAL(std::string("text"), nix::Catalog::valueString(nix::Variant("text")));
+    CPPUNIT_ASSERT_EQUAL(std::string("-7"), nix::Catalog::valueString(nix::Variant(int32_t(-7))));
+    CPPUNIT_ASSERT_EQUAL(std::string("0.1"), nix::Catalog::valueString(nix::Variant(0.1)));
+    CPPUNIT_ASSERT_EQUAL(std::string("2.5"), nix::Catalog::valueString(nix::Variant(2.5)));
+    CPPUNIT_ASSERT_EQUAL(std::string("0.30000000000000004"), nix::Catalog::valueString(nix::Variant(0.1 + 0.2)));
+}
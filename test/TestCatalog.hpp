@@ -0,0 +1,55 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <iterator>
+#include <stdexcept>
+#include <limits>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+#include <cppunit/BriefTestProgressListener.h>
+
+
+class TestCatalog : public CPPUNIT_NS::TestFixture {
+
+public:
+
+    void setUp();
+    void tearDown();
+
+    void testBuild();
+    void testFind();
+    void testSaveLoad();
+    void testUpdate();
+    void testValueString();
+
+private:
+
+    std::vector<std::string> files;
+
+    static void writeFile(const std::string &name, const std::string &subject, size_t narrays);
+
+    CPPUNIT_TEST_SUITE(TestCatalog);
+    CPPUNIT_TEST(testBuild);
+    CPPUNIT_TEST(testFind);
+    CPPUNIT_TEST(testSaveLoad);
+    CPPUNIT_TEST(testUpdate);
+    CPPUNIT_TEST(testValueString);
+    CPPUNIT_TEST_SUITE_END ();
+
+};
@@ -10,6 +10,14 @@
 
 #include <ctime>
 #include <cmath>
+#include <thread>
+#include <vector>
+#include <unordered_set>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 
 using namespace std;
@@ -52,6 +60,29 @@ void TestUtil::testUnitScaling() {
     CPPUNIT_ASSERT(util::getSIScaling("V","mV") == 1e+03);
     CPPUNIT_ASSERT(util::getSIScaling("V^2","mV^2") == 1e+06);
     CPPUNIT_ASSERT(util::getSIScaling("mV^2","kV^2") == 1e-12);
+
+    // results are memoized, repeated lookups must behave the same
+    for (int i = 0; i < 3; i++) {
+        CPPUNIT_ASSERT(util::getSIScaling("mV","kV") == 1e-6);
+        CPPUNIT_ASSERT_THROW(util::getSIScaling("mOhm","ms"), nix::InvalidUnit);
+        CPPUNIT_ASSERT(util::isSIUnit("mV/cm") && !util::isAtomicSIUnit("mV/cm"));
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<double> results(8, 0.0);
+    for (size_t t = 0; t < results.size(); t++) {
+        threads.emplace_back([t, &results] {
+            for (int i = 0; i < 200; i++) {
+                results[t] += util::getSIScaling(t % 2 ? "ms" : "us", "s");
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (size_t t = 0; t < results.size(); t++) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(t % 2 ? 0.2 : 2e-4, results[t], 1e-9);
+    }
 }
 
 void TestUtil::testIsSIUnit() {
@@ -199,3 +230,66 @@ void TestUtil::testStringVectors() {
     CPPUNIT_ASSERT(util::isSetAtSamePos(vec_a, vec_c));
     CPPUNIT_ASSERT(!util::isSetAtSamePos(vec_a, vec_d));
 }
+
+
+void TestUtil::testCreateId() {
+    const string id = util::createId();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(36), id.size());
+    for (size_t i = 0; i < id.size(); i++) {
+        if (i == 8 || i == 13 || i == 18 || i == 23) {
+            CPPUNIT_ASSERT_EQUAL('-', id[i]);
+        } else {
+            CPPUNIT_ASSERT(isxdigit(id[i]) && !isupper(id[i]));
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL('4', id[14]);
+    CPPUNIT_ASSERT(string("89ab").find(id[19]) != string::npos);
+
+    string reused(id);
+    const char *storage = reused.data();
+    util::createId(reused);
+    CPPUNIT_ASSERT(reused != id);
+    CPPUNIT_ASSERT(storage == reused.data());
+
+    // no collisions between threads
+    const size_t nthreads = 4, per_thread = 25000;
+    vector<vector<string>> ids(nthreads);
+    vector<thread> workers;
+    for (size_t t = 0; t < nthreads; t++) {
+        workers.emplace_back([&ids, t, per_thread] {
+            for (size_t i = 0; i < per_thread; i++) {
+                ids[t].push_back(util::createId());
+            }
+        });
+    }
+    for (auto &w : workers) {
+        w.join();
+    }
+    unordered_set<string> unique;
+    for (const auto &v : ids) {
+        unique.insert(v.begin(), v.end());
+    }
+    CPPUNIT_ASSERT_EQUAL(nthreads * per_thread, unique.size());
+
+#ifndef _WIN32
+    // a forked child does not repeat the ids of its parent
+    int fds[2];
+    CPPUNIT_ASSERT_EQUAL(0, pipe(fds));
+    pid_t pid = fork();
+    if (pid == 0) {
+        string child_id = util::createId();
+        ssize_t n = write(fds[1], child_id.data(), child_id.size());
+        _exit(n == 36 ? 0 : 1);
+    }
+    CPPUNIT_ASSERT(pid > 0);
+    const string parent_id = util::createId();
+    char buffer[36];
+    ssize_t n = read(fds[0], buffer, sizeof(buffer));
+    int status = 0;
+    waitpid(pid, &status, 0);
+    close(fds[0]);
+    close(fds[1]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<ssize_t>(36), n);
+    CPPUNIT_ASSERT(parent_id != string(buffer, 36));
+#endif
+}
@@ -41,6 +41,7 @@ private:
     CPPUNIT_TEST(testDimTypeToStr);
     CPPUNIT_TEST(testChecks);
     CPPUNIT_TEST(testStringVectors);
+    CPPUNIT_TEST(testCreateId);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -59,5 +60,6 @@ public:
     void testDimTypeToStr();
     void testChecks();
     void testStringVectors();
+    void testCreateId();
 };
 
@@ -218,3 +218,76 @@ void TestVariant::testEquals() {
 }
 
 
+
+void TestVariant::testStrings() {
+    const std::string short_str = "short";
+    const std::string long_str = "a string that is too long to be stored inline";
+
+    // inline -> heap -> inline, always on the same Variant
+    nix::Variant v(short_str);
+    CPPUNIT_ASSERT_EQUAL(v.get<std::string>(), short_str);
+    v.set(long_str);
+    CPPUNIT_ASSERT_EQUAL(v.get<std::string>(), long_str);
+    v.set(short_str);
+    CPPUNIT_ASSERT_EQUAL(v.get<std::string>(), short_str);
+    v.set(long_str);
+    v.set(long_str + long_str);
+    CPPUNIT_ASSERT_EQUAL(v.get<std::string>(), long_str + long_str);
+
+    // setting from our own data
+    v.set(v.get<const char *>(), 3);
+    CPPUNIT_ASSERT_EQUAL(v.get<std::string>(), long_str.substr(0, 3));
+    v.set(v.get<const char *>() + 1);
+    CPPUNIT_ASSERT_EQUAL(v.get<std::string>(), long_str.substr(1, 2));
+
+    // copies are independent of each other
+    for (const std::string &str : {std::string(""), short_str, long_str}) {
+        nix::Variant a(str);
+        nix::Variant b(a);
+        nix::Variant c(42);
+        c = a;
+        a.set(3.14);
+        CPPUNIT_ASSERT_EQUAL(b.get<std::string>(), str);
+        CPPUNIT_ASSERT_EQUAL(c.get<std::string>(), str);
+        CPPUNIT_ASSERT(b == c);
+    }
+
+    nix::Variant d(long_str);
+    const nix::Variant &self = d;
+    d = self;
+    CPPUNIT_ASSERT_EQUAL(d.get<std::string>(), long_str);
+    d = nix::Variant(int64_t(-1));
+    CPPUNIT_ASSERT_EQUAL(d.get<int64_t>(), int64_t(-1));
+}
+
+void TestVariant::testMove() {
+    const std::string long_str = "a string that is too long to be stored inline";
+
+    nix::Variant a(long_str);
+    const char *buffer = a.get<const char *>();
+
+    // moving steals the heap buffer
+    nix::Variant b(std::move(a));
+    CPPUNIT_ASSERT_EQUAL(a.type(), nix::DataType::Nothing);
+    CPPUNIT_ASSERT(b.get<const char *>() == buffer);
+
+    nix::Variant c("short");
+    c = std::move(b);
+    CPPUNIT_ASSERT_EQUAL(b.type(), nix::DataType::Nothing);
+    CPPUNIT_ASSERT(c.get<const char *>() == buffer);
+    CPPUNIT_ASSERT_EQUAL(c.get<std::string>(), long_str);
+
+    nix::Variant d("short");
+    nix::Variant e(std::move(d));
+    CPPUNIT_ASSERT_EQUAL(e.get<std::string>(), std::string("short"));
+
+    std::vector<nix::Variant> values;
+    for (int i = 0; i < 100; i++) {
+        values.emplace_back(i % 2 ? long_str : std::to_string(i));
+    }
+    std::vector<nix::Variant> moved = std::move(values);
+    moved.insert(moved.begin(), nix::Variant(2.5));
+    CPPUNIT_ASSERT_EQUAL(moved[0].get<double>(), 2.5);
+    CPPUNIT_ASSERT_EQUAL(moved[1].get<std::string>(), std::string("0"));
+    CPPUNIT_ASSERT_EQUAL(moved[2].get<std::string>(), long_str);
+}
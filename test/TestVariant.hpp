@@ -39,6 +39,8 @@ public:
     void testObject();
     void testSwap();
     void testEquals();
+    void testStrings();
+    void testMove();
 
 private:
 
@@ -46,6 +48,8 @@ private:
     CPPUNIT_TEST(testObject);
     CPPUNIT_TEST(testSwap);
     CPPUNIT_TEST(testEquals);
+    CPPUNIT_TEST(testStrings);
+    CPPUNIT_TEST(testMove);
     CPPUNIT_TEST_SUITE_END ();
 
 };
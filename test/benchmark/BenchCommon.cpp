@@ -0,0 +1,111 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "BenchCommon.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <stdexcept>
+
+namespace bench {
+
+const char *backend_impl(int64_t backend) {
+    return backend == FS ? "file" : "hdf5";
+}
+
+
+static bool probe_backend(int64_t backend) {
+    ScratchPath scratch(std::string("probe-") + backend_impl(backend));
+    try {
+        nix::File f = nix::File::open(scratch.path(), nix::FileMode::Overwrite, backend_impl(backend));
+        f.close();
+        return true;
+    } catch (const std::runtime_error &) {
+        return false;
+    }
+}
+
+
+bool backend_available(int64_t backend) {
+    static const bool available[] = {probe_backend(HDF5), probe_backend(FS)};
+    return backend >= 0 && backend <= FS && available[backend];
+}
+
+
+bool require_backend(benchmark::State &state, int64_t backend) {
+    if (!backend_available(backend)) {
+        state.SkipWithError((std::string("back-end not built: ") + backend_impl(backend)).c_str());
+        return false;
+    }
+    return true;
+}
+
+
+void defaults(benchmark::internal::Benchmark *b) {
+    b->Unit(benchmark::kMicrosecond);
+    b->MinWarmUpTime(0.1);
+}
+
+
+void all_backends(benchmark::internal::Benchmark *b) {
+    b->ArgName("backend");
+    b->Arg(HDF5);
+    b->Arg(FS);
+}
+
+
+ScratchFile::ScratchFile(const std::string &name, int64_t backend, nix::OpenFlags flags)
+    : my_path("nix-bench-" + name + (backend == FS ? ".nix" : ".h5")) {
+    file = nix::File::open(my_path, nix::FileMode::Overwrite, backend_impl(backend),
+                           nix::Compression::Auto, flags);
+    block = file.createBlock("bench", "nix.bench");
+}
+
+
+ScratchFile::~ScratchFile() {
+    if (file.isOpen()) {
+        file.close();
+    }
+    boost::system::error_code ec;
+    boost::filesystem::remove_all(my_path, ec);
+}
+
+
+ScratchPath::ScratchPath(const std::string &name)
+    : my_path("nix-bench-" + name) {
+}
+
+
+ScratchPath::~ScratchPath() {
+    boost::system::error_code ec;
+    boost::filesystem::remove_all(my_path, ec);
+}
+
+
+static uint64_t h5_calls() {
+    const nix::Stats stats = nix::stats();
+    uint64_t calls = 0;
+    for (const nix::OpStats &op : stats.ops) {
+        calls += op.calls;
+    }
+    return calls;
+}
+
+
+CallCounter::CallCounter() : start(h5_calls()) {
+}
+
+
+void CallCounter::report(benchmark::State &state) const {
+    if (nix::stats().enabled) {
+        state.counters["h5_calls"] = benchmark::Counter(static_cast<double>(h5_calls() - start),
+                                                        benchmark::Counter::kAvgIterations);
+    }
+}
+
+} // namespace bench
@@ -0,0 +1,134 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_BENCH_COMMON_H
+#define NIX_BENCH_COMMON_H
+
+#include <nix.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/**
+ * The back-ends a case can run on. Cases that take a back-end have it as
+ * their first argument, named "backend".
+ */
+enum Backend : int64_t {
+    HDF5 = 0,
+    FS   = 1
+};
+
+/**
+ * The implementation name of a back-end, as passed to nix::File::open.
+ */
+const char *backend_impl(int64_t backend);
+
+/**
+ * Whether the library was built with the back-end, checked once.
+ */
+bool backend_available(int64_t backend);
+
+/**
+ * Skip the case if its back-end is not built in.
+ *
+ * @return False if the case was skipped.
+ */
+bool require_backend(benchmark::State &state, int64_t backend);
+
+/**
+ * The defaults of all cases: times in microseconds and a warmup run
+ * before measuring.
+ */
+void defaults(benchmark::internal::Benchmark *b);
+
+/**
+ * Cases that run on all back-ends.
+ */
+void all_backends(benchmark::internal::Benchmark *b);
+
+
+/**
+ * A file of its own for one run of a case. It is removed again when the
+ * run ends.
+ */
+class ScratchFile {
+public:
+    ScratchFile(const std::string &name, int64_t backend = HDF5,
+                nix::OpenFlags flags = nix::OpenFlags::None);
+
+    ScratchFile(const ScratchFile &other) = delete;
+    ScratchFile &operator=(const ScratchFile &other) = delete;
+
+    ~ScratchFile();
+
+    const std::string &path() const { return my_path; }
+
+    nix::File  file;
+    nix::Block block;
+
+private:
+    std::string my_path;
+};
+
+
+/**
+ * The path of a scratch file that is not opened, removed when it goes
+ * out of scope.
+ */
+class ScratchPath {
+public:
+    explicit ScratchPath(const std::string &name);
+
+    ScratchPath(const ScratchPath &other) = delete;
+    ScratchPath &operator=(const ScratchPath &other) = delete;
+
+    ~ScratchPath();
+
+    const std::string &path() const { return my_path; }
+
+private:
+    std::string my_path;
+};
+
+
+/**
+ * A saw tooth of n values in [0, period).
+ */
+template<typename T>
+std::vector<T> sawtooth(size_t n, size_t period = 1000) {
+    std::vector<T> values(n);
+    for (size_t i = 0; i < n; i++) {
+        values[i] = static_cast<T>(i % period);
+    }
+    return values;
+}
+
+
+/**
+ * Counts the HDF5 calls of the measured part of a case, if the library
+ * was built with ENABLE_STATS; they are reported per iteration as the
+ * counter "h5_calls".
+ */
+class CallCounter {
+public:
+    CallCounter();
+
+    void report(benchmark::State &state) const;
+
+private:
+    uint64_t start;
+};
+
+} // namespace bench
+
+#endif // NIX_BENCH_COMMON_H
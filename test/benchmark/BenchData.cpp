@@ -0,0 +1,351 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "BenchCommon.hpp"
+
+#include <nix/DataCursor.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <thread>
+
+using namespace bench;
+
+namespace {
+
+// 64 channels of int16 samples, as recorded by an acquisition board
+const nix::ndsize_t CHANNELS = 64;
+const nix::ndsize_t SAMPLES = 1 << 18;
+
+
+// blocks of {rows, columns} doubles, appended along the dimension that is 1
+void dataarray_write_block(benchmark::State &state) {
+    const nix::NDSize shape = {static_cast<nix::ndsize_t>(state.range(0)),
+                               static_cast<nix::ndsize_t>(state.range(1))};
+    const size_t axis = shape[0] == 1 ? 0 : 1;
+
+    ScratchFile scratch("write-block");
+    nix::NDSize extent = shape;
+    extent[axis] = 0;
+    nix::DataArray da = scratch.block.createDataArray("block", "nix.bench", nix::DataType::Double, extent);
+    const std::vector<double> values = sawtooth<double>(shape.nelms());
+
+    CallCounter calls;
+    for (auto _ : state) {
+        da.appendData(nix::DataType::Double, values.data(), shape, axis);
+    }
+    calls.report(state);
+    state.SetBytesProcessed(state.iterations() * values.size() * sizeof(double));
+}
+
+BENCHMARK(dataarray_write_block)->Name("dataarray.write.block")->Apply(defaults)
+    ->ArgNames({"rows", "cols"})->Args({2048, 1})->Args({1, 2048})->Args({64, 4096});
+
+
+// a window of {rows, columns} moved through the channels x samples array
+void dataarray_read_hyperslab(benchmark::State &state, bool poly) {
+    const nix::NDSize count = {static_cast<nix::ndsize_t>(state.range(0)),
+                               static_cast<nix::ndsize_t>(state.range(1))};
+
+    ScratchFile scratch(std::string("hyperslab") + (poly ? "-poly" : ""));
+    std::vector<int16_t> values = sawtooth<int16_t>(CHANNELS * SAMPLES);
+    nix::DataArray da = scratch.block.createDataArray("raw", "nix.bench", nix::DataType::Int16,
+                                                      nix::NDSize({CHANNELS, SAMPLES}));
+    da.setData(nix::DataType::Int16, values.data(), nix::NDSize({CHANNELS, SAMPLES}), nix::NDSize({0, 0}));
+    if (poly) {
+        da.polynomCoefficients({0.0, 0.195});
+    }
+
+    std::vector<double> buffer(count.nelms());
+    nix::NDSize offset = {0, 0};
+    CallCounter calls;
+    for (auto _ : state) {
+        da.getData(nix::DataType::Double, buffer.data(), count, offset);
+        offset[1] = (offset[1] + count[1]) % (SAMPLES - count[1] + 1);
+        offset[0] = (offset[0] + count[0]) % (CHANNELS - count[0] + 1);
+    }
+    calls.report(state);
+    state.SetItemsProcessed(state.iterations() * count.nelms());
+}
+
+
+void hyperslab_args(benchmark::internal::Benchmark *b) {
+    defaults(b);
+    b->ArgNames({"rows", "cols"});
+    b->Args({1, 1});                                      // a single sample
+    b->Args({1, 32768});                                  // one channel
+    b->Args({64, 1});                                     // all channels at one time
+    b->Args({64, 4096});                                  // all channels, a window
+    b->Args({8, 16384});                                  // a few channels
+    b->Args({CHANNELS, SAMPLES});                         // all of it
+}
+
+BENCHMARK_CAPTURE(dataarray_read_hyperslab, plain, false)->Name("dataarray.read.hyperslab")->Apply(hyperslab_args);
+BENCHMARK_CAPTURE(dataarray_read_hyperslab, poly, true)->Name("dataarray.read.hyperslab.poly")->Apply(hyperslab_args);
+
+
+void dataarray_read_full(benchmark::State &state, bool mapped) {
+    const size_t nelms = 1 << 20;
+    ScratchFile scratch(std::string("read-") + (mapped ? "mapped" : "copy"));
+    std::vector<double> values(nelms, 1.0);
+    nix::DataArray da = scratch.block.createDataArray("contiguous", "nix.bench", nix::DataType::Double,
+                                                      nix::NDSize({nelms}), nix::Compression::Auto,
+                                                      nix::DataStorage::Contiguous);
+    da.setData(nix::DataType::Double, values.data(), nix::NDSize({nelms}), nix::NDSize({0}));
+
+    std::vector<double> buffer(nelms);
+    nix::MappedData view;
+    CallCounter calls;
+    for (auto _ : state) {
+        const double *data;
+        if (mapped) {
+            view = da.mappedData();
+            data = view.data<double>();
+        } else {
+            da.getData(nix::DataType::Double, buffer.data(), nix::NDSize({nelms}), nix::NDSize({0}));
+            data = buffer.data();
+        }
+        benchmark::DoNotOptimize(std::accumulate(data, data + nelms, 0.0));
+    }
+    calls.report(state);
+    state.SetBytesProcessed(state.iterations() * nelms * sizeof(double));
+}
+
+BENCHMARK_CAPTURE(dataarray_read_full, copy, false)->Name("dataarray.read.copy")->Apply(defaults);
+BENCHMARK_CAPTURE(dataarray_read_full, mapped, true)->Name("dataarray.read.mapped")->Apply(defaults);
+
+
+enum class Decimate { Subsample, Strided, MinMax };
+
+// 30 kHz down to 1 kHz
+void dataarray_decimate(benchmark::State &state, Decimate mode) {
+    const size_t nelms = 30 * 32768;
+    const nix::ndsize_t factor = 30;
+    const nix::ndsize_t n = nelms / factor;
+
+    ScratchFile scratch("decimate");
+    nix::DataArray da = scratch.block.createDataArray("signal", "nix.bench", sawtooth<int16_t>(nelms));
+
+    std::vector<int16_t> full, decimated, maxima;
+    CallCounter calls;
+    for (auto _ : state) {
+        switch (mode) {
+            case Decimate::Subsample:
+                da.getData(full);
+                decimated.resize(n);
+                for (size_t i = 0; i < n; i++) {
+                    decimated[i] = full[i * factor];
+                }
+                break;
+            case Decimate::Strided:
+                da.getData(decimated, {n}, {0}, {factor});
+                break;
+            case Decimate::MinMax:
+                da.getDataMinMax(decimated, maxima, n);
+                break;
+        }
+        benchmark::DoNotOptimize(decimated.data());
+    }
+    calls.report(state);
+}
+
+BENCHMARK_CAPTURE(dataarray_decimate, subsample, Decimate::Subsample)->Name("dataarray.decimate.subsample")
+    ->Apply(defaults);
+BENCHMARK_CAPTURE(dataarray_decimate, strided, Decimate::Strided)->Name("dataarray.decimate.strided")
+    ->Apply(defaults);
+BENCHMARK_CAPTURE(dataarray_decimate, minmax, Decimate::MinMax)->Name("dataarray.decimate.minmax")
+    ->Apply(defaults);
+
+
+// a region that is not aligned to the chunks
+void dataarray_statistics(benchmark::State &state, bool indexed) {
+    const size_t nelms = 30 * 32768;
+    ScratchFile scratch(std::string("statistics-") + (indexed ? "indexed" : "read"));
+    nix::DataArray da = scratch.block.createDataArray("signal", "nix.bench", sawtooth<int16_t>(nelms));
+    if (indexed) {
+        da.createStatistics();
+    }
+
+    CallCounter calls;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(da.statistics({1234}, {nelms - 4321}));
+    }
+    calls.report(state);
+}
+
+BENCHMARK_CAPTURE(dataarray_statistics, read, false)->Name("dataarray.statistics.read")->Apply(defaults);
+BENCHMARK_CAPTURE(dataarray_statistics, indexed, true)->Name("dataarray.statistics.indexed")->Apply(defaults);
+
+
+// 60 s of a 30 kHz signal on 1000 pixels
+void dataarray_envelope(benchmark::State &state, bool pyramid) {
+    const size_t nelms = 60 * 30000;
+    const size_t pixels = 1000;
+    ScratchFile scratch(std::string("envelope-") + (pyramid ? "pyramid" : "minmax"));
+    nix::DataArray da = scratch.block.createDataArray("signal", "nix.bench", sawtooth<int16_t>(nelms));
+    da.appendSampledDimension(1.0 / 30000);
+    if (pyramid) {
+        da.createPyramid();
+    }
+
+    std::vector<int16_t> min, max;
+    CallCounter calls;
+    for (auto _ : state) {
+        if (pyramid) {
+            benchmark::DoNotOptimize(da.envelope(pixels, 0.0, 60.0));
+        } else {
+            da.getDataMinMax(min, max, pixels);
+            benchmark::DoNotOptimize(min.data());
+        }
+    }
+    calls.report(state);
+}
+
+BENCHMARK_CAPTURE(dataarray_envelope, minmax, false)->Name("dataarray.envelope.minmax")->Apply(defaults);
+BENCHMARK_CAPTURE(dataarray_envelope, pyramid, true)->Name("dataarray.envelope.pyramid")->Apply(defaults);
+
+
+void dataarray_pyramid_build(benchmark::State &state) {
+    const size_t nelms = 1 << 22;
+    ScratchFile scratch("pyramid-build");
+    std::vector<double> values(nelms);
+    for (size_t i = 0; i < nelms; i++) {
+        values[i] = std::sin(i * 0.001);
+    }
+    nix::DataArray da = scratch.block.createDataArray("signal", "nix.bench", values);
+
+    nix::PyramidOptions opts;
+    opts.threads = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        da.createPyramid(opts);
+    }
+    state.SetItemsProcessed(state.iterations() * nelms);
+}
+
+BENCHMARK(dataarray_pyramid_build)->Name("dataarray.pyramid.build")->Apply(defaults)
+    ->ArgName("threads")->Arg(1)->Arg(4)->UseRealTime();
+
+
+// a sliding window of 64 samples, moved by 16
+void dataview_window(benchmark::State &state, bool read_ahead) {
+    const size_t nelms = 1 << 20;
+    const nix::ndsize_t wsize = 64;
+    ScratchFile scratch(std::string("window-") + (read_ahead ? "readahead" : "direct"));
+    nix::DataArray da = scratch.block.createDataArray("signal", "nix.bench", sawtooth<float>(nelms));
+    nix::DataView view(da, nix::NDSize({nelms - 1000}), nix::NDSize({500}));
+    if (read_ahead) {
+        view.readAhead(1 << 20);
+    }
+
+    std::vector<float> window(wsize);
+    nix::NDSize offset(1, 0);
+    CallCounter calls;
+    for (auto _ : state) {
+        view.getData(nix::DataType::Float, window.data(), {wsize}, offset);
+        offset[0] = (offset[0] + 16) % (16 * 1024);
+    }
+    calls.report(state);
+}
+
+BENCHMARK_CAPTURE(dataview_window, direct, false)->Name("dataview.window.direct")->Apply(defaults);
+BENCHMARK_CAPTURE(dataview_window, readahead, true)->Name("dataview.window.readahead")->Apply(defaults);
+
+
+void datacursor_sum(benchmark::State &state, bool prefetch) {
+    const size_t nelms = 4 * 1024 * 1024;
+    ScratchFile scratch(std::string("cursor-") + (prefetch ? "prefetch" : "plain"));
+    nix::DataArray da = scratch.block.createDataArray("signal", "nix.bench", sawtooth<double>(nelms));
+
+    CallCounter calls;
+    for (auto _ : state) {
+        nix::DataCursor<double> cursor(da, 0, 256 * 1024, prefetch);
+        double sum = 0.0;
+        while (cursor.next()) {
+            sum = std::accumulate(cursor.data(), cursor.data() + cursor.size(), sum);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    calls.report(state);
+    state.SetBytesProcessed(state.iterations() * nelms * sizeof(double));
+}
+
+BENCHMARK_CAPTURE(datacursor_sum, plain, false)->Name("datacursor.sum.plain")->Apply(defaults)->UseRealTime();
+BENCHMARK_CAPTURE(datacursor_sum, prefetch, true)->Name("datacursor.sum.prefetch")->Apply(defaults)->UseRealTime();
+
+
+// every thread reads its own DataArray of the shared file
+void file_concurrent_read(benchmark::State &state) {
+    const size_t nelms = 256 * 1024;
+    const size_t nthreads = static_cast<size_t>(state.range(0));
+    ScratchFile scratch("concurrent");
+    std::vector<nix::DataArray> arrays;
+    for (size_t t = 0; t < nthreads; t++) {
+        nix::DataArray da = scratch.block.createDataArray("array." + std::to_string(t), "nix.bench",
+                                                          sawtooth<int16_t>(nelms));
+        da.polynomCoefficients({0.0, 0.25});
+        arrays.push_back(da);
+    }
+
+    for (auto _ : state) {
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < nthreads; t++) {
+            workers.emplace_back([&arrays, t] {
+                std::vector<double> data;
+                arrays[t].getData(data);
+                benchmark::DoNotOptimize(data.data());
+            });
+        }
+        for (auto &w : workers) {
+            w.join();
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * nthreads * nelms * sizeof(double));
+}
+
+BENCHMARK(file_concurrent_read)->Name("file.concurrent.read")->Apply(defaults)
+    ->ArgName("threads")->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+
+// the disk without HDF5, as a baseline for the writes and reads above
+void io_raw(benchmark::State &state, bool write) {
+    const size_t nbytes = 2048 * sizeof(double);
+    const size_t nblocks = 4096;
+    ScratchPath scratch("raw.bin");
+    std::vector<char> buffer(nbytes, 1);
+
+    if (!write) {
+        std::FILE *fd = std::fopen(scratch.path().c_str(), "wb");
+        for (size_t i = 0; i < nblocks; i++) {
+            std::fwrite(buffer.data(), 1, nbytes, fd);
+        }
+        std::fclose(fd);
+    }
+
+    std::FILE *fd = std::fopen(scratch.path().c_str(), write ? "wb" : "rb");
+    std::setvbuf(fd, nullptr, _IONBF, 0);
+    size_t block = 0;
+    for (auto _ : state) {
+        if (block++ == nblocks) {
+            std::rewind(fd);
+            block = 1;
+        }
+        const size_t n = write ? std::fwrite(buffer.data(), 1, nbytes, fd) : std::fread(buffer.data(), 1, nbytes, fd);
+        if (n != nbytes) {
+            state.SkipWithError("raw i/o failed");
+            break;
+        }
+    }
+    std::fclose(fd);
+    state.SetBytesProcessed(state.iterations() * nbytes);
+}
+
+BENCHMARK_CAPTURE(io_raw, write, true)->Name("io.raw.write")->Apply(defaults);
+BENCHMARK_CAPTURE(io_raw, read, false)->Name("io.raw.read")->Apply(defaults);
+
+} // namespace
@@ -0,0 +1,341 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "BenchCommon.hpp"
+
+using namespace bench;
+
+namespace {
+
+enum class Kind { Block, DataArray, Tag, MultiTag, Group, Source, Section };
+
+const char *kind_name(Kind kind) {
+    switch (kind) {
+        case Kind::Block:     return "block";
+        case Kind::DataArray: return "dataarray";
+        case Kind::Tag:       return "tag";
+        case Kind::MultiTag:  return "multitag";
+        case Kind::Group:     return "group";
+        case Kind::Source:    return "source";
+        case Kind::Section:   return "section";
+    }
+    return "";
+}
+
+
+// the entities are created in a block, or a section, of their own, multi tags
+// with positions from that block
+void create_entity(Kind kind, nix::File &file, nix::Block &block, nix::Section &section,
+                   const nix::DataArray &positions, const std::string &name) {
+    switch (kind) {
+        case Kind::Block:
+            file.createBlock(name, "nix.bench");
+            break;
+        case Kind::DataArray:
+            block.createDataArray(name, "nix.bench", nix::DataType::Double, nix::NDSize({16}));
+            break;
+        case Kind::Tag:
+            block.createTag(name, "nix.bench", std::vector<double>{0.0});
+            break;
+        case Kind::MultiTag:
+            block.createMultiTag(name, "nix.bench", positions);
+            break;
+        case Kind::Group:
+            block.createGroup(name, "nix.bench");
+            break;
+        case Kind::Source:
+            block.createSource(name, "nix.bench");
+            break;
+        case Kind::Section:
+            section.createSection(name, "nix.bench");
+            break;
+    }
+}
+
+
+void entity_create(benchmark::State &state, Kind kind) {
+    const int64_t backend = state.range(0);
+    const int64_t count = state.range(1);
+    if (!require_backend(state, backend)) {
+        return;
+    }
+
+    ScratchFile scratch(std::string("create-") + kind_name(kind), backend);
+    nix::File &file = scratch.file;
+
+    std::vector<std::string> names;
+    for (int64_t i = 0; i < count; i++) {
+        names.push_back("entity." + std::to_string(i));
+    }
+
+    CallCounter calls;
+    size_t round = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        const std::string parent = "round." + std::to_string(round++);
+        nix::Block block = file.createBlock(parent, "nix.bench");
+        nix::Section section = file.createSection(parent, "nix.bench");
+        nix::DataArray positions;
+        if (kind == Kind::MultiTag) {
+            positions = block.createDataArray("positions", "nix.bench", std::vector<double>{0.0});
+        }
+        state.ResumeTiming();
+
+        for (const std::string &name : names) {
+            create_entity(kind, file, block, section, positions, parent + "." + name);
+        }
+
+        state.PauseTiming();
+        if (kind == Kind::Block) {
+            for (const std::string &name : names) {
+                file.deleteBlock(parent + "." + name);
+            }
+        }
+        file.deleteBlock(block);
+        file.deleteSection(section);
+        state.ResumeTiming();
+    }
+    calls.report(state);
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+
+void entity_args(benchmark::internal::Benchmark *b) {
+    defaults(b);
+    b->ArgNames({"backend", "count"});
+    b->ArgsProduct({{HDF5, FS}, {10, 100}});
+}
+
+BENCHMARK_CAPTURE(entity_create, block, Kind::Block)->Name("entity.create.block")->Apply(entity_args);
+BENCHMARK_CAPTURE(entity_create, dataarray, Kind::DataArray)->Name("entity.create.dataarray")->Apply(entity_args);
+BENCHMARK_CAPTURE(entity_create, tag, Kind::Tag)->Name("entity.create.tag")->Apply(entity_args);
+BENCHMARK_CAPTURE(entity_create, multitag, Kind::MultiTag)->Name("entity.create.multitag")->Apply(entity_args);
+BENCHMARK_CAPTURE(entity_create, group, Kind::Group)->Name("entity.create.group")->Apply(entity_args);
+BENCHMARK_CAPTURE(entity_create, source, Kind::Source)->Name("entity.create.source")->Apply(entity_args);
+BENCHMARK_CAPTURE(entity_create, section, Kind::Section)->Name("entity.create.section")->Apply(entity_args);
+
+
+// a block with count data arrays, looked up one after the other
+void entity_lookup(benchmark::State &state, bool by_id) {
+    const int64_t backend = state.range(0);
+    const int64_t count = state.range(1);
+    if (!require_backend(state, backend)) {
+        return;
+    }
+
+    ScratchFile scratch(std::string("lookup-") + (by_id ? "id" : "name"), backend);
+    std::vector<std::string> keys;
+    for (int64_t i = 0; i < count; i++) {
+        nix::DataArray da = scratch.block.createDataArray("array." + std::to_string(i), "nix.bench",
+                                                          nix::DataType::Double, nix::NDSize({1}));
+        keys.push_back(by_id ? da.id() : da.name());
+    }
+
+    CallCounter calls;
+    size_t next = 0;
+    for (auto _ : state) {
+        nix::DataArray da = scratch.block.getDataArray(keys[next]);
+        if (!da) {
+            state.SkipWithError("lookup failed");
+            break;
+        }
+        next = (next + 1) % keys.size();
+    }
+    calls.report(state);
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+void lookup_args(benchmark::internal::Benchmark *b) {
+    defaults(b);
+    b->ArgNames({"backend", "count"});
+    b->ArgsProduct({{HDF5, FS}, {10, 1000}});
+}
+
+BENCHMARK_CAPTURE(entity_lookup, id, true)->Name("entity.lookup.id")->Apply(lookup_args);
+BENCHMARK_CAPTURE(entity_lookup, name, false)->Name("entity.lookup.name")->Apply(lookup_args);
+
+
+void entity_lookup_missing(benchmark::State &state) {
+    const int64_t backend = state.range(0);
+    const int64_t count = state.range(1);
+    if (!require_backend(state, backend)) {
+        return;
+    }
+
+    ScratchFile scratch("lookup-missing", backend);
+    for (int64_t i = 0; i < count; i++) {
+        scratch.block.createDataArray("array." + std::to_string(i), "nix.bench",
+                                      nix::DataType::Double, nix::NDSize({1}));
+    }
+
+    const std::string missing = nix::util::createId();
+    CallCounter calls;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scratch.block.hasDataArray(missing));
+    }
+    calls.report(state);
+}
+
+BENCHMARK(entity_lookup_missing)->Name("entity.lookup.missing")->Apply(lookup_args);
+
+
+enum class Listing { All, Type, Count };
+
+// a block with count data arrays, every tenth of another type
+void entity_list(benchmark::State &state, Listing listing) {
+    const int64_t backend = state.range(0);
+    const int64_t count = state.range(1);
+    if (!require_backend(state, backend)) {
+        return;
+    }
+
+    ScratchFile scratch("list", backend);
+    for (int64_t i = 0; i < count; i++) {
+        scratch.block.createDataArray("array." + std::to_string(i), i % 10 ? "nix.bench" : "nix.bench.odd",
+                                      nix::DataType::Double, nix::NDSize({1}));
+    }
+
+    const nix::util::TypeFilter<nix::DataArray> odd("nix.bench.odd");
+    CallCounter calls;
+    for (auto _ : state) {
+        switch (listing) {
+            case Listing::All:
+                benchmark::DoNotOptimize(scratch.block.dataArrays());
+                break;
+            case Listing::Type:
+                benchmark::DoNotOptimize(scratch.block.dataArrays(odd));
+                break;
+            case Listing::Count:
+                benchmark::DoNotOptimize(scratch.block.dataArrayCount());
+                break;
+        }
+    }
+    calls.report(state);
+    state.SetItemsProcessed(state.iterations() * (listing == Listing::Count ? 1 : count));
+}
+
+BENCHMARK_CAPTURE(entity_list, all, Listing::All)->Name("entity.list.all")->Apply(lookup_args);
+BENCHMARK_CAPTURE(entity_list, type, Listing::Type)->Name("entity.list.type")->Apply(lookup_args);
+BENCHMARK_CAPTURE(entity_list, count, Listing::Count)->Name("entity.list.count")->Apply(lookup_args);
+
+
+// the file system back-end walks its directory index, listing large blocks
+void large_list_args(benchmark::internal::Benchmark *b) {
+    defaults(b);
+    b->ArgNames({"backend", "count"});
+    b->ArgsProduct({{FS}, {10000, 100000}});
+}
+
+BENCHMARK_CAPTURE(entity_list, all_large, Listing::All)->Name("entity.list.all")->Apply(large_list_args);
+BENCHMARK_CAPTURE(entity_list, count_large, Listing::Count)->Name("entity.list.count")->Apply(large_list_args);
+
+
+// two lists that differ in a few arrays at either end
+void tag_references_replace(benchmark::State &state) {
+    const int64_t backend = state.range(0);
+    const size_t narrays = static_cast<size_t>(state.range(1));
+    const size_t nchanged = 10;
+    if (!require_backend(state, backend)) {
+        return;
+    }
+
+    ScratchFile scratch("references", backend);
+    std::vector<nix::DataArray> arrays;
+    for (size_t i = 0; i < narrays + nchanged; i++) {
+        arrays.push_back(scratch.block.createDataArray("ref." + std::to_string(i), "nix.bench",
+                                                       nix::DataType::Double, nix::NDSize({1})));
+    }
+    std::vector<nix::DataArray> lists[2];
+    lists[0].assign(arrays.begin(), arrays.begin() + narrays);
+    lists[1].assign(arrays.begin() + nchanged, arrays.end());
+
+    nix::Tag tag = scratch.block.createTag("tag", "nix.bench", std::vector<double>{0.0});
+    tag.references(lists[0]);
+
+    CallCounter calls;
+    bool flip = false;
+    for (auto _ : state) {
+        flip = !flip;
+        tag.references(lists[flip]);
+    }
+    calls.report(state);
+}
+
+BENCHMARK(tag_references_replace)->Name("tag.references.replace")->Apply(defaults)
+    ->ArgNames({"backend", "count"})->ArgsProduct({{HDF5, FS}, {100, 1000}});
+
+
+// arrays that are each referenced by all tags and a group
+void block_delete_referenced(benchmark::State &state, bool bulk) {
+    const int64_t backend = state.range(0);
+    const size_t narrays = 8;
+    const size_t ntags = 32;
+    if (!require_backend(state, backend)) {
+        return;
+    }
+
+    ScratchFile scratch(std::string("delete-") + (bulk ? "bulk" : "single"), backend);
+    CallCounter calls;
+    for (auto _ : state) {
+        state.PauseTiming();
+        nix::Block b = scratch.file.createBlock("delete", "nix.bench");
+        std::vector<nix::DataArray> arrays;
+        for (size_t i = 0; i < narrays; i++) {
+            arrays.push_back(b.createDataArray("array." + std::to_string(i), "nix.bench",
+                                               nix::DataType::Double, nix::NDSize({1})));
+        }
+        for (size_t i = 0; i < ntags; i++) {
+            nix::Tag t = b.createTag("tag." + std::to_string(i), "nix.bench", std::vector<double>{0.0});
+            t.references(arrays);
+        }
+        b.createGroup("group", "nix.bench").dataArrays(arrays);
+        state.ResumeTiming();
+
+        if (bulk) {
+            b.deleteEntities(std::vector<nix::Identity>(arrays.begin(), arrays.end()));
+        } else {
+            for (const auto &a : arrays) {
+                b.deleteDataArray(a);
+            }
+        }
+
+        state.PauseTiming();
+        if (b.dataArrayCount() != 0) {
+            state.SkipWithError("delete failed");
+            break;
+        }
+        scratch.file.deleteBlock(b);
+        state.ResumeTiming();
+    }
+    calls.report(state);
+}
+
+BENCHMARK_CAPTURE(block_delete_referenced, single, false)->Name("block.delete.referenced.single")
+    ->Apply(defaults)->Apply(all_backends);
+BENCHMARK_CAPTURE(block_delete_referenced, bulk, true)->Name("block.delete.referenced.bulk")
+    ->Apply(defaults)->Apply(all_backends);
+
+
+void create_id(benchmark::State &state, bool reuse) {
+    std::string id;
+    for (auto _ : state) {
+        if (reuse) {
+            nix::util::createId(id);
+        } else {
+            id = nix::util::createId();
+        }
+        benchmark::DoNotOptimize(id.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_CAPTURE(create_id, new, false)->Name("util.createId.new")->Apply(defaults);
+BENCHMARK_CAPTURE(create_id, reuse, true)->Name("util.createId.reuse")->Apply(defaults);
+
+} // namespace
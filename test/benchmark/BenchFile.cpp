@@ -0,0 +1,227 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "BenchCommon.hpp"
+
+#include <boost/filesystem.hpp>
+
+using namespace bench;
+
+namespace {
+
+// the same work on disk and in memory, the difference is the cost of the disk
+void file_roundtrip(benchmark::State &state, nix::OpenFlags flags) {
+    const size_t narrays = 16;
+    const std::vector<double> values = sawtooth<double>(16 * 1024);
+    ScratchPath scratch("roundtrip.h5");
+
+    std::vector<double> data;
+    CallCounter calls;
+    for (auto _ : state) {
+        nix::File f = nix::File::open(scratch.path(), nix::FileMode::Overwrite, "hdf5",
+                                      nix::Compression::Auto, flags);
+        nix::Block b = f.createBlock("roundtrip", "nix.bench");
+        for (size_t i = 0; i < narrays; i++) {
+            nix::DataArray da = b.createDataArray("array." + std::to_string(i), "nix.bench", values);
+            da.appendSampledDimension(0.1);
+        }
+        for (size_t i = 0; i < narrays; i++) {
+            b.getDataArray(i).getData(data);
+        }
+        f.close();
+        if (data.size() != values.size()) {
+            state.SkipWithError("round trip failed");
+            break;
+        }
+    }
+    calls.report(state);
+    state.SetBytesProcessed(state.iterations() * narrays * values.size() * sizeof(double));
+}
+
+BENCHMARK_CAPTURE(file_roundtrip, disk, nix::OpenFlags::None)->Name("file.roundtrip.disk")->Apply(defaults);
+BENCHMARK_CAPTURE(file_roundtrip, memory, nix::OpenFlags::InMemory)->Name("file.roundtrip.memory")
+    ->Apply(defaults);
+
+
+// a directory of small NIX files, removed with the directory
+std::vector<std::string> create_files(const ScratchPath &dir, size_t nfiles,
+                                      void (*fill)(nix::File &file, size_t index)) {
+    boost::filesystem::create_directory(dir.path());
+    std::vector<std::string> names;
+    for (size_t i = 0; i < nfiles; i++) {
+        names.push_back((boost::filesystem::path(dir.path()) / ("file-" + std::to_string(i) + ".h5")).string());
+        nix::File f = nix::File::open(names.back(), nix::FileMode::Overwrite);
+        fill(f, i);
+        f.close();
+    }
+    return names;
+}
+
+
+void fill_probe(nix::File &file, size_t index) {
+    file.createBlock("probe", "nix.bench");
+}
+
+
+void file_probe(benchmark::State &state, bool probe) {
+    ScratchPath dir(probe ? "probe" : "open");
+    const std::vector<std::string> names = create_files(dir, 64, fill_probe);
+
+    CallCounter calls;
+    for (auto _ : state) {
+        if (probe) {
+            for (const nix::FileHeader &header : nix::File::probe(names)) {
+                if (!header.valid) {
+                    state.SkipWithError(("probe failed: " + header.error).c_str());
+                    break;
+                }
+            }
+        } else {
+            for (const std::string &name : names) {
+                nix::File f = nix::File::open(name, nix::FileMode::ReadOnly);
+                benchmark::DoNotOptimize(f.id());
+                f.close();
+            }
+        }
+    }
+    calls.report(state);
+    state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+BENCHMARK_CAPTURE(file_probe, probe, true)->Name("file.probe")->Apply(defaults);
+BENCHMARK_CAPTURE(file_probe, open, false)->Name("file.open.readonly")->Apply(defaults);
+
+
+const size_t CATALOG_ARRAYS = 16;
+
+// every fourth file is of subject "X"
+void fill_catalog(nix::File &file, size_t index) {
+    nix::Section s = file.createSection("session", "recording");
+    s.createProperty("subject", nix::Variant(std::string(index % 4 == 0 ? "X" : "Y")));
+    nix::Block b = file.createBlock("catalog", "nix.bench");
+    for (size_t k = 0; k < CATALOG_ARRAYS; k++) {
+        nix::DataArray da = b.createDataArray("array." + std::to_string(k), "nix.bench",
+                                              nix::DataType::Double, nix::NDSize({1}));
+        da.metadata(s);
+    }
+}
+
+
+void catalog_find(benchmark::State &state, bool indexed) {
+    const size_t nfiles = 32;
+    ScratchPath dir(indexed ? "catalog" : "catalog-files");
+    const std::vector<std::string> names = create_files(dir, nfiles, fill_catalog);
+    const nix::Catalog catalog = indexed ? nix::Catalog::build(names) : nix::Catalog();
+
+    auto match = [](const nix::Section &s) {
+        return s.hasProperty("subject") && s.getProperty("subject").values()[0].get<std::string>() == "X";
+    };
+
+    CallCounter calls;
+    for (auto _ : state) {
+        size_t hits = 0;
+        if (indexed) {
+            hits = catalog.find("subject", "X", nix::ObjectType::DataArray).size();
+        } else {
+            for (const std::string &name : names) {
+                nix::File f = nix::File::open(name, nix::FileMode::ReadOnly);
+                for (const nix::Section &s : f.findSections(match)) {
+                    hits += s.referringDataArrays().size();
+                }
+                f.close();
+            }
+        }
+        if (hits != nfiles / 4 * CATALOG_ARRAYS) {
+            state.SkipWithError("catalog search failed");
+            break;
+        }
+    }
+    calls.report(state);
+}
+
+BENCHMARK_CAPTURE(catalog_find, indexed, true)->Name("catalog.find")->Apply(defaults);
+BENCHMARK_CAPTURE(catalog_find, files, false)->Name("catalog.find.files")->Apply(defaults);
+
+
+void copy_data_array(benchmark::State &state, bool engine) {
+    ScratchFile scratch(std::string("copy-source-") + (engine ? "engine" : "getset"));
+    nix::DataArray source = scratch.block.createDataArray("source", "nix.bench", sawtooth<double>(1 << 22),
+                                                          nix::DataType::Double, nix::Compression::DeflateNormal);
+    source.appendSampledDimension(0.1);
+    ScratchPath target(std::string("copy-target-") + (engine ? "engine" : "getset") + ".h5");
+
+    CallCounter calls;
+    for (auto _ : state) {
+        nix::File f = nix::File::open(target.path(), nix::FileMode::Overwrite);
+        nix::Block b = f.createBlock("copy", "nix.bench");
+        nix::DataArray da;
+        if (engine) {
+            da = b.copyDataArray(source);
+        } else {
+            std::vector<double> data;
+            source.getData(data);
+            da = b.createDataArray(source.name(), source.type(), data, nix::DataType::Double,
+                                   nix::Compression::DeflateNormal);
+            da.appendSampledDimension(source.getDimension(1).asSampledDimension().samplingInterval());
+        }
+        const bool copied = da.dataExtent() == source.dataExtent();
+        f.close();
+        if (!copied) {
+            state.SkipWithError("copy failed");
+            break;
+        }
+    }
+    calls.report(state);
+    state.SetBytesProcessed(state.iterations() * (1 << 22) * sizeof(double));
+}
+
+BENCHMARK_CAPTURE(copy_data_array, engine, true)->Name("copy.dataarray.engine")->Apply(defaults);
+BENCHMARK_CAPTURE(copy_data_array, getset, false)->Name("copy.dataarray.getset")->Apply(defaults);
+
+
+// half of the arrays are deleted, repacking gives their space back
+void file_repack(benchmark::State &state, bool rewrite) {
+    const size_t narrays = 8;
+    ScratchPath source(std::string("repack-") + (rewrite ? "rewrite" : "copy") + ".h5");
+    ScratchPath target(std::string("repack-") + (rewrite ? "rewrite" : "copy") + "-packed.h5");
+    {
+        nix::File f = nix::File::open(source.path(), nix::FileMode::Overwrite);
+        nix::Block b = f.createBlock("repack", "nix.bench");
+        const std::vector<double> data = sawtooth<double>(1 << 20);
+        for (size_t k = 0; k < narrays; k++) {
+            b.createDataArray("array." + std::to_string(k), "nix.bench", data);
+        }
+        for (size_t k = 0; k < narrays; k += 2) {
+            b.deleteDataArray("array." + std::to_string(k));
+        }
+        f.close();
+    }
+
+    nix::RepackOptions options;
+    if (rewrite) {
+        options.layout = nix::DataLayout({1 << 16}, nix::Compression::DeflateNormal);
+    }
+
+    nix::RepackReport report;
+    for (auto _ : state) {
+        report = nix::File::repack(source.path(), target.path(), options);
+        if (report.arrays != narrays / 2 || report.size_after >= report.size_before) {
+            state.SkipWithError("repack failed");
+            break;
+        }
+    }
+    state.counters["size_before"] = static_cast<double>(report.size_before);
+    state.counters["size_after"] = static_cast<double>(report.size_after);
+}
+
+BENCHMARK_CAPTURE(file_repack, copy, false)->Name("file.repack.copy")->Apply(defaults)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(file_repack, rewrite, true)->Name("file.repack.rewrite")->Apply(defaults)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
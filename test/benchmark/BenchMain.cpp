@@ -0,0 +1,50 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+// nix-bench: the micro benchmarks of the library.
+//
+// The cases are named <area>.<operation>[.<variant>], parameterized ones
+// get their arguments appended by Google Benchmark, e.g.
+// "entity.create.dataarray/backend:0/count:100". Useful options:
+//
+//   --benchmark_filter=<regex>          run only the matching cases
+//   --benchmark_repetitions=<n>         repeat cases and report mean, median, stddev, cv
+//   --benchmark_out=<file>              also write the results to a file ...
+//   --benchmark_out_format=json         ... as JSON, to compare releases, e.g. with
+//                                       compare.py of Google Benchmark
+//
+// Scratch files are created in the working directory and removed again.
+// With a library built with -DENABLE_STATS=ON every case also reports the
+// HDF5 calls per iteration.
+
+#include "BenchCommon.hpp"
+
+#include <nix/Version.hpp>
+
+#include <sstream>
+
+
+int main(int argc, char **argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    std::stringstream version;
+    const std::vector<int> v = nix::apiVersion();
+    for (size_t i = 0; i < v.size(); i++) {
+        version << (i ? "." : "") << v[i];
+    }
+    benchmark::AddCustomContext("nix_version", version.str());
+    benchmark::AddCustomContext("nix_stats", nix::stats().enabled ? "on" : "off");
+    benchmark::AddCustomContext("nix_backends", bench::backend_available(bench::FS) ? "hdf5 file" : "hdf5");
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
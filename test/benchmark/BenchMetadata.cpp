@@ -0,0 +1,245 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "BenchCommon.hpp"
+
+#include <nix/valid/validate.hpp>
+
+using namespace bench;
+
+namespace {
+
+const std::string LONG_STRING(64, 'x');
+
+
+void variant_copy(benchmark::State &state, nix::Variant value) {
+    const std::vector<nix::Variant> values(1024, value);
+    for (auto _ : state) {
+        std::vector<nix::Variant> copy = values;
+        std::vector<nix::Variant> moved = std::move(copy);
+        benchmark::DoNotOptimize(moved.data());
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK_CAPTURE(variant_copy, double, nix::Variant(42.0))->Name("variant.copy.double")->Apply(defaults);
+BENCHMARK_CAPTURE(variant_copy, short_string, nix::Variant("short"))->Name("variant.copy.short-string")
+    ->Apply(defaults);
+BENCHMARK_CAPTURE(variant_copy, long_string, nix::Variant(LONG_STRING))->Name("variant.copy.long-string")
+    ->Apply(defaults);
+
+
+// write and read back count values
+void property_values(benchmark::State &state, nix::Variant value) {
+    const int64_t backend = state.range(0);
+    const size_t count = static_cast<size_t>(state.range(1));
+    if (!require_backend(state, backend)) {
+        return;
+    }
+
+    ScratchFile scratch("property-values", backend);
+    const std::vector<nix::Variant> values(count, value);
+    nix::Property property = scratch.file.createSection("section", "nix.bench").createProperty("values", values);
+
+    CallCounter calls;
+    for (auto _ : state) {
+        property.values(values);
+        benchmark::DoNotOptimize(property.values());
+    }
+    calls.report(state);
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+
+void values_args(benchmark::internal::Benchmark *b) {
+    defaults(b);
+    b->ArgNames({"backend", "count"});
+    b->ArgsProduct({{HDF5, FS}, {1, 128}});
+}
+
+BENCHMARK_CAPTURE(property_values, double, nix::Variant(42.0))->Name("property.values.double")
+    ->Apply(values_args);
+BENCHMARK_CAPTURE(property_values, short_string, nix::Variant("short"))->Name("property.values.short-string")
+    ->Apply(values_args);
+BENCHMARK_CAPTURE(property_values, long_string, nix::Variant(LONG_STRING))->Name("property.values.long-string")
+    ->Apply(values_args);
+
+
+void property_values_typed(benchmark::State &state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    ScratchFile scratch("property-typed");
+    nix::Property property = scratch.file.createSection("section", "nix.bench")
+                                         .createProperty("values", nix::DataType::Double);
+    const std::vector<double> values(count, 42.0);
+    std::vector<double> back;
+
+    CallCounter calls;
+    for (auto _ : state) {
+        property.values(values.data(), values.size());
+        property.values(back);
+        benchmark::DoNotOptimize(back.data());
+    }
+    calls.report(state);
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(property_values_typed)->Name("property.values.typed-double")->Apply(defaults)
+    ->ArgName("count")->Arg(1)->Arg(128);
+
+
+// a tree of sections, fanout children per section and depth levels
+void build_tree(nix::Section parent, size_t fanout, size_t depth) {
+    for (size_t i = 0; i < fanout; i++) {
+        nix::Section s = parent.createSection("s" + std::to_string(i), i % 2 ? "nix.bench.odd" : "nix.bench");
+        s.createProperty("index", nix::Variant(static_cast<int64_t>(i)));
+        if (depth > 1) {
+            build_tree(s, fanout, depth - 1);
+        }
+    }
+}
+
+
+void section_find(benchmark::State &state) {
+    const int64_t backend = state.range(0);
+    if (!require_backend(state, backend)) {
+        return;
+    }
+
+    ScratchFile scratch("section-find", backend);
+    build_tree(scratch.file.createSection("root", "nix.bench"), 4, 4);
+
+    const nix::util::TypeFilter<nix::Section> odd("nix.bench.odd");
+    CallCounter calls;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scratch.file.findSections(odd));
+    }
+    calls.report(state);
+}
+
+BENCHMARK(section_find)->Name("section.find.type")->Apply(defaults)->Apply(all_backends);
+
+
+void section_properties(benchmark::State &state) {
+    const int64_t backend = state.range(0);
+    if (!require_backend(state, backend)) {
+        return;
+    }
+
+    ScratchFile scratch("section-properties", backend);
+    nix::Section section = scratch.file.createSection("section", "nix.bench");
+    for (size_t i = 0; i < 32; i++) {
+        section.createProperty("p" + std::to_string(i), nix::Variant(static_cast<double>(i)));
+    }
+
+    CallCounter calls;
+    for (auto _ : state) {
+        for (const nix::Property &p : section.properties()) {
+            benchmark::DoNotOptimize(p.values());
+        }
+    }
+    calls.report(state);
+    state.SetItemsProcessed(state.iterations() * 32);
+}
+
+BENCHMARK(section_properties)->Name("section.properties.read")->Apply(defaults)->Apply(all_backends);
+
+
+// data arrays with dimensions, tags and metadata, as recorded
+void validate_file(benchmark::State &state) {
+    const size_t narrays = static_cast<size_t>(state.range(0));
+    ScratchFile scratch("validate");
+    nix::Section meta = scratch.file.createSection("session", "recording");
+    for (size_t i = 0; i < narrays; i++) {
+        nix::DataArray da = scratch.block.createDataArray("array." + std::to_string(i), "nix.bench",
+                                                          nix::DataType::Double, nix::NDSize({100}));
+        da.appendSampledDimension(0.001).unit("s");
+        da.unit("mV");
+        da.metadata(meta);
+        nix::Tag tag = scratch.block.createTag("tag." + std::to_string(i), "nix.bench", {0.01});
+        tag.units({"s"});
+        tag.addReference(da);
+    }
+
+    CallCounter calls;
+    for (auto _ : state) {
+        nix::valid::Result result = scratch.file.validate();
+        if (result.hasErrors()) {
+            state.SkipWithError("validation failed");
+            break;
+        }
+    }
+    calls.report(state);
+    state.SetItemsProcessed(state.iterations() * narrays);
+}
+
+BENCHMARK(validate_file)->Name("validate.file")->Apply(defaults)->ArgName("arrays")->Arg(10)->Arg(100);
+
+
+nix::DataFrame make_frame(nix::Block block, nix::ndsize_t nrows) {
+    std::vector<nix::Column> cols = {{"int32", "V", nix::DataType::Int32},
+                                     {"string", "", nix::DataType::String},
+                                     {"double", "mV", nix::DataType::Double}};
+    nix::DataFrame df = block.createDataFrame("frame", "nix.bench", cols);
+    df.rows(nrows);
+    for (nix::ndsize_t i = 0; i < nrows; i++) {
+        df.writeRow(i, {nix::Variant(static_cast<int32_t>(i)),
+                        nix::Variant("row " + std::to_string(i)),
+                        nix::Variant(i * 0.5)});
+    }
+    return df;
+}
+
+
+void dataframe_row(benchmark::State &state, bool write) {
+    const nix::ndsize_t nrows = 1000;
+    ScratchFile scratch(std::string("dataframe-row-") + (write ? "write" : "read"));
+    nix::DataFrame df = make_frame(scratch.block, nrows);
+
+    nix::ndsize_t row = 0;
+    CallCounter calls;
+    for (auto _ : state) {
+        if (write) {
+            df.writeRow(row, {nix::Variant(static_cast<int32_t>(row)), nix::Variant("written"),
+                              nix::Variant(row * 0.25)});
+        } else {
+            benchmark::DoNotOptimize(df.readRow(row));
+        }
+        row = (row + 1) % nrows;
+    }
+    calls.report(state);
+}
+
+BENCHMARK_CAPTURE(dataframe_row, read, false)->Name("dataframe.row.read")->Apply(defaults);
+BENCHMARK_CAPTURE(dataframe_row, write, true)->Name("dataframe.row.write")->Apply(defaults);
+
+
+void dataframe_column(benchmark::State &state, bool write) {
+    const nix::ndsize_t nrows = static_cast<nix::ndsize_t>(state.range(0));
+    ScratchFile scratch(std::string("dataframe-column-") + (write ? "write" : "read"));
+    nix::DataFrame df = make_frame(scratch.block, nrows);
+
+    std::vector<double> values(nrows, 1.5);
+    CallCounter calls;
+    for (auto _ : state) {
+        if (write) {
+            df.writeColumn("double", values);
+        } else {
+            df.readColumn("double", values, true);
+            benchmark::DoNotOptimize(values.data());
+        }
+    }
+    calls.report(state);
+    state.SetItemsProcessed(state.iterations() * nrows);
+}
+
+BENCHMARK_CAPTURE(dataframe_column, read, false)->Name("dataframe.column.read")->Apply(defaults)
+    ->ArgName("rows")->Arg(100)->Arg(10000);
+BENCHMARK_CAPTURE(dataframe_column, write, true)->Name("dataframe.column.write")->Apply(defaults)
+    ->ArgName("rows")->Arg(100)->Arg(10000);
+
+} // namespace
@@ -0,0 +1,233 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "BenchCommon.hpp"
+
+#include <nix/util/dataAccess.hpp>
+
+#include <memory>
+
+using namespace bench;
+
+namespace {
+
+// a 100 s signal with a segment of 50 ms every 90 ms
+struct TaggedSignal {
+    explicit TaggedSignal(const std::string &name, size_t npos)
+        : scratch(name) {
+        data = scratch.block.createDataArray("signal", "nix.bench", std::vector<double>(100000, 1.0));
+        data.appendSampledDimension(0.001);
+
+        std::vector<double> starts(npos), extents(npos, 0.05);
+        for (size_t i = 0; i < npos; i++) {
+            starts[i] = i * 0.09;
+        }
+        nix::DataArray pos = scratch.block.createDataArray("starts", "nix.bench", starts);
+        nix::DataArray ext = scratch.block.createDataArray("extents", "nix.bench", extents);
+        tag = scratch.block.createMultiTag("segments", "nix.bench", pos);
+        tag.extents(ext);
+        tag.addReference(data);
+    }
+
+    ScratchFile    scratch;
+    nix::DataArray data;
+    nix::MultiTag  tag;
+};
+
+
+enum class Retrieval { PerPosition, Batch, Resolved };
+
+void multitag_tagged_data(benchmark::State &state, Retrieval mode) {
+    const size_t npos = static_cast<size_t>(state.range(0));
+    TaggedSignal signal("multitag", npos);
+
+    CallCounter calls;
+    for (auto _ : state) {
+        std::vector<nix::DataView> views;
+        std::vector<nix::ndsize_t> all;
+        switch (mode) {
+            case Retrieval::PerPosition:
+                for (nix::ndsize_t i = 0; i < npos; i++) {
+                    views.push_back(signal.tag.taggedData(i, 0));
+                }
+                break;
+            case Retrieval::Batch:
+                views = signal.tag.taggedData(all, 0);
+                break;
+            case Retrieval::Resolved:
+                views = nix::util::taggedData(nix::util::ResolvedMultiTag(signal.tag), all, signal.data);
+                break;
+        }
+        if (views.size() != npos) {
+            state.SkipWithError("MultiTag retrieval failed");
+            break;
+        }
+    }
+    calls.report(state);
+    state.SetItemsProcessed(state.iterations() * npos);
+}
+
+
+void positions_args(benchmark::internal::Benchmark *b) {
+    defaults(b);
+    b->ArgName("positions")->Arg(10)->Arg(1000);
+}
+
+BENCHMARK_CAPTURE(multitag_tagged_data, per_position, Retrieval::PerPosition)
+    ->Name("multitag.taggedData.per-position")->Apply(positions_args);
+BENCHMARK_CAPTURE(multitag_tagged_data, batch, Retrieval::Batch)
+    ->Name("multitag.taggedData.batch")->Apply(positions_args);
+BENCHMARK_CAPTURE(multitag_tagged_data, resolved, Retrieval::Resolved)
+    ->Name("multitag.taggedData.resolved")->Apply(positions_args);
+
+
+void multitag_read_segments(benchmark::State &state) {
+    const size_t npos = static_cast<size_t>(state.range(0));
+    TaggedSignal signal("multitag-read", npos);
+    nix::util::ResolvedMultiTag resolved(signal.tag);
+
+    std::vector<double> buffer;
+    CallCounter calls;
+    for (auto _ : state) {
+        std::vector<nix::ndsize_t> all;
+        for (const nix::DataView &view : nix::util::taggedData(resolved, all, signal.data)) {
+            view.getData(buffer);
+            benchmark::DoNotOptimize(buffer.data());
+        }
+    }
+    calls.report(state);
+    state.SetItemsProcessed(state.iterations() * npos);
+}
+
+BENCHMARK(multitag_read_segments)->Name("multitag.taggedData.read")->Apply(positions_args);
+
+
+void tag_tagged_data(benchmark::State &state) {
+    ScratchFile scratch("tag");
+    nix::DataArray data = scratch.block.createDataArray("signal", "nix.bench", std::vector<double>(100000, 1.0));
+    data.appendSampledDimension(0.001);
+    nix::Tag tag = scratch.block.createTag("segment", "nix.bench", std::vector<double>{10.0});
+    tag.extent({5.0});
+    tag.addReference(data);
+
+    std::vector<double> buffer;
+    CallCounter calls;
+    for (auto _ : state) {
+        tag.taggedData(0).getData(buffer);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    calls.report(state);
+}
+
+BENCHMARK(tag_tagged_data)->Name("tag.taggedData.read")->Apply(defaults);
+
+
+void position_to_index(benchmark::State &state) {
+    const size_t npos = static_cast<size_t>(state.range(0));
+    ScratchFile scratch("position-to-index");
+    nix::DataArray da = scratch.block.createDataArray("signal", "nix.bench", nix::DataType::Double, {100000});
+    nix::SampledDimension dim = da.appendSampledDimension(0.001);
+    dim.unit("s");
+
+    std::vector<double> starts, ends;
+    for (size_t i = 0; i < npos; i++) {
+        starts.push_back(i * 9.0);
+        ends.push_back(i * 9.0 + 5.0);
+    }
+    const std::vector<std::string> units(npos, "ms");
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(nix::util::positionToIndex(starts, ends, units, nix::RangeMatch::Exclusive, dim));
+    }
+    state.SetItemsProcessed(state.iterations() * npos);
+}
+
+BENCHMARK(position_to_index)->Name("util.positionToIndex.scaled")->Apply(defaults)
+    ->ArgName("positions")->Arg(100)->Arg(10000);
+
+
+void sampled_index_of(benchmark::State &state, bool batch) {
+    const size_t npos = static_cast<size_t>(state.range(0));
+    ScratchFile scratch("sampled-index-of");
+    nix::DataArray da = scratch.block.createDataArray("signal", "nix.bench", nix::DataType::Double, {100000});
+    nix::SampledDimension dim = da.appendSampledDimension(0.001);
+
+    std::vector<double> starts, ends;
+    for (size_t i = 0; i < npos; i++) {
+        starts.push_back(i * 0.0173);
+        ends.push_back(i * 0.0173 + 0.005);
+    }
+    std::vector<nix::ndsize_t> start_indices(npos), end_indices(npos);
+    std::unique_ptr<bool[]> valid(new bool[npos]);
+
+    for (auto _ : state) {
+        if (batch) {
+            benchmark::DoNotOptimize(dim.indexOf(starts.data(), ends.data(), npos, start_indices.data(),
+                                                 end_indices.data(), valid.get(), nix::RangeMatch::Exclusive));
+        } else {
+            benchmark::DoNotOptimize(dim.indexOf(starts, ends, nix::RangeMatch::Exclusive));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * npos);
+}
+
+BENCHMARK_CAPTURE(sampled_index_of, vector, false)->Name("dimension.sampled.indexOf.vector")->Apply(defaults)
+    ->ArgName("positions")->Arg(1000)->Arg(1000000);
+BENCHMARK_CAPTURE(sampled_index_of, batch, true)->Name("dimension.sampled.indexOf.batch")->Apply(defaults)
+    ->ArgName("positions")->Arg(1000)->Arg(1000000);
+
+
+// irregular ticks, as of spike times
+void range_index_of(benchmark::State &state) {
+    const size_t nticks = static_cast<size_t>(state.range(0));
+    ScratchFile scratch("range-index-of");
+    std::vector<double> ticks(nticks);
+    for (size_t i = 0; i < nticks; i++) {
+        ticks[i] = i * 0.01 + (i % 7) * 0.001;
+    }
+    nix::DataArray da = scratch.block.createDataArray("events", "nix.bench", nix::DataType::Double, {nticks});
+    nix::RangeDimension dim = da.appendRangeDimension(ticks);
+
+    const double last = ticks.back();
+    double position = 0.0;
+    CallCounter calls;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dim.indexOf(position, nix::PositionMatch::GreaterOrEqual));
+        position += 0.37;
+        if (position > last) {
+            position = 0.0;
+        }
+    }
+    calls.report(state);
+}
+
+BENCHMARK(range_index_of)->Name("dimension.range.indexOf")->Apply(defaults)
+    ->ArgName("ticks")->Arg(1000)->Arg(100000);
+
+
+void dimension_lookup(benchmark::State &state) {
+    ScratchFile scratch("dimension-lookup");
+    nix::DataArray da = scratch.block.createDataArray("matrix", "nix.bench", nix::DataType::Double, {16, 16, 16});
+    da.appendSampledDimension(0.001);
+    da.appendRangeDimension({0.0, 1.0, 2.0, 4.0, 8.0, 16.0, 32.0, 64.0, 128.0, 256.0, 512.0, 1024.0, 2048.0,
+                             4096.0, 8192.0, 16384.0});
+    da.appendSetDimension();
+
+    CallCounter calls;
+    for (auto _ : state) {
+        for (nix::ndsize_t i = 1; i <= 3; i++) {
+            benchmark::DoNotOptimize(da.getDimension(i).dimensionType());
+        }
+    }
+    calls.report(state);
+    state.SetItemsProcessed(state.iterations() * 3);
+}
+
+BENCHMARK(dimension_lookup)->Name("dimension.get")->Apply(defaults);
+
+} // namespace
@@ -73,3 +73,126 @@ void TestAttributesFS::testReadField() {
     attrs.get(vector_field, vector_return);
     CPPUNIT_ASSERT(vector_values == vector_return);
 }
+
+void TestAttributesFS::testPackedFormat() {
+    boost::filesystem::path p = "attributes.bin";
+    file::AttributesFS attrs(this->location, FileMode::Overwrite, file::AttributeFormat::Packed);
+    CPPUNIT_ASSERT(attrs.format() == file::AttributeFormat::Packed);
+    CPPUNIT_ASSERT(boost::filesystem::exists(this->location / p));
+
+    vector<double> ticks{1.0, 2.5, 3.25, -4.0};
+    vector<int> extent{10, 20, 30};
+    vector<string> labels{"a", "", "ccc"};
+    attrs.set("format", "nix");
+    attrs.set("ticks", ticks);
+    attrs.set("extent", extent);
+    attrs.set("labels", labels);
+    attrs.set("index", 3);
+    attrs.set("offset", 0.5);
+    CPPUNIT_ASSERT(attrs.attributeCount() == 6);
+
+    // a fresh reader maps the file from disk
+    file::AttributesFS reader(this->location, FileMode::ReadOnly);
+    CPPUNIT_ASSERT(reader.format() == file::AttributeFormat::Packed);
+
+    string format;
+    vector<double> ticks_return;
+    vector<int> extent_return;
+    vector<string> labels_return;
+    size_t index;
+    double offset;
+    reader.get("format", format);
+    reader.get("ticks", ticks_return);
+    reader.get("extent", extent_return);
+    reader.get("labels", labels_return);
+    reader.get("index", index);
+    reader.get("offset", offset);
+    CPPUNIT_ASSERT(format == "nix");
+    CPPUNIT_ASSERT(ticks == ticks_return);
+    CPPUNIT_ASSERT(extent == extent_return);
+    CPPUNIT_ASSERT(labels == labels_return);
+    CPPUNIT_ASSERT(index == 3);
+    CPPUNIT_ASSERT(offset == 0.5);
+
+    attrs.remove("ticks");
+    CPPUNIT_ASSERT(!reader.has("ticks"));
+    CPPUNIT_ASSERT(reader.attributeCount() == 5);
+
+    // new directories below follow the format of their parent
+    boost::filesystem::path child = this->location / boost::filesystem::path("child");
+    boost::filesystem::create_directories(child);
+    file::AttributesFS child_attrs(child, FileMode::ReadWrite);
+    CPPUNIT_ASSERT(child_attrs.format() == file::AttributeFormat::Packed);
+}
+
+void TestAttributesFS::testPackedRewrite() {
+    boost::filesystem::path p = this->location / boost::filesystem::path("attributes.bin");
+    file::PackedAttributesFS writer(p);
+    writer.set("values", vector<double>(100000, 1.5));
+    writer.flush();
+
+    // a file that is mapped elsewhere is replaced, not truncated
+    file::PackedAttributesFS mapped(p);
+    mapped.load();
+    writer.set("values", vector<double>{2.0});
+    writer.flush();
+
+    vector<double> values;
+    mapped.get("values", values);
+    CPPUNIT_ASSERT(values.size() == 100000 && values.back() == 1.5);
+    mapped.load();
+    mapped.get("values", values);
+    CPPUNIT_ASSERT(values == vector<double>{2.0});
+
+    size_t files = 0;
+    for (boost::filesystem::directory_iterator it(this->location), end; it != end; ++it) {
+        files++;
+    }
+    CPPUNIT_ASSERT(files == 1);
+}
+
+void TestAttributesFS::testConvert() {
+    boost::filesystem::path child = this->location / boost::filesystem::path("child");
+    boost::filesystem::create_directories(child);
+
+    vector<double> ticks{0.1, 0.2, 1e-9};
+    vector<int> extent{1, 2};
+    vector<string> links{"a/b", "c/d"};
+    {
+        file::AttributesFS attrs(this->location, FileMode::Overwrite);
+        attrs.set("name", "42");
+        attrs.set("ticks", ticks);
+        attrs.set("extent", extent);
+        file::AttributesFS child_attrs(child, FileMode::Overwrite);
+        child_attrs.set("links", links);
+        child_attrs.set("label", "1.50");
+    }
+
+    file::AttributesFS::convert(this->location, file::AttributeFormat::Packed);
+    CPPUNIT_ASSERT(boost::filesystem::exists(this->location / boost::filesystem::path("attributes.bin")));
+    CPPUNIT_ASSERT(!boost::filesystem::exists(this->location / boost::filesystem::path("attributes")));
+    CPPUNIT_ASSERT(boost::filesystem::exists(child / boost::filesystem::path("attributes.bin")));
+
+    for (int i = 0; i < 2; i++) {
+        file::AttributesFS attrs(this->location, FileMode::ReadOnly);
+        file::AttributesFS child_attrs(child, FileMode::ReadOnly);
+        string name, label;
+        vector<double> ticks_return;
+        vector<int> extent_return;
+        vector<string> links_return;
+        attrs.get("name", name);
+        attrs.get("ticks", ticks_return);
+        attrs.get("extent", extent_return);
+        child_attrs.get("links", links_return);
+        child_attrs.get("label", label);
+        CPPUNIT_ASSERT(name == "42");
+        CPPUNIT_ASSERT(ticks == ticks_return);
+        CPPUNIT_ASSERT(extent == extent_return);
+        CPPUNIT_ASSERT(links == links_return);
+        CPPUNIT_ASSERT(label == "1.50");
+
+        file::AttributesFS::convert(this->location, file::AttributeFormat::Yaml);
+    }
+    CPPUNIT_ASSERT(boost::filesystem::exists(this->location / boost::filesystem::path("attributes")));
+    CPPUNIT_ASSERT(!boost::filesystem::exists(child / boost::filesystem::path("attributes.bin")));
+}
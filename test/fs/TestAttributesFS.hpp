@@ -34,6 +34,9 @@ private:
     CPPUNIT_TEST(testHasField);
     CPPUNIT_TEST(testWriteField);
     CPPUNIT_TEST(testReadField);
+    CPPUNIT_TEST(testPackedFormat);
+    CPPUNIT_TEST(testPackedRewrite);
+    CPPUNIT_TEST(testConvert);
     CPPUNIT_TEST_SUITE_END ();
 
     nix::File file;
@@ -55,4 +58,10 @@ public:
 
     void testReadField();
 
+    void testPackedFormat();
+
+    void testPackedRewrite();
+
+    void testConvert();
+
 };
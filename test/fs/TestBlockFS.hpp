@@ -26,6 +26,8 @@ class TestBlockFS : public BaseTestBlock {
     CPPUNIT_TEST(testTagAccess);
     CPPUNIT_TEST(testMultiTagAccess);
     CPPUNIT_TEST(testGroupAccess);
+    CPPUNIT_TEST(testDeleteEntities);
+    CPPUNIT_TEST(testCopy);
 
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testUpdatedAt);
@@ -52,6 +54,49 @@ public:
         file.close();
     }
 
+
+    // links are not tracked, only the entities are reported; their links dangle
+    void testDeleteEntities() {
+        nix::DataArray da_1 = block.createDataArray("array 1", "test", nix::DataType::Double, nix::NDSize({ 4 }));
+        nix::DataArray da_2 = block.createDataArray("array 2", "test", nix::DataType::Double, nix::NDSize({ 4 }));
+        nix::Source src = block.createSource("source", "test");
+        nix::Source child = src.createSource("child", "test");
+
+        nix::Tag tag = block.createTag("tag", "test", std::vector<double>{ 0.0 });
+        tag.references({da_1, da_2});
+        tag.addSource(child);
+        nix::Group g = block.createGroup("group", "test");
+        g.dataArrays({da_1});
+
+        std::vector<std::string> removed = block.deleteEntities({da_1, src, da_1});
+        CPPUNIT_ASSERT(removed == std::vector<std::string>({"data_arrays/array 1", "sources/source"}));
+
+        CPPUNIT_ASSERT(block.dataArrayCount() == 1);
+        CPPUNIT_ASSERT(block.hasDataArray(da_2));
+        CPPUNIT_ASSERT(block.sourceCount() == 0);
+        CPPUNIT_ASSERT(tag.referenceCount() == 1 && tag.hasReference(da_2));
+        CPPUNIT_ASSERT(tag.sourceCount() == 0);
+        CPPUNIT_ASSERT(g.dataArrayCount() == 0);
+
+        CPPUNIT_ASSERT(block.deleteEntities({}).empty());
+        CPPUNIT_ASSERT(block.deleteEntities({nix::Identity(da_2.name(), nix::ObjectType::Tag)}).empty());
+        CPPUNIT_ASSERT(block.deleteEntities({da_2, tag}).size() == 2);
+        CPPUNIT_ASSERT(block.dataArrayCount() == 0);
+        CPPUNIT_ASSERT(block.tagCount() == 0);
+    }
+
+
+    // entities can not be copied on the file system
+    void testCopy() {
+        nix::DataArray da = block.createDataArray("array", "test", nix::DataType::Double, nix::NDSize({ 4 }));
+        nix::Tag tag = block.createTag("tag", "test", std::vector<double>{ 0.0 });
+
+        CPPUNIT_ASSERT_THROW(block_other.copyDataArray(da), nix::UnsupportedOperation);
+        CPPUNIT_ASSERT_THROW(block_other.copyTag(tag, "copy"), nix::UnsupportedOperation);
+        CPPUNIT_ASSERT(block_other.dataArrayCount() == 0);
+        CPPUNIT_ASSERT(block_other.tagCount() == 0);
+    }
+
 };
 
 #endif //NIX_TESTBLOCKFS_HPP
@@ -0,0 +1,155 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "TestDirectoryFS.hpp"
+
+#include <fstream>
+
+using namespace std;
+using namespace nix;
+namespace bfs = boost::filesystem;
+
+
+void TestDirectoryFS::setUp() {
+    this->location = bfs::absolute("testFileSysDirectory");
+    bfs::remove_all(this->location);
+}
+
+
+void TestDirectoryFS::tearDown() {
+    bfs::remove_all(this->location);
+}
+
+
+vector<string> TestDirectoryFS::names(const file::Directory &dir) {
+    vector<string> names;
+    for (ndsize_t i = 0; i < dir.subdirCount(); i++) {
+        names.push_back(dir.sub_dir_by_index(i).filename().string());
+    }
+    return names;
+}
+
+
+void TestDirectoryFS::testIndexOrder() {
+    bfs::path p = this->location / "order";
+    file::Directory dir(p, FileMode::Overwrite);
+    for (const string &name : {"c", "a", "b"}) {
+        file::Directory(p / name, FileMode::Overwrite);
+    }
+
+    // creation order, not name order
+    CPPUNIT_ASSERT(names(dir) == vector<string>({"c", "a", "b"}));
+    CPPUNIT_ASSERT(dir.sub_dir_by_index(3).empty());
+    CPPUNIT_ASSERT(names(file::Directory(p)) == names(dir));
+
+    dir.renameSubdir("c", "d");
+    CPPUNIT_ASSERT(names(dir) == vector<string>({"a", "b", "d"}));
+
+    CPPUNIT_ASSERT(dir.removeObjectByNameOrAttribute("name", "a"));
+    CPPUNIT_ASSERT(names(dir) == vector<string>({"b", "d"}));
+
+    // created again, it counts as new
+    file::Directory(p / "a", FileMode::Overwrite);
+    CPPUNIT_ASSERT(names(dir) == vector<string>({"b", "d", "a"}));
+    CPPUNIT_ASSERT(names(file::Directory(p)) == names(dir));
+}
+
+
+void TestDirectoryFS::testExternalChanges() {
+    bfs::path p = this->location / "external";
+    file::Directory dir(p, FileMode::Overwrite);
+    file::Directory(p / "b", FileMode::Overwrite);
+    file::Directory(p / "a", FileMode::Overwrite);
+    CPPUNIT_ASSERT(names(dir) == vector<string>({"b", "a"}));
+
+    // not recorded in the order file, so it comes first
+    bfs::create_directory(p / "x");
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(3), dir.subdirCount());
+    CPPUNIT_ASSERT(names(dir) == vector<string>({"x", "b", "a"}));
+    CPPUNIT_ASSERT(dir.hasObject("x"));
+
+    bfs::remove_all(p / "b");
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(2), dir.subdirCount());
+    CPPUNIT_ASSERT(names(dir) == vector<string>({"x", "a"}));
+    CPPUNIT_ASSERT(!dir.hasObject("b"));
+
+    // files are not indexed
+    ofstream(bfs::path(p / "file").string()) << "nix";
+    CPPUNIT_ASSERT(names(dir) == vector<string>({"x", "a"}));
+}
+
+
+void TestDirectoryFS::testDanglingLinks() {
+    bfs::path targets = this->location / "targets";
+    bfs::path linked = this->location / "linked";
+    file::Directory target_dir(targets, FileMode::Overwrite);
+    file::Directory link_dir(linked, FileMode::Overwrite);
+    file::Directory(targets / "t1", FileMode::Overwrite);
+    file::Directory(targets / "t2", FileMode::Overwrite);
+
+    link_dir.createDirectoryLink((targets / "t2").string(), "l2");
+    link_dir.createDirectoryLink((targets / "t1").string(), "l1");
+    CPPUNIT_ASSERT(names(link_dir) == vector<string>({"l2", "l1"}));
+
+    // the directory of the links does not change, its index has to notice anyway
+    CPPUNIT_ASSERT(target_dir.removeObjectByNameOrAttribute("name", "t2"));
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(1), link_dir.subdirCount());
+    CPPUNIT_ASSERT(names(link_dir) == vector<string>({"l1"}));
+    CPPUNIT_ASSERT(!link_dir.hasObject("l2"));
+
+    target_dir.removeAll();
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(0), link_dir.subdirCount());
+    CPPUNIT_ASSERT(link_dir.sub_dir_by_index(0).empty());
+}
+
+
+void TestDirectoryFS::testOrderMissing() {
+    // as written by older versions, without an order file
+    bfs::path p = this->location / "unordered";
+    for (const string &name : {"c", "a", "b"}) {
+        bfs::create_directories(p / name);
+    }
+    file::Directory dir(p);
+    CPPUNIT_ASSERT(names(dir) == vector<string>({"a", "b", "c"}));
+
+    // children added later are ordered by name as well
+    file::Directory(p / "aa", FileMode::ReadWrite);
+    CPPUNIT_ASSERT(names(dir) == vector<string>({"a", "aa", "b", "c"}));
+
+    // an order file that got lost
+    bfs::path q = this->location / "lost";
+    file::Directory lost(q, FileMode::Overwrite);
+    for (const string &name : {"c", "a", "b"}) {
+        file::Directory(q / name, FileMode::Overwrite);
+    }
+    CPPUNIT_ASSERT(names(lost) == vector<string>({"c", "a", "b"}));
+    bfs::remove(q / ".order");
+    file::Directory(q / "d", FileMode::Overwrite);
+    CPPUNIT_ASSERT(names(lost) == vector<string>({"a", "b", "c", "d"}));
+    CPPUNIT_ASSERT(names(file::Directory(q)) == names(lost));
+}
+
+
+void TestDirectoryFS::testOrderStale() {
+    bfs::path p = this->location / "stale";
+    for (const string &name : {"a", "b", "c"}) {
+        bfs::create_directories(p / name);
+    }
+
+    // zz is gone, b was never recorded and c was created again after a
+    ofstream(bfs::path(p / ".order").string()) << "zz\nc\na\nc\n";
+    file::Directory dir(p, FileMode::ReadWrite);
+    CPPUNIT_ASSERT(names(dir) == vector<string>({"b", "a", "c"}));
+
+    file::Directory(p / "d", FileMode::ReadWrite);
+    CPPUNIT_ASSERT(names(dir) == vector<string>({"b", "a", "c", "d"}));
+
+    CPPUNIT_ASSERT(dir.removeObjectByNameOrAttribute("name", "a"));
+    CPPUNIT_ASSERT(names(dir) == vector<string>({"b", "c", "d"}));
+    CPPUNIT_ASSERT(names(file::Directory(p)) == names(dir));
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix.hpp>
+#include "fs/Directory.hpp"
+
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+#include <cppunit/BriefTestProgressListener.h>
+
+
+class TestDirectoryFS : public CPPUNIT_NS::TestFixture {
+private:
+    boost::filesystem::path location;
+
+    CPPUNIT_TEST_SUITE(TestDirectoryFS);
+    CPPUNIT_TEST(testIndexOrder);
+    CPPUNIT_TEST(testExternalChanges);
+    CPPUNIT_TEST(testDanglingLinks);
+    CPPUNIT_TEST(testOrderMissing);
+    CPPUNIT_TEST(testOrderStale);
+    CPPUNIT_TEST_SUITE_END ();
+
+    // the names of the sub-directories, by index
+    static std::vector<std::string> names(const nix::file::Directory &dir);
+
+public:
+
+    void setUp();
+
+    void tearDown();
+
+    void testIndexOrder();
+
+    void testExternalChanges();
+
+    void testDanglingLinks();
+
+    void testOrderMissing();
+
+    void testOrderStale();
+
+};
@@ -28,6 +28,7 @@ class TestFileFS: public BaseTestFile {
     CPPUNIT_TEST(testCheckHeader);
     CPPUNIT_TEST(testFlags);
     CPPUNIT_TEST(testNonNix);
+    CPPUNIT_TEST(testCopy);
 
     CPPUNIT_TEST_SUITE_END ();
 
@@ -84,6 +85,18 @@ public:
         bfs::remove_all(p);
         bfs::remove_all(pa);
     }
+
+
+    // blocks and sections can not be copied on the file system
+    void testCopy() {
+        nix::Block b = file_open.createBlock("block", "test");
+        nix::Section s = file_open.createSection("section", "test");
+
+        CPPUNIT_ASSERT_THROW(file_other.copyBlock(b), nix::UnsupportedOperation);
+        CPPUNIT_ASSERT_THROW(file_other.copySection(s, "copy"), nix::UnsupportedOperation);
+        CPPUNIT_ASSERT(file_other.blockCount() == 0);
+        CPPUNIT_ASSERT(file_other.sectionCount() == 0);
+    }
 };
 
 #endif //NIX_TESTFILEFS_HPP
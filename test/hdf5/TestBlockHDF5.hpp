@@ -28,6 +28,8 @@ class TestBlockHDF5 : public BaseTestBlock {
     CPPUNIT_TEST(testTagAccess);
     CPPUNIT_TEST(testMultiTagAccess);
     CPPUNIT_TEST(testGroupAccess);
+    CPPUNIT_TEST(testDeleteEntities);
+    CPPUNIT_TEST(testCopyEntities);
 
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testUpdatedAt);
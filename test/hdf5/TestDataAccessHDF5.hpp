@@ -30,6 +30,9 @@ class TestDataAccessHDF5 : public BaseTestDataAccess {
     CPPUNIT_TEST(testMultiTagFeatureData);
     CPPUNIT_TEST(testMultiTagUnitSupport);
     CPPUNIT_TEST(testDataView);
+    CPPUNIT_TEST(testDataViewReadAhead);
+    CPPUNIT_TEST(testStridedData);
+    CPPUNIT_TEST(testResolvedMultiTag);
     CPPUNIT_TEST(testDataSlice);
     CPPUNIT_TEST(testFlexibleTagging);
     CPPUNIT_TEST(testGetDimensionUnit);
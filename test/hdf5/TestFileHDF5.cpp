@@ -14,8 +14,20 @@
 #include "hdf5/h5x/H5Group.hpp"
 #include "hdf5/FileHDF5.hpp"
 
+#include <algorithm>
+#include <fstream>
+#include <numeric>
 #include <sstream>
+#include <chrono>
+#include <exception>
+#include <thread>
 #include <nix/util/util.hpp>
+#include <boost/filesystem.hpp>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 namespace h5x = nix::hdf5;
 
@@ -116,3 +128,365 @@ void TestFileHDF5::testVersion() {
         f.close();
     }
 }
+
+#ifndef _WIN32
+/*
+ * Follow the data appended by the writer of testSwmr until all of it has
+ * arrived and check it on the way; returns the exit code for the process.
+ */
+static int follow_swmr_file(const std::string &fn, nix::ndsize_t total) {
+    nix::File f = nix::File::open(fn, nix::FileMode::SwmrRead);
+    nix::DataArray da = f.getBlock("acquisition").getDataArray("signal");
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    nix::ndsize_t extent = 0, checked = 0;
+    std::vector<double> data;
+    while (checked < total) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return 3;
+        }
+
+        da.refresh();
+        const nix::ndsize_t now = da.dataExtent()[0];
+        if (now < extent) {
+            return 4;
+        }
+        extent = now;
+
+        if (extent > checked) {
+            // the new extent can be seen before the data, which then reads as 0
+            data.resize(extent - checked);
+            da.getData(nix::DataType::Double, data.data(), nix::NDSize(1, extent - checked), nix::NDSize(1, checked));
+            for (size_t i = 0; i < data.size() && data[i] != 0.0; i++, checked++) {
+                if (data[i] != static_cast<double>(checked + 1)) {
+                    return 5;
+                }
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    f.close();
+    return 0;
+}
+#endif
+
+void TestFileHDF5::testSwmr() {
+#ifndef _WIN32
+    const std::string fn = "test_file_swmr.h5";
+    const size_t nreaders = 3, batches = 40, batch = 25;
+    boost::filesystem::remove(fn);
+
+    // files not created in SwmrWrite mode cannot be written to with SWMR
+    nix::FormatVersion ver = HDF5_FF_VERSION;
+    std::string plain = make_file_with_version(ver.x(), ver.y(), ver.z());
+    CPPUNIT_ASSERT_THROW(nix::File::open(plain, nix::FileMode::SwmrWrite), h5x::H5Exception);
+
+    // the readers are forked before the writer opens the file and wait for
+    // it to start SWMR access
+    int ready[2];
+    CPPUNIT_ASSERT_EQUAL(0, pipe(ready));
+    std::vector<pid_t> readers;
+    for (size_t r = 0; r < nreaders; r++) {
+        pid_t pid = fork();
+        CPPUNIT_ASSERT(pid >= 0);
+        if (pid == 0) {
+            close(ready[1]);
+            char c;
+            int code = 2;
+            if (read(ready[0], &c, 1) == 1) {
+                try {
+                    code = follow_swmr_file(fn, batches * batch);
+                } catch (...) {
+                    code = 6;
+                }
+            }
+            _exit(code);
+        }
+        readers.push_back(pid);
+    }
+    close(ready[0]);
+
+    std::exception_ptr error;
+    try {
+        nix::File f = nix::File::open(fn, nix::FileMode::SwmrWrite);
+        nix::Block b = f.createBlock("acquisition", "test");
+        nix::DataArray da = b.createDataArray("signal", "test", nix::DataType::Double, nix::NDSize({0}));
+        da.appendSampledDimension(0.1);
+        std::vector<double> ramp(64);
+        std::iota(ramp.begin(), ramp.end(), 0.0);
+        nix::DataArray decimated = b.createDataArray("decimated", "test", ramp);
+        decimated.createStatistics();
+        nix::PyramidOptions opts;
+        opts.factors = {4, 16};
+        decimated.createPyramid(opts);
+        CPPUNIT_ASSERT_THROW(file_open.startSwmrWrite(), std::runtime_error);
+        f.startSwmrWrite();
+
+        // nothing can be removed from the file, the outdated pyramid is only marked stale
+        std::transform(ramp.begin(), ramp.end(), ramp.begin(), [](double v) { return v + 64; });
+        decimated.appendData(nix::DataType::Double, ramp.data(), nix::NDSize({64}), 0);
+        CPPUNIT_ASSERT(!decimated.hasPyramid());
+        CPPUNIT_ASSERT(decimated.pyramidFactors().empty());
+        CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(1), decimated.envelopeByIndex(64, 0, 128).factor);
+        CPPUNIT_ASSERT_EQUAL(127.0, decimated.statistics().max);
+        CPPUNIT_ASSERT_THROW(decimated.deletePyramid(), nix::UnsupportedOperation);
+        CPPUNIT_ASSERT_THROW(decimated.deleteStatistics(), nix::UnsupportedOperation);
+
+        for (size_t r = 0; r < nreaders; r++) {
+            CPPUNIT_ASSERT_EQUAL(ssize_t(1), write(ready[1], "x", 1));
+        }
+
+        std::vector<double> values(batch);
+        for (size_t k = 0; k < batches; k++) {
+            for (size_t i = 0; i < batch; i++) {
+                values[i] = static_cast<double>(k * batch + i + 1);
+            }
+            da.appendData(nix::DataType::Double, values.data(), nix::NDSize(1, batch), 0);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        f.close();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    close(ready[1]);
+
+    std::vector<int> status(nreaders, -1);
+    for (size_t r = 0; r < nreaders; r++) {
+        waitpid(readers[r], &status[r], 0);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    for (int st : status) {
+        CPPUNIT_ASSERT(WIFEXITED(st));
+        CPPUNIT_ASSERT_EQUAL(0, WEXITSTATUS(st));
+    }
+
+    // the file stays a regular NIX file
+    nix::File f = nix::File::open(fn, nix::FileMode::ReadOnly);
+    std::vector<double> data;
+    f.getBlock("acquisition").getDataArray("signal").getData(data);
+    CPPUNIT_ASSERT_EQUAL(batches * batch, data.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<double>(batches * batch), data.back());
+    f.close();
+
+    // the stale pyramid is removed like any other once SWMR is over
+    f = nix::File::open(fn, nix::FileMode::ReadWrite);
+    nix::DataArray decimated = f.getBlock("acquisition").getDataArray("decimated");
+    CPPUNIT_ASSERT(!decimated.hasPyramid());
+    CPPUNIT_ASSERT(decimated.deletePyramid());
+    CPPUNIT_ASSERT(!decimated.deletePyramid());
+    f.close();
+#endif
+}
+
+void TestFileHDF5::testInMemory() {
+    const std::string fn = "test_file_memory.h5";
+    boost::filesystem::remove(fn);
+    std::vector<int32_t> values(1000);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int32_t>(i);
+    }
+
+    // nothing ends up on disk
+    nix::File f = nix::File::open(fn, nix::FileMode::Overwrite, "hdf5",
+                                  nix::Compression::Auto, nix::OpenFlags::InMemory);
+    nix::Block b = f.createBlock("memory", "test");
+    nix::DataArray da = b.createDataArray("values", "test", nix::DataType::Int32, nix::NDSize({1000}),
+                                          nix::Compression::Auto, nix::DataStorage::Contiguous);
+    da.setData(nix::DataType::Int32, values.data(), nix::NDSize({1000}), nix::NDSize({0}));
+    CPPUNIT_ASSERT_THROW(da.mappedData(), std::runtime_error);
+
+    std::vector<char> image = f.toImage();
+    CPPUNIT_ASSERT(image.size() > 0);
+    f.close();
+    CPPUNIT_ASSERT(!boost::filesystem::exists(fn));
+
+    // the image is a regular NIX file
+    nix::File g = nix::File::fromImage(image.data(), image.size());
+    CPPUNIT_ASSERT(g.isOpen());
+    CPPUNIT_ASSERT_EQUAL(nix::FileMode::ReadOnly, g.fileMode());
+    std::vector<int32_t> data;
+    g.getBlock("memory").getDataArray("values").getData(data);
+    CPPUNIT_ASSERT(data == values);
+    g.close();
+
+    // changes go into a copy of the image
+    g = nix::File::fromImage(image.data(), image.size(), nix::FileMode::ReadWrite);
+    g.createBlock("more", "test");
+    std::vector<char> changed = g.toImage();
+    g.close();
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(2),
+                         nix::File::fromImage(changed.data(), changed.size()).blockCount());
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(1),
+                         nix::File::fromImage(image.data(), image.size()).blockCount());
+
+    std::vector<char> junk(4096, 'x');
+    CPPUNIT_ASSERT_THROW(nix::File::fromImage(junk.data(), junk.size()), h5x::H5Exception);
+    CPPUNIT_ASSERT_THROW(nix::File::fromImage(image.data(), image.size(), nix::FileMode::Overwrite),
+                         std::runtime_error);
+
+    // with a backing store the file is written to disk on close
+    f = nix::File::open(fn, nix::FileMode::Overwrite, "hdf5",
+                        nix::Compression::Auto, nix::OpenFlags::BackingStore);
+    f.createBlock("stored", "test");
+    f.close();
+    CPPUNIT_ASSERT(boost::filesystem::exists(fn));
+
+    f = nix::File::open(fn, nix::FileMode::ReadOnly);
+    CPPUNIT_ASSERT(f.hasBlock("stored"));
+    f.close();
+
+    // an existing file is loaded, but changes stay in memory
+    f = nix::File::open(fn, nix::FileMode::ReadWrite, "hdf5",
+                        nix::Compression::Auto, nix::OpenFlags::InMemory);
+    CPPUNIT_ASSERT(f.hasBlock("stored"));
+    f.createBlock("transient", "test");
+    f.close();
+
+    f = nix::File::open(fn, nix::FileMode::ReadOnly);
+    CPPUNIT_ASSERT(!f.hasBlock("transient"));
+    f.close();
+}
+
+void TestFileHDF5::testProbe() {
+    file_open.flush();
+    nix::FileHeader header = nix::File::probe("test_file.h5");
+    CPPUNIT_ASSERT(header.valid);
+    CPPUNIT_ASSERT(header.error.empty());
+    CPPUNIT_ASSERT_EQUAL(std::string("test_file.h5"), header.location);
+    CPPUNIT_ASSERT_EQUAL(file_open.format(), header.format);
+    CPPUNIT_ASSERT(header.version == file_open.version());
+    CPPUNIT_ASSERT_EQUAL(file_open.id(), header.id);
+    CPPUNIT_ASSERT_EQUAL(file_open.createdAt(), header.created_at);
+    CPPUNIT_ASSERT_EQUAL(file_open.updatedAt(), header.updated_at);
+
+    const std::string junk = "test_file_probe.txt";
+    std::ofstream(junk) << "not a NIX file";
+    h5x::H5Object h5 = H5Fcreate("test_file_probe.h5", H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    h5.close();
+
+    std::vector<std::string> names = {"test_file.h5", "test_file_missing.h5", junk,
+                                      "test_file_probe.h5", "test_file_other.h5"};
+    std::vector<nix::FileHeader> headers = nix::File::probe(names, 3);
+    CPPUNIT_ASSERT_EQUAL(names.size(), headers.size());
+    for (size_t i = 0; i < names.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(names[i], headers[i].location);
+        CPPUNIT_ASSERT_EQUAL(headers[i].valid, headers[i].error.empty());
+    }
+    CPPUNIT_ASSERT(headers[0].valid && headers[0].id == file_open.id());
+    CPPUNIT_ASSERT(!headers[1].valid);
+    CPPUNIT_ASSERT(!headers[2].valid);
+    CPPUNIT_ASSERT(!headers[3].valid && headers[3].format.empty());
+    CPPUNIT_ASSERT(headers[4].valid && headers[4].id == file_other.id());
+
+    CPPUNIT_ASSERT(nix::File::probe(std::vector<std::string>()).empty());
+    CPPUNIT_ASSERT_THROW(nix::File::probe("test_file.h5", "nope"), std::runtime_error);
+}
+
+
+void TestFileHDF5::testRepack() {
+    std::vector<double> values(100000);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<double>(i % 977);
+    }
+
+    nix::File f = nix::File::open("test_file_repack.h5", nix::FileMode::Overwrite);
+    nix::Section s = f.createSection("session", "test");
+    s.createProperty("subject", nix::Variant("mouse"));
+    nix::Block b = f.createBlock("block", "test");
+    b.createDataArray("deleted", "test", values);
+    nix::DataArray da = b.createDataArray("signal", "test", values, nix::DataType::Double,
+                                          nix::Compression::DeflateNormal);
+    da.appendSampledDimension(0.1);
+    da.metadata(s);
+    nix::DataArray time = b.createDataArray("time", "test", std::vector<double>{ 0.0, 1.0, 2.0 });
+    time.appendAliasRangeDimension();
+    nix::DataArray labels = b.createDataArray("labels", "test", nix::DataType::String, nix::NDSize({ 2 }));
+    labels.setData(std::vector<std::string>{ "a", "b" });
+    nix::Tag tag = b.createTag("tag", "test", std::vector<double>{ 1.0 });
+    tag.addReference(da);
+    tag.addReference(time);
+    b.createGroup("group", "test").addDataArray(time);
+    f.createBlock("other", "test");
+    b.deleteDataArray("deleted");
+    const std::string file_id = f.id();
+    const time_t created = f.createdAt();
+    const std::string da_id = da.id();
+    const std::string time_id = time.id();
+    const std::string section_id = s.id();
+    const nix::NDSize chunks = da.dataChunks();
+    f.close();
+
+    CPPUNIT_ASSERT_THROW(nix::File::repack("test_file_repack.h5", "test_file_repack.h5"), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(nix::File::repack("test_file_missing.h5", "test_file_packed.h5"), std::runtime_error);
+
+    nix::RepackReport report = nix::File::repack("test_file_repack.h5", "test_file_packed.h5");
+    CPPUNIT_ASSERT_EQUAL(size_t(3), report.arrays);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), report.rewritten);
+    CPPUNIT_ASSERT(report.size_after + values.size() * sizeof(double) / 2 < report.size_before);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(boost::filesystem::file_size("test_file_packed.h5")),
+                         report.size_after);
+
+    nix::File p = nix::File::open("test_file_packed.h5", nix::FileMode::ReadOnly);
+    CPPUNIT_ASSERT_EQUAL(file_id, p.id());
+    CPPUNIT_ASSERT_EQUAL(created, p.createdAt());
+    CPPUNIT_ASSERT(p.blockCount() == 2);
+    CPPUNIT_ASSERT_EQUAL(std::string("block"), p.getBlock(0).name());
+    CPPUNIT_ASSERT_EQUAL(std::string("other"), p.getBlock(1).name());
+    nix::Block pb = p.getBlock("block");
+    CPPUNIT_ASSERT(pb.dataArrayCount() == 3);
+    CPPUNIT_ASSERT_EQUAL(std::string("signal"), pb.getDataArray(0).name());
+    CPPUNIT_ASSERT_EQUAL(std::string("labels"), pb.getDataArray(2).name());
+    nix::DataArray pda = pb.getDataArray(da_id);
+    CPPUNIT_ASSERT_EQUAL(chunks, pda.dataChunks());
+    std::vector<double> data;
+    pda.getData(data);
+    CPPUNIT_ASSERT(data == values);
+    CPPUNIT_ASSERT_EQUAL(section_id, pda.metadata().id());
+    CPPUNIT_ASSERT(pda.metadata().getProperty("subject").values()[0] == nix::Variant("mouse"));
+    nix::Tag ptag = pb.getTag("tag");
+    CPPUNIT_ASSERT(ptag.referenceCount() == 2 && ptag.hasReference(da_id) && ptag.hasReference(time_id));
+    CPPUNIT_ASSERT(pb.getGroup("group").hasDataArray(time_id));
+    CPPUNIT_ASSERT(pb.getDataArray("time").getDimension(1).asRangeDimension().alias());
+    std::vector<std::string> strings;
+    pb.getDataArray("labels").getData(strings);
+    CPPUNIT_ASSERT(strings == (std::vector<std::string>{ "a", "b" }));
+    p.close();
+
+    nix::RepackOptions opts;
+    opts.threads = 3;
+    opts.layout = nix::DataLayout(nix::NDSize{}, nix::Compression::DeflateNormal);
+    opts.arrays[da_id] = nix::DataLayout({ 1000 }, nix::Compression::Auto);
+    opts.arrays[time_id] = nix::DataLayout(nix::DataStorage::Contiguous);
+    report = nix::File::repack("test_file_repack.h5", "test_file_packed.h5", opts);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), report.rewritten);
+
+    p = nix::File::open("test_file_packed.h5", nix::FileMode::ReadOnly);
+    pb = p.getBlock("block");
+    pda = pb.getDataArray(da_id);
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({ 1000 }), pda.dataChunks());
+    pda.getData(data);
+    CPPUNIT_ASSERT(data == values);
+    std::vector<double> window(250);
+    pda.getData(window, { 250 }, { 99750 });
+    CPPUNIT_ASSERT(std::equal(window.begin(), window.end(), values.begin() + 99750));
+    nix::DataArray ptime = pb.getDataArray("time");
+    CPPUNIT_ASSERT(ptime.dataChunks().size() == 0);
+    ptime.getData(data);
+    CPPUNIT_ASSERT(data == (std::vector<double>{ 0.0, 1.0, 2.0 }));
+    CPPUNIT_ASSERT_EQUAL(time_id, ptime.id());
+    p.close();
+
+    opts.arrays[da_id] = nix::DataLayout({ 10, 10 }, nix::Compression::Auto);
+    CPPUNIT_ASSERT_THROW(nix::File::repack("test_file_repack.h5", "test_file_packed.h5", opts),
+                         std::invalid_argument);
+    CPPUNIT_ASSERT(!boost::filesystem::exists("test_file_packed.h5"));
+
+    // contiguous data can not be compressed
+    opts.arrays[da_id] = nix::DataLayout(nix::NDSize{}, nix::Compression::DeflateNormal, nix::DataStorage::Contiguous);
+    CPPUNIT_ASSERT_THROW(nix::File::repack("test_file_repack.h5", "test_file_packed.h5", opts),
+                         std::invalid_argument);
+    CPPUNIT_ASSERT(!boost::filesystem::exists("test_file_packed.h5"));
+}
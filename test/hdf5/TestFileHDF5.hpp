@@ -24,6 +24,12 @@ class TestFileHDF5: public BaseTestFile {
     CPPUNIT_TEST(testReopen);
     CPPUNIT_TEST(testFlags);
     CPPUNIT_TEST(testId);
+    CPPUNIT_TEST(testConcurrentRead);
+    CPPUNIT_TEST(testSwmr);
+    CPPUNIT_TEST(testInMemory);
+    CPPUNIT_TEST(testProbe);
+    CPPUNIT_TEST(testCopyBlock);
+    CPPUNIT_TEST(testRepack);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -32,6 +38,14 @@ public:
 
     void testVersion() override;
 
+    void testSwmr();
+
+    void testInMemory();
+
+    void testProbe();
+
+    void testRepack();
+
     void setUp() override {
         startup_time = time(NULL);
         file_open = nix::File::open("test_file.h5", nix::FileMode::Overwrite);
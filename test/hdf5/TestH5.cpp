@@ -380,3 +380,43 @@ void TestH5::testUTF8() {
     h5group.linkInfo("zelda", li);
     CPPUNIT_ASSERT_EQUAL(H5T_CSET_UTF8, li.cset);
 }
+
+void TestH5::testStats() {
+    nix::hdf5::H5Group g = h5group.openGroup("stats");
+    std::vector<int16_t> values(1000, 7);
+    g.setData("values", values);
+
+    nix::resetStats();
+    nix::hdf5::DataSet ds = g.openData("values");
+    std::vector<double> data;
+    ds.read(data, true);
+    CPPUNIT_ASSERT(!ds.hasAttr("nothing"));
+
+    const nix::Stats stats = nix::stats();
+    std::stringstream dump;
+    dump << stats;
+
+    if (!stats.enabled) {
+        for (const nix::OpStats &op : stats.ops) {
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(0), op.calls);
+        }
+        return;
+    }
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(1), stats[nix::StatOp::DataSetOpen].calls);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(1), stats[nix::StatOp::DataSetRead].calls);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(1), stats[nix::StatOp::AttrExists].calls);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(0), stats[nix::StatOp::DataSetWrite].calls);
+    CPPUNIT_ASSERT(stats[nix::StatOp::DataSetRead].nanos > 0);
+
+    // doubles requested, int16 in the file
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(1000 * sizeof(double)), stats[nix::StatOp::DataSetRead].bytes);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(1000 * sizeof(int16_t)), stats[nix::StatOp::DataSetRead].file_bytes);
+
+    CPPUNIT_ASSERT_EQUAL(std::string("dataset.read"), std::string(nix::Stats::name(nix::StatOp::DataSetRead)));
+    CPPUNIT_ASSERT(dump.str().find("dataset.read") != std::string::npos);
+    CPPUNIT_ASSERT(dump.str().find("dataset.write") == std::string::npos);
+
+    nix::resetStats();
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(0), nix::stats()[nix::StatOp::DataSetRead].calls);
+}
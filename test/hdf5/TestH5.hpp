@@ -37,6 +37,7 @@ public:
     void testDataSpace();
     void testPropertyList();
     void testUTF8();
+    void testStats();
 
 private:
     hid_t h5file;
@@ -48,6 +49,7 @@ private:
     CPPUNIT_TEST(testDataSpace);
     CPPUNIT_TEST(testPropertyList);
     CPPUNIT_TEST(testUTF8);
+    CPPUNIT_TEST(testStats);
     CPPUNIT_TEST_SUITE_END ();
 
 };
@@ -21,6 +21,7 @@ class TestPropertyHDF5 : public BaseTestProperty {
     CPPUNIT_TEST(testDefinition);
 
     CPPUNIT_TEST(testValues);
+    CPPUNIT_TEST(testTypedValues);
     CPPUNIT_TEST(testDataType);
     CPPUNIT_TEST(testUnit);
 
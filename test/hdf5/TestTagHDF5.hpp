@@ -27,6 +27,7 @@ class TestTagHDF5 : public BaseTestTag {
     CPPUNIT_TEST(testSourceAccess);
     CPPUNIT_TEST(testUnits);
     CPPUNIT_TEST(testReferences);
+    CPPUNIT_TEST(testSetReferences);
     CPPUNIT_TEST(testFeatures);
     CPPUNIT_TEST(testCreatedAt);
     CPPUNIT_TEST(testUpdatedAt);
@@ -0,0 +1,82 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+// nix-fs-attributes: rewrite the attributes of a file of the file system
+// back-end as YAML (attributes) or in the packed binary format
+// (attributes.bin).
+
+#include "fs/AttributesFS.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <iostream>
+#include <string>
+
+namespace po = boost::program_options;
+
+
+static nix::file::AttributeFormat parse_format(const std::string &text) {
+    if (text == "yaml") {
+        return nix::file::AttributeFormat::Yaml;
+    } else if (text == "packed") {
+        return nix::file::AttributeFormat::Packed;
+    }
+    throw std::invalid_argument("unknown format: " + text);
+}
+
+
+int main(int argc, char **argv) {
+    std::string location, format;
+
+    po::options_description opts("Options");
+    opts.add_options()
+        ("help,h", "show this help")
+        ("to,t", po::value<std::string>(&format)->required(), "the new format: yaml or packed")
+        ("no-recursive", "only convert the given directory, not the ones below it");
+
+    po::options_description files;
+    files.add_options()
+        ("location", po::value<std::string>(&location)->required(), "the directory of the file, or of an entity");
+
+    po::options_description all;
+    all.add(opts).add(files);
+    po::positional_options_description pos;
+    pos.add("location", 1);
+
+    nix::file::AttributeFormat target;
+    bool recursive = true;
+    try {
+        po::variables_map vm;
+        po::store(po::command_line_parser(argc, argv).options(all).positional(pos).run(), vm);
+        if (vm.count("help")) {
+            std::cout << "Usage: nix-fs-attributes --to FORMAT [options] LOCATION" << std::endl << opts;
+            return 0;
+        }
+        po::notify(vm);
+
+        target = parse_format(format);
+        recursive = vm.count("no-recursive") == 0;
+        if (!boost::filesystem::is_directory(location)) {
+            throw std::invalid_argument("not a directory: " + location);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "nix-fs-attributes: " << e.what() << std::endl
+                  << "Usage: nix-fs-attributes --to FORMAT [options] LOCATION" << std::endl << opts;
+        return 2;
+    }
+
+    try {
+        nix::file::AttributesFS::convert(location, target, recursive);
+    } catch (const std::exception &e) {
+        std::cerr << "nix-fs-attributes: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
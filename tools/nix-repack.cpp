@@ -0,0 +1,153 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+// nix-repack: rewrite a NIX file into a new one without the space of
+// deleted entities, optionally with new chunks and compression.
+
+#include <nix.hpp>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/program_options.hpp>
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace po = boost::program_options;
+
+
+static nix::NDSize parse_chunks(const std::string &text) {
+    std::vector<std::string> parts;
+    boost::split(parts, text, boost::is_any_of(",x"));
+    nix::NDSize chunks(parts.size(), 0);
+    for (size_t i = 0; i < parts.size(); i++) {
+        chunks[i] = std::stoull(parts[i]);
+    }
+    return chunks;
+}
+
+
+static nix::Compression parse_compression(const std::string &text) {
+    if (text == "keep") {
+        return nix::Compression::Auto;
+    } else if (text == "none") {
+        return nix::Compression::None;
+    } else if (text == "deflate") {
+        return nix::Compression::DeflateNormal;
+    }
+    throw std::invalid_argument("unknown compression: " + text);
+}
+
+
+static nix::DataStorage parse_storage(const std::string &text) {
+    if (text == "keep") {
+        return nix::DataStorage::Auto;
+    } else if (text == "chunked") {
+        return nix::DataStorage::Chunked;
+    } else if (text == "contiguous") {
+        return nix::DataStorage::Contiguous;
+    }
+    throw std::invalid_argument("unknown storage: " + text);
+}
+
+
+// ID=CHUNKS[:COMPRESSION] or ID=contiguous, e.g. 4f0c...=4096,2:deflate
+static std::pair<std::string, nix::DataLayout> parse_array(const std::string &text) {
+    const size_t eq = text.find('=');
+    if (eq == std::string::npos) {
+        throw std::invalid_argument("expected ID=CHUNKS[:COMPRESSION] or ID=contiguous: " + text);
+    }
+
+    nix::DataLayout layout;
+    std::string spec = text.substr(eq + 1);
+    if (spec == "contiguous") {
+        layout.storage = nix::DataStorage::Contiguous;
+        return std::make_pair(text.substr(0, eq), layout);
+    }
+    const size_t colon = spec.find(':');
+    if (colon != std::string::npos) {
+        layout.compression = parse_compression(spec.substr(colon + 1));
+        spec = spec.substr(0, colon);
+    }
+    if (!spec.empty()) {
+        layout.chunks = parse_chunks(spec);
+    }
+    return std::make_pair(text.substr(0, eq), layout);
+}
+
+
+int main(int argc, char **argv) {
+    std::string source, destination, chunks, compression, storage;
+    std::vector<std::string> arrays;
+    size_t threads = 0;
+
+    po::options_description opts("Options");
+    opts.add_options()
+        ("help,h", "show this help")
+        ("chunks,c", po::value<std::string>(&chunks), "chunk size of all data arrays, e.g. 4096,2")
+        ("compression,z", po::value<std::string>(&compression)->default_value("keep"),
+         "compression of all data arrays: keep, none or deflate")
+        ("storage,s", po::value<std::string>(&storage)->default_value("keep"),
+         "storage of all data arrays: keep, chunked or contiguous")
+        ("array,a", po::value<std::vector<std::string>>(&arrays),
+         "layout of one data array as ID=CHUNKS[:COMPRESSION] or ID=contiguous, may be repeated")
+        ("threads,j", po::value<size_t>(&threads)->default_value(0), "compression threads, 0 for one per core");
+
+    po::options_description files;
+    files.add_options()
+        ("source", po::value<std::string>(&source)->required(), "the file to repack")
+        ("destination", po::value<std::string>(&destination)->required(), "the repacked file");
+
+    po::options_description all;
+    all.add(opts).add(files);
+    po::positional_options_description pos;
+    pos.add("source", 1).add("destination", 1);
+
+    nix::RepackOptions options;
+    try {
+        po::variables_map vm;
+        po::store(po::command_line_parser(argc, argv).options(all).positional(pos).run(), vm);
+        if (vm.count("help")) {
+            std::cout << "Usage: nix-repack [options] SOURCE DESTINATION" << std::endl << opts;
+            return 0;
+        }
+        po::notify(vm);
+
+        options.threads = threads;
+        options.layout.compression = parse_compression(compression);
+        options.layout.storage = parse_storage(storage);
+        if (!chunks.empty()) {
+            options.layout.chunks = parse_chunks(chunks);
+        }
+        for (const std::string &a : arrays) {
+            options.arrays.insert(parse_array(a));
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "nix-repack: " << e.what() << std::endl
+                  << "Usage: nix-repack [options] SOURCE DESTINATION" << std::endl << opts;
+        return 2;
+    }
+
+    try {
+        nix::RepackReport report = nix::File::repack(source, destination, options);
+        const int64_t saved = static_cast<int64_t>(report.size_before) - static_cast<int64_t>(report.size_after);
+        const double percent = report.size_before ? 100.0 * saved / report.size_before : 0.0;
+
+        std::cout << source << ": " << report.size_before << " -> " << report.size_after << " bytes, "
+                  << saved << " bytes saved (" << std::fixed << std::setprecision(1) << percent << "%)" << std::endl
+                  << report.arrays << " data arrays, " << report.rewritten << " rewritten, "
+                  << std::setprecision(3) << report.seconds << " s" << std::endl;
+    } catch (const std::exception &e) {
+        std::cerr << "nix-repack: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}